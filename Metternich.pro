@@ -12,6 +12,9 @@ DEFINES += QT_DEPRECATED_WARNINGS
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# Uncomment the following line to compile in the profiling instrumentation (scoped timers and counters, see util/trace.h).
+#DEFINES += METTERNICH_TRACING
+
 SOURCES += \
         character/character.cpp \
         character/dynasty.cpp \
@@ -38,9 +41,13 @@ SOURCES += \
         economy/trade_route.cpp \
         game/engine_interface.cpp \
         game/game.cpp \
+        game/game_snapshot.cpp \
+        game/state_hash_log.cpp \
+        game/tick_pacer.cpp \
         history/history.cpp \
         holding/building.cpp \
         holding/building_slot.cpp \
+        holding/construction_scheduler.cpp \
         holding/holding.cpp \
         holding/holding_slot.cpp \
         holding/holding_type.cpp \
@@ -49,6 +56,7 @@ SOURCES += \
         map/map.cpp \
         map/pathfinder.cpp \
         map/province.cpp \
+        map/province_adjacency.cpp \
         map/province_profile.cpp \
         map/region.cpp \
         map/star_system.cpp \
@@ -57,9 +65,11 @@ SOURCES += \
         map/world.cpp \
         map/world_type.cpp \
         politics/government_type.cpp \
+        population/population_generator.cpp \
         population/population_type.cpp \
         population/population_unit.cpp \
         population/population_unit_base.cpp \
+        population/population_unit_view.cpp \
         religion/religion.cpp \
         religion/religion_group.cpp \
         script/chance_factor.cpp \
@@ -79,20 +89,26 @@ SOURCES += \
         script/modifier.cpp \
         script/modifier_effect/modifier_effect.cpp \
         species/species.cpp \
+        species/wildlife_generator.cpp \
         species/wildlife_unit.cpp \
         technology/technology.cpp \
         technology/technology_area.cpp \
         technology/technology_area_compare.cpp \
         technology/technology_compare.cpp \
+        technology/technology_diffusion.cpp \
         technology/technology_slot.cpp \
         third_party/maskedmousearea/maskedmousearea.cpp \
         util/geocoordinate_util.cpp \
         util/image_util.cpp \
+        util/mapped_raster.cpp \
+        util/memory_usage.cpp \
         util/number_util.cpp \
         util/point_container.cpp \
         util/point_util.cpp \
         util/polygon_util.cpp \
         util/random.cpp \
+        util/string_interner.cpp \
+        util/trace.cpp \
         util/translator.cpp \
         warfare/troop_type.cpp \
         warfare/troop_type_map.cpp
@@ -150,24 +166,30 @@ HEADERS += \
     economy/trade_route.h \
     game/engine_interface.h \
     game/game.h \
+    game/game_snapshot.h \
     game/game_speed.h \
+    game/state_hash_log.h \
+    game/tick_pacer.h \
     game/tick_period.h \
     history/calendar.h \
     history/history.h \
     history/timeline.h \
     holding/building.h \
     holding/building_slot.h \
+    holding/construction_scheduler.h \
     holding/holding.h \
     holding/holding_slot.h \
     holding/holding_slot_type.h \
     holding/holding_type.h \
     landed_title/landed_title.h \
     landed_title/landed_title_tier.h \
+    landed_title/realm_statistics.h \
     map/map.h \
     map/map_edge.h \
     map/map_mode.h \
     map/pathfinder.h \
     map/province.h \
+    map/province_adjacency.h \
     map/province_profile.h \
     map/region.h \
     map/star_system.h \
@@ -180,9 +202,12 @@ HEADERS += \
     politics/government_type_group.h \
     politics/law.h \
     politics/law_group.h \
+    population/population_generation_index.h \
+    population/population_generator.h \
     population/population_type.h \
     population/population_unit.h \
     population/population_unit_base.h \
+    population/population_unit_view.h \
     religion/religion.h \
     religion/religion_group.h \
     script/chance_factor.h \
@@ -212,6 +237,7 @@ HEADERS += \
     script/condition/not_condition.h \
     script/condition/or_condition.h \
     script/condition/prowess_condition.h \
+    script/condition/realm_size_condition.h \
     script/condition/region_condition.h \
     script/condition/scope_condition.h \
     script/condition/terrain_condition.h \
@@ -263,34 +289,53 @@ HEADERS += \
     script/scope_util.h \
     species/phenotype.h \
     species/species.h \
+    species/wildlife_generator.h \
     species/wildlife_unit.h \
     technology/technology.h \
     technology/technology_area.h \
     technology/technology_area_compare.h \
+    technology/technology_bitset.h \
     technology/technology_category.h \
     technology/technology_compare.h \
+    technology/technology_diffusion.h \
     technology/technology_map.h \
     technology/technology_set.h \
     technology/technology_slot.h \
     third_party/maskedmousearea/maskedmousearea.h \
+    util/binary_stream.h \
+    util/cached_translation.h \
     util/container_util.h \
+    util/duration_histogram.h \
     util/empty_image_provider.h \
     util/exception_util.h \
     util/filesystem_util.h \
+    util/flat_string_map.h \
+    util/geocoordinate_index.h \
     util/geocoordinate_util.h \
     util/image_util.h \
+    util/indexed_raster.h \
     util/map_util.h \
+    util/mapped_raster.h \
+    util/memory_usage.h \
+    util/mpsc_queue.h \
     util/number_util.h \
+    util/object_pool.h \
+    util/parallel_util.h \
     util/parse_util.h \
+    util/plurality_map.h \
     util/point_container.h \
     util/point_util.h \
     util/polygon_util.h \
+    util/proxy_pool.h \
     util/qunique_ptr.h \
     util/random.h \
     util/rect_util.h \
     util/set_util.h \
     util/singleton.h \
+    util/small_function.h \
+    util/string_interner.h \
     util/string_util.h \
+    util/trace.h \
     util/translator.h \
     util/type_traits.h \
     util/vector_random_util.h \
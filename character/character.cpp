@@ -23,8 +23,10 @@
 #include "script/event/event_trigger.h"
 #include "script/modifier.h"
 #include "util/container_util.h"
+#include "util/memory_usage.h"
 #include "util/random.h"
 #include "util/string_util.h"
+#include "util/trace.h"
 #include "util/vector_util.h"
 #include "util/vector_random_util.h"
 
@@ -75,7 +77,8 @@ character *character::generate(metternich::culture *culture, metternich::religio
 
 	//generate the character's birth date to be between 60 and 20 years before the current date
 	const QDateTime &current_date = game::get()->get_current_date();
-	character->birth_date = current_date.addDays(random::generate_in_range(-60 * 365, -20 * 365));
+	random_generator generator = random::get_generator(random_stream::character, "birth_date", character->get_index(), game::get()->get_total_ticks());
+	character->birth_date = current_date.addDays(generator.generate_in_range(-60 * 365, -20 * 365));
 	if (!history::get()->is_loading()) { //if history is loading then this entry's history will already be initialized later on anyway
 		character->initialize_history(); //generates a name and sets the phenotype if none was given
 	}
@@ -90,6 +93,16 @@ character::character(const std::string &identifier) : data_entry(identifier)
 	connect(this, &character::primary_title_changed, this, &character::titled_name_changed);
 	connect(this, &character::government_type_changed, this, &character::titled_name_changed);
 
+	//the names of landed titles depend on the culture, religion and dynasty of their holder
+	const auto emit_landed_title_name_changed = [this]() {
+		for (landed_title *landed_title : this->get_landed_titles()) {
+			emit landed_title->name_changed();
+		}
+	};
+	connect(this, &character::culture_changed, this, emit_landed_title_name_changed, Qt::ConnectionType::DirectConnection);
+	connect(this, &character::religion_changed, this, emit_landed_title_name_changed, Qt::ConnectionType::DirectConnection);
+	connect(this, &character::dynasty_changed, this, emit_landed_title_name_changed, Qt::ConnectionType::DirectConnection);
+
 	character::living_characters.push_back(this);
 }
 
@@ -118,6 +131,7 @@ character::~character()
 
 	if (this->get_liege() != nullptr) {
 		vector::remove(this->get_liege()->vassals, this);
+		this->get_liege()->change_de_facto_statistics(-this->get_de_facto_statistics());
 	}
 
 	for (character *vassal : this->vassals) {
@@ -190,8 +204,29 @@ void character::initialize_history()
 	data_entry_base::initialize_history();
 }
 
+void character::add_owned_memory_usage(memory_usage &usage, memory_report &report) const
+{
+	data_entry::add_owned_memory_usage(usage, report);
+
+	usage.add_string(this->name);
+	usage.add_vector(this->landed_titles);
+	usage.add_vector(this->holdings);
+	usage.add_vector(this->children);
+	usage.add_vector(this->vassals);
+	usage.add_vector(this->traits);
+	usage.add_vector(this->items);
+	usage.add_tree(this->stored_commodities);
+	usage.add_tree(this->flags);
+
+	if (this->government_condition_check != nullptr) {
+		usage.add_instance<condition_check<character>>();
+	}
+}
+
 void character::do_month()
 {
+	TRACE_SCOPE("character::do_month");
+
 	//do character events
 	character_event_trigger::monthly_pulse->do_events(this);
 
@@ -421,6 +456,7 @@ void character::set_liege(character *liege)
 
 	if (this->get_liege() != nullptr) {
 		vector::remove(this->get_liege()->vassals, this);
+		this->get_liege()->change_de_facto_statistics(-this->get_de_facto_statistics());
 
 		if (!this->is_landed()) {
 			disconnect(this->get_liege(), &character::capital_province_changed, this, &character::capital_province_changed);
@@ -432,6 +468,7 @@ void character::set_liege(character *liege)
 
 	if (liege != nullptr) {
 		liege->vassals.push_back(this);
+		liege->change_de_facto_statistics(this->get_de_facto_statistics());
 
 		if (!this->is_landed()) {
 			connect(liege, &character::capital_province_changed, this, &character::capital_province_changed);
@@ -446,6 +483,48 @@ void character::set_liege(character *liege)
 	}
 }
 
+/**
+**	@brief	Change the statistics of the character's realm, propagating the change to the realms of its lieges
+**
+**	@param	change	The statistics change
+*/
+void character::change_de_facto_statistics(const realm_statistics &change)
+{
+	for (character *character = this; character != nullptr; character = character->get_liege()) {
+		character->de_facto_statistics += change;
+		emit character->de_facto_statistics_changed();
+	}
+}
+
+/**
+**	@brief	Recalculate the statistics of the character's realm from scratch, including those of its vassals
+**
+**	@return	The statistics
+*/
+const realm_statistics &character::calculate_de_facto_statistics()
+{
+	realm_statistics statistics;
+	statistics.wealth = this->get_wealth();
+
+	for (const holding *holding : this->holdings) {
+		statistics += holding->get_realm_statistics();
+	}
+
+	for (const landed_title *landed_title : this->get_landed_titles()) {
+		if (landed_title->get_territory() != nullptr) {
+			statistics.province_count++;
+		}
+	}
+
+	for (character *vassal : this->vassals) {
+		statistics += vassal->calculate_de_facto_statistics();
+	}
+
+	this->de_facto_statistics = statistics;
+	emit de_facto_statistics_changed();
+	return this->de_facto_statistics;
+}
+
 province *character::get_capital_province() const
 {
 	if (this->get_primary_title() != nullptr) {
@@ -519,7 +598,8 @@ void character::generate_personality_trait()
 		throw std::runtime_error("Could not generate personality trait for character \"" + this->get_identifier() + "\".");
 	}
 
-	trait *chosen_trait = vector::get_random(potential_traits);
+	random_generator generator = random::get_generator(random_stream::character, "personality_trait", this->get_index(), game::get()->get_total_ticks());
+	trait *chosen_trait = vector::get_random(potential_traits, generator);
 	this->add_trait(chosen_trait);
 }
 
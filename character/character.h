@@ -2,6 +2,7 @@
 
 #include "database/data_entry.h"
 #include "database/data_type.h"
+#include "landed_title/realm_statistics.h"
 
 #include <QDateTime>
 #include <QVariant>
@@ -55,6 +56,8 @@ class character final : public data_entry, public data_type<character>
 	Q_PROPERTY(int prowess READ get_prowess NOTIFY prowess_changed)
 	Q_PROPERTY(int wealth READ get_wealth WRITE set_wealth NOTIFY wealth_changed)
 
+	friend class game_snapshot;
+
 public:
 	static constexpr const char *class_identifier = "character";
 	static constexpr const char *database_folder = "characters";
@@ -87,6 +90,7 @@ public:
 
 	virtual void process_gsml_dated_property(const gsml_property &property, const QDateTime &date) override;
 	virtual void initialize_history() override;
+	virtual void add_owned_memory_usage(memory_usage &usage, memory_report &report) const override;
 
 	virtual void check_history() const override
 	{
@@ -264,6 +268,19 @@ public:
 
 	void set_liege(character *liege);
 
+	const realm_statistics &get_de_facto_statistics() const
+	{
+		return this->de_facto_statistics;
+	}
+
+	Q_INVOKABLE QVariantMap get_de_facto_statistics_qvariant_map() const
+	{
+		return this->get_de_facto_statistics().to_qvariant_map();
+	}
+
+	void change_de_facto_statistics(const realm_statistics &change);
+	const realm_statistics &calculate_de_facto_statistics();
+
 	character *get_top_liege() const
 	{
 		if (this->get_liege() != nullptr) {
@@ -371,8 +388,13 @@ public:
 			return;
 		}
 
+		realm_statistics statistics_change;
+		statistics_change.wealth = wealth - this->wealth;
+
 		this->wealth = wealth;
 		emit wealth_changed();
+
+		this->change_de_facto_statistics(statistics_change);
 	}
 
 	void change_wealth(const int change)
@@ -473,6 +495,7 @@ signals:
 	void capital_province_changed();
 	void location_changed();
 	void ai_changed();
+	void de_facto_statistics_changed(); //emitted whenever any part of the realm changes, so it is meant for condition checks rather than for the interface
 
 private:
 	std::string name;
@@ -493,6 +516,7 @@ private:
 	QDateTime death_date;
 	character *liege = nullptr;
 	std::vector<character *> vassals;
+	realm_statistics de_facto_statistics; //the statistics of the character's realm, including those of its vassals
 	std::vector<trait *> traits;
 	std::vector<item *> items;
 	government_type *government_type = nullptr;
@@ -49,6 +49,11 @@ public:
 		return this->culture;
 	}
 
+	void set_culture(metternich::culture *culture)
+	{
+		this->culture = culture;
+	}
+
 private:
 	std::string name;
 	metternich::culture *culture = nullptr;
@@ -110,15 +110,15 @@ QVariantList culture::get_derived_cultures_qvariant_list() const
 std::string culture::generate_male_name() const
 {
 	if (!this->get_male_names().empty()) {
-		return vector::get_random(this->get_male_names());
+		return vector::get_random(this->get_male_names(), random_stream::character);
 	}
 
 	if (!this->get_group()->get_male_names().empty()) {
-		return vector::get_random(this->get_group()->get_male_names());
+		return vector::get_random(this->get_group()->get_male_names(), random_stream::character);
 	}
 
 	if (!this->get_supergroup()->get_male_names().empty()) {
-		return vector::get_random(this->get_supergroup()->get_male_names());
+		return vector::get_random(this->get_supergroup()->get_male_names(), random_stream::character);
 	}
 
 	throw std::runtime_error("No male name could be generated for culture \"" + this->get_identifier() + "\"");
@@ -127,15 +127,15 @@ std::string culture::generate_male_name() const
 std::string culture::generate_female_name() const
 {
 	if (!this->get_female_names().empty()) {
-		return vector::get_random(this->get_female_names());
+		return vector::get_random(this->get_female_names(), random_stream::character);
 	}
 
 	if (!this->get_group()->get_female_names().empty()) {
-		return vector::get_random(this->get_group()->get_female_names());
+		return vector::get_random(this->get_group()->get_female_names(), random_stream::character);
 	}
 
 	if (!this->get_supergroup()->get_female_names().empty()) {
-		return vector::get_random(this->get_supergroup()->get_female_names());
+		return vector::get_random(this->get_supergroup()->get_female_names(), random_stream::character);
 	}
 
 	throw std::runtime_error("No female name could be generated for culture \"" + this->get_identifier() + "\"");
@@ -144,15 +144,15 @@ std::string culture::generate_female_name() const
 std::string culture::generate_dynasty_name() const
 {
 	if (!this->get_dynasty_names().empty()) {
-		return vector::get_random(this->get_dynasty_names());
+		return vector::get_random(this->get_dynasty_names(), random_stream::character);
 	}
 
 	if (!this->get_group()->get_dynasty_names().empty()) {
-		return vector::get_random(this->get_group()->get_dynasty_names());
+		return vector::get_random(this->get_group()->get_dynasty_names(), random_stream::character);
 	}
 
 	if (!this->get_supergroup()->get_dynasty_names().empty()) {
-		return vector::get_random(this->get_supergroup()->get_dynasty_names());
+		return vector::get_random(this->get_supergroup()->get_dynasty_names(), random_stream::character);
 	}
 
 	throw std::runtime_error("No dynasty name could be generated for culture \"" + this->get_identifier() + "\"");
@@ -9,7 +9,7 @@ namespace metternich {
 void culture_base::process_gsml_scope(const gsml_data &scope)
 {
 	const std::string &tag = scope.get_tag();
-	const std::vector<std::string> &values = scope.get_values();
+	const std::vector<std::string> values(scope.get_values().begin(), scope.get_values().end());
 
 	if (tag == "male_names") {
 		switch (scope.get_operator()) {
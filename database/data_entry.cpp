@@ -5,6 +5,7 @@
 #include "history/calendar.h"
 #include "history/history.h"
 #include "history/timeline.h"
+#include "util/memory_usage.h"
 #include "util/string_util.h"
 #include "util/translator.h"
 
@@ -25,11 +26,32 @@ void data_entry_base::process_gsml_scope(const gsml_data &scope)
 }
 
 void data_entry_base::process_history(const gsml_data &data)
+{
+	this->process_undated_history(data);
+	this->process_dated_history(data);
+}
+
+/**
+**	@brief	Apply the history properties outside of a date scope, which are applied regardless of start date
+**
+**	@param	data	The history data
+*/
+void data_entry_base::process_undated_history(const gsml_data &data)
 {
 	data.for_each_property([&](const gsml_property &property) {
-		this->process_gsml_property(property); //properties outside of a date scope, to be applied regardless of start date
+		this->process_gsml_property(property);
 	});
+}
 
+/**
+**	@brief	Gather the history date scopes applicable to the current timeline and start date, to be applied when the history is loaded
+**
+**	@param	data	The history data
+**
+**	This only writes to the data entry itself, so it can be done for different data entries in parallel.
+*/
+void data_entry_base::process_dated_history(const gsml_data &data)
+{
 	data.for_each_child([&](const gsml_data &history_entry) {
 		const timeline *timeline = nullptr;
 		const calendar *calendar = nullptr;
@@ -95,6 +117,22 @@ void data_entry_base::load_date_scope(const gsml_data &date_scope, const QDateTi
 	});
 }
 
+/**
+**	@brief	Add the memory owned by the data entry to a memory report
+**
+**	@param	usage	The memory usage of the data entry's category, to which the heap memory owned directly by the data entry is added
+**	@param	report	The memory report, to which objects owned by the data entry are added under their own categories
+*/
+void data_entry_base::add_owned_memory_usage(memory_usage &usage, memory_report &report) const
+{
+	Q_UNUSED(report)
+
+	usage.add_tree(this->history_entries);
+	for (const auto &kv_pair : this->history_entries) {
+		usage.add_vector(kv_pair.second);
+	}
+}
+
 gsml_data identifiable_data_entry_base::get_cache_data() const
 {
 	throw std::runtime_error("The data entry's type does not support caching data.");
@@ -105,4 +143,16 @@ std::string data_entry::get_name() const
 	return translator::get()->translate(this->get_identifier_with_aliases());
 }
 
+void data_entry::add_owned_memory_usage(memory_usage &usage, memory_report &report) const
+{
+	identifiable_data_entry_base::add_owned_memory_usage(usage, report);
+
+	usage.add_string(this->identifier);
+
+	usage.add_tree(this->aliases);
+	for (const std::string &alias : this->aliases) {
+		usage.add_string(alias);
+	}
+}
+
 }
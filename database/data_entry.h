@@ -9,6 +9,8 @@ namespace metternich {
 
 class gsml_data;
 class gsml_property;
+class memory_report;
+class memory_usage;
 
 /**
 **	@brief	The base class for a de(serializable) but not necessarily identifiable entry to the database
@@ -36,6 +38,8 @@ public:
 	}
 
 	void process_history(const gsml_data &data);
+	void process_undated_history(const gsml_data &data);
+	void process_dated_history(const gsml_data &data);
 	void load_history();
 	void load_date_scope(const gsml_data &date_scope, const QDateTime &date);
 
@@ -53,6 +57,8 @@ public:
 
 	virtual void check_history() const {}
 
+	virtual void add_owned_memory_usage(memory_usage &usage, memory_report &report) const;
+
 	bool is_initialized() const
 	{
 		return this->initialized;
@@ -138,6 +144,7 @@ public:
 	}
 
 	virtual std::string get_name() const override;
+	virtual void add_owned_memory_usage(memory_usage &usage, memory_report &report) const override;
 
 private:
 	std::string identifier;
@@ -7,14 +7,27 @@
 #include "database/gsml_operator.h"
 #include "database/gsml_parser.h"
 #include "database/identifiable_type.h"
+#include "util/flat_string_map.h"
+#include "util/memory_usage.h"
+#include "util/parallel_util.h"
+#include "util/random.h"
+#include "util/string_interner.h"
 
 #include <QApplication>
+#include <QByteArray>
 #include <QUuid>
 
+#include <array>
+#include <cstdint>
 #include <filesystem>
+#include <limits>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace metternich {
@@ -26,7 +39,7 @@ public:
 	static constexpr bool history_only = false; //whether the data type is defined in history only
 	static constexpr const char *database_base_folder = "common";
 
-	static T *get(const std::string &identifier)
+	static T *get(const std::string_view &identifier)
 	{
 		if (identifier == "none") {
 			return nullptr;
@@ -35,7 +48,7 @@ public:
 		return identifiable_type<T>::get(identifier);
 	}
 
-	static T *try_get(const std::string &identifier)
+	static T *try_get(const std::string_view &identifier)
 	{
 		if (identifier == "none") {
 			return nullptr;
@@ -46,14 +59,32 @@ public:
 			return instance;
 		}
 
-		auto alias_find_iterator = data_type::instances_by_alias.find(identifier);
-		if (alias_find_iterator != data_type::instances_by_alias.end()) {
-			return alias_find_iterator->second;
+		T * const *alias_instance = data_type::instances_by_alias.find(identifier);
+		if (alias_instance != nullptr) {
+			return *alias_instance;
 		}
 
 		return nullptr;
 	}
 
+	/**
+	**	@brief	Get an instance by its dense index
+	**
+	**	@param	index	The index
+	**
+	**	@return	The instance, or null if it has been removed
+	*/
+	static T *get_by_index(const size_t index)
+	{
+		return data_type::instances_by_index.at(index);
+	}
+
+	//get the number of indices assigned so far, i.e. the size needed for an array-based side table indexed by the instances' indices
+	static size_t get_index_count()
+	{
+		return data_type::instances_by_index.size();
+	}
+
 	static const std::vector<T *> &get_all()
 	{
 		return data_type::instances;
@@ -65,7 +96,7 @@ public:
 		return data_type::get_all();
 	}
 
-	static bool exists(const std::string &identifier)
+	static bool exists(const std::string_view &identifier)
 	{
 		return identifiable_type<T>::exists(identifier) || data_type::instances_by_alias.contains(identifier);
 	}
@@ -74,6 +105,8 @@ public:
 	{
 		T *instance = identifiable_type<T>::add(identifier);
 		data_type::instances.push_back(instance);
+		instance->index = data_type::instances_by_index.size();
+		data_type::instances_by_index.push_back(instance);
 		instance->moveToThread(QApplication::instance()->thread());
 
 		return instance;
@@ -89,7 +122,7 @@ public:
 			throw std::runtime_error("Tried to add a " + std::string(T::class_identifier) + " alias with the already-used \"" + alias + "\" string identifier.");
 		}
 
-		data_type::instances_by_alias[alias] = instance;
+		data_type::instances_by_alias.insert_or_assign(string_interner::intern(alias), instance);
 		instance->add_alias(alias);
 	}
 
@@ -100,11 +133,12 @@ public:
 		}
 
 		data_type::instances.erase(std::remove(data_type::instances.begin(), data_type::instances.end(), instance), data_type::instances.end());
+		data_type::instances_by_index[instance->get_index()] = nullptr; //indices are not reused, so that they remain stable
 
 		identifiable_type<T>::remove(instance);
 	}
 
-	static void remove(const std::string &identifier)
+	static void remove(const std::string_view &identifier)
 	{
 		identifiable_type<T>::remove(identifier);
 	}
@@ -112,6 +146,7 @@ public:
 	static void clear()
 	{
 		data_type::instances.clear();
+		data_type::instances_by_index.clear();
 		data_type::instances_by_alias.clear();
 
 		identifiable_type<T>::clear();
@@ -129,7 +164,11 @@ public:
 			return;
 		}
 
-		database::parse_folder(database_path, T::gsml_data_to_process);
+		if (data_type::gsml_data_arena == nullptr) {
+			data_type::gsml_data_arena = std::make_unique<std::pmr::monotonic_buffer_resource>();
+		}
+
+		database::parse_folder(database_path, T::gsml_data_to_process, data_type::gsml_data_arena.get());
 	}
 
 	static void process_database(const bool definition)
@@ -170,7 +209,13 @@ public:
 		}
 
 		if (!definition) {
+			if (memory_report::is_transient_data_tracked()) {
+				data_type::gsml_data_peak_usage = memory_usage();
+				data_type::add_gsml_data_memory_usage(data_type::gsml_data_peak_usage, T::gsml_data_to_process);
+			}
+
 			T::gsml_data_to_process.clear();
+			data_type::gsml_data_arena.reset(); //releases the memory of all the parsed data in one go
 		}
 	}
 
@@ -179,7 +224,12 @@ public:
 		std::string identifier;
 
 		while (identifier.empty() || data_type::try_get(identifier) != nullptr) {
-			QUuid uuid = QUuid::createUuid();
+			//generate the UUID from a random stream rather than with QUuid::createUuid(), so that generated identifiers are reproducible when the random streams are seeded
+			const std::array<uint64_t, 2> uuid_data = {
+				random::generate_in_range<uint64_t>(0, std::numeric_limits<uint64_t>::max(), random_stream::identifier),
+				random::generate_in_range<uint64_t>(0, std::numeric_limits<uint64_t>::max(), random_stream::identifier)
+			};
+			const QUuid uuid = QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char *>(uuid_data.data()), sizeof(uuid_data)));
 			identifier = std::string(T::class_identifier) + "_" + uuid.toString(QUuid::WithoutBraces).toStdString();
 		}
 
@@ -199,7 +249,7 @@ public:
 				continue;
 			}
 
-			database::parse_folder(history_path, T::gsml_history_data_to_process);
+			database::parse_folder(history_path, T::gsml_history_data_to_process, T::get_gsml_history_data_arena());
 		}
 	}
 
@@ -211,38 +261,44 @@ public:
 				return;
 			}
 
+			std::vector<std::pair<T *, const gsml_data *>> history_data_list;
+
 			for (const gsml_data &data : T::gsml_history_data_to_process) {
 				try {
-					T *instance = T::get(data.get_tag());
-					instance->process_history(data);
+					history_data_list.emplace_back(T::get(data.get_tag()), &data);
 				} catch (...) {
 					std::throw_with_nested(std::runtime_error("Error processing history data for " + std::string(T::class_identifier) + " instance \"" + data.get_tag() + "\"."));
 				}
 			}
+
+			data_type::process_history_data(history_data_list);
 		} else {
+			std::vector<std::pair<T *, const gsml_data *>> history_data_list;
+
 			for (const gsml_data &data : T::gsml_history_data_to_process) {
 				data.for_each_child([&](const gsml_data &data_entry) {
 					//for history only data types, a new instance is created for history
 					const std::string &identifier = data_entry.get_tag();
 
-					T *instance = nullptr;
-
 					try {
 						if (definition) {
 							if (data_entry.get_operator() == gsml_operator::addition) {
 								return; //addition operators for data entry scopes mean modifying already-defined entries
 							}
 
-							instance = T::add(identifier);
+							T::add(identifier);
 						} else {
-							instance = T::get(identifier);
-							instance->process_history(data_entry);
+							history_data_list.emplace_back(T::get(identifier), &data_entry);
 						}
 					} catch (...) {
 						std::throw_with_nested(std::runtime_error("Error processing history data for " + std::string(T::class_identifier) + " instance \"" + identifier + "\"."));
 					}
 				});
 			}
+
+			if (!definition) {
+				data_type::process_history_data(history_data_list);
+			}
 		}
 
 		if (!definition) {
@@ -254,7 +310,12 @@ public:
 				}
 			}
 
-			T::gsml_history_data_to_process.clear();
+			if (memory_report::is_transient_data_tracked()) {
+				data_type::gsml_history_data_peak_usage = memory_usage();
+				data_type::add_gsml_data_memory_usage(data_type::gsml_history_data_peak_usage, T::gsml_history_data_to_process);
+			}
+
+			T::clear_gsml_history_data();
 		}
 	}
 
@@ -270,8 +331,9 @@ public:
 			return;
 		}
 
+		std::pmr::monotonic_buffer_resource cache_data_arena;
 		std::vector<gsml_data> cache_data_to_process;
-		database::parse_folder(cache_path, cache_data_to_process);
+		database::parse_folder(cache_path, cache_data_to_process, &cache_data_arena);
 
 		for (const gsml_data &data : cache_data_to_process) {
 			T *instance = T::get(data.get_tag());
@@ -305,6 +367,30 @@ public:
 		}
 	}
 
+	/**
+	**	@brief	Add the memory used by the data type's instances, registries and unprocessed GSML data to a memory report
+	**
+	**	@param	report	The memory report
+	*/
+	static void add_memory_usage(memory_report &report)
+	{
+		for (const T *instance : T::get_all()) {
+			report.add_instance(instance, T::class_identifier);
+		}
+
+		memory_usage &usage = report.get_usage(T::class_identifier);
+		usage.add_vector(data_type::instances);
+		usage.add_vector(data_type::instances_by_index);
+		usage.add_allocation(data_type::instances_by_alias.get_allocated_size());
+		identifiable_type<T>::add_registry_memory_usage(usage);
+
+		const std::string class_identifier(T::class_identifier);
+		data_type::add_gsml_data_memory_usage(report.get_usage(class_identifier + " gsml_data_to_process"), data_type::gsml_data_to_process);
+		data_type::add_gsml_data_memory_usage(report.get_usage(class_identifier + " gsml_history_data_to_process"), T::gsml_history_data_to_process);
+		report.get_released_peak_usage(class_identifier + " gsml_data_to_process") += data_type::gsml_data_peak_usage;
+		report.get_released_peak_usage(class_identifier + " gsml_history_data_to_process") += data_type::gsml_history_data_peak_usage;
+	}
+
 	static void initialize_all()
 	{
 		for (T *instance : T::get_all()) {
@@ -347,7 +433,64 @@ public:
 		}
 	}
 
+	//get the instance's dense index, which is stable for the instance's lifetime and can be used to index array-based side tables
+	size_t get_index() const
+	{
+		return this->index;
+	}
+
 private:
+	/**
+	**	@brief	Process the history data for instances
+	**
+	**	@param	history_data_list	The instances and their history data, in the order in which they are to be processed
+	**
+	**	Gathering the date scopes only writes to the instance itself, so it is done for different instances in parallel, while properties outside of date scopes may affect other instances, and are then applied in order.
+	*/
+	static void process_history_data(const std::vector<std::pair<T *, const gsml_data *>> &history_data_list)
+	{
+		//group the history data per instance, as an instance might have history data in more than one file, e.g. from different modules
+		std::vector<std::vector<const gsml_data *>> history_data_per_instance(T::get_index_count());
+		std::vector<T *> instances_with_history;
+
+		for (const auto &[instance, data] : history_data_list) {
+			std::vector<const gsml_data *> &instance_history_data = history_data_per_instance[instance->get_index()];
+
+			if (instance_history_data.empty()) {
+				instances_with_history.push_back(instance);
+			}
+
+			instance_history_data.push_back(data);
+		}
+
+		parallel::for_each(instances_with_history, [&](T *instance) {
+			for (const gsml_data *data : history_data_per_instance[instance->get_index()]) {
+				try {
+					instance->process_dated_history(*data);
+				} catch (...) {
+					std::throw_with_nested(std::runtime_error("Error processing history data for " + std::string(T::class_identifier) + " instance \"" + instance->get_identifier() + "\"."));
+				}
+			}
+		});
+
+		for (const auto &[instance, data] : history_data_list) {
+			try {
+				instance->process_undated_history(*data);
+			} catch (...) {
+				std::throw_with_nested(std::runtime_error("Error processing history data for " + std::string(T::class_identifier) + " instance \"" + instance->get_identifier() + "\"."));
+			}
+		}
+	}
+
+	static void add_gsml_data_memory_usage(memory_usage &usage, const std::vector<gsml_data> &gsml_data_list)
+	{
+		usage.add_vector(gsml_data_list);
+		for (const gsml_data &data : gsml_data_list) {
+			usage.increment_instance_count();
+			data.add_memory_usage(usage);
+		}
+	}
+
 	static inline std::set<std::string> get_database_dependencies()
 	{
 		return {};
@@ -356,7 +499,7 @@ private:
 	static inline bool initialize_class()
 	{
 		//initialize the metadata (including database parsing/processing functions) for this data type
-		auto metadata = std::make_unique<data_type_metadata>(T::class_identifier, T::get_database_dependencies(), T::parse_database, T::process_database, T::check_all, T::check_all_history, T::initialize_all, T::initialize_all_history);
+		auto metadata = std::make_unique<data_type_metadata>(T::class_identifier, T::get_database_dependencies(), T::parse_database, T::process_database, T::check_all, T::check_all_history, T::initialize_all, T::initialize_all_history, T::add_memory_usage);
 		database::get()->register_metadata(std::move(metadata));
 
 		return true;
@@ -364,8 +507,12 @@ private:
 
 private:
 	static inline std::vector<T *> instances;
-	static inline std::map<std::string, T *> instances_by_alias;
+	static inline std::vector<T *> instances_by_index; //the instances by their dense index, with null for removed instances
+	static inline flat_string_map<T *> instances_by_alias; //keyed by interned aliases
 	static inline std::vector<gsml_data> gsml_data_to_process;
+	static inline std::unique_ptr<std::pmr::monotonic_buffer_resource> gsml_data_arena; //the arena in which the GSML data to process is allocated
+	static inline memory_usage gsml_data_peak_usage; //the memory used by the GSML data to process before it was released
+	static inline memory_usage gsml_history_data_peak_usage;
 	static inline std::set<std::string> database_dependencies; //the other classes on which this one depends, i.e. after which this class' database can be processed
 #ifdef __GNUC__
 	//the "used" attribute is needed under GCC, or else this variable will be optimized away (even in debug builds)
@@ -373,6 +520,8 @@ private:
 #else
 	static inline bool class_initialized = data_type::initialize_class();
 #endif
+
+	size_t index = 0;
 };
 
 }
@@ -2,6 +2,8 @@
 
 #include "database/gsml_data.h"
 
+#include <memory>
+#include <memory_resource>
 #include <vector>
 
 namespace metternich {
@@ -12,8 +14,28 @@ namespace metternich {
 template <typename T>
 class data_type_base
 {
+protected:
+	//get the arena in which the history GSML data to process is allocated, creating it if necessary
+	static std::pmr::memory_resource *get_gsml_history_data_arena()
+	{
+		if (data_type_base::gsml_history_data_arena == nullptr) {
+			data_type_base::gsml_history_data_arena = std::make_unique<std::pmr::monotonic_buffer_resource>();
+		}
+
+		return data_type_base::gsml_history_data_arena.get();
+	}
+
+	static void clear_gsml_history_data()
+	{
+		data_type_base::gsml_history_data_to_process.clear();
+		data_type_base::gsml_history_data_arena.reset(); //releases the memory of all the parsed history data in one go
+	}
+
 protected:
 	static inline std::vector<gsml_data> gsml_history_data_to_process;
+
+private:
+	static inline std::unique_ptr<std::pmr::monotonic_buffer_resource> gsml_history_data_arena;
 };
 
 }
@@ -4,14 +4,16 @@
 
 namespace metternich {
 
+class memory_report;
+
 /**
 **	@brief	The metadata for a data type, including e.g. its initialization function
 */
 class data_type_metadata
 {
 public:
-	data_type_metadata(const std::string &class_identifier, const std::set<std::string> &database_dependencies, const std::function<void(const std::filesystem::path &)> &parsing_function, const std::function<void(bool)> &processing_function, const std::function<void()> &checking_function, const std::function<void()> &history_checking_function, const std::function<void()> &initialization_function, const std::function<void()> &history_initialization_function)
-		: class_identifier(class_identifier), database_dependencies(database_dependencies), parsing_function(parsing_function), processing_function(processing_function), checking_function(checking_function), history_checking_function(history_checking_function), initialization_function(initialization_function), history_initialization_function(history_initialization_function)
+	data_type_metadata(const std::string &class_identifier, const std::set<std::string> &database_dependencies, const std::function<void(const std::filesystem::path &)> &parsing_function, const std::function<void(bool)> &processing_function, const std::function<void()> &checking_function, const std::function<void()> &history_checking_function, const std::function<void()> &initialization_function, const std::function<void()> &history_initialization_function, const std::function<void(memory_report &)> &memory_usage_function)
+		: class_identifier(class_identifier), database_dependencies(database_dependencies), parsing_function(parsing_function), processing_function(processing_function), checking_function(checking_function), history_checking_function(history_checking_function), initialization_function(initialization_function), history_initialization_function(history_initialization_function), memory_usage_function(memory_usage_function)
 	{
 	}
 
@@ -65,6 +67,11 @@ public:
 		return this->history_initialization_function;
 	}
 
+	const std::function<void(memory_report &)> &get_memory_usage_function() const
+	{
+		return this->memory_usage_function;
+	}
+
 private:
 	std::string class_identifier;
 	std::set<std::string> database_dependencies;
@@ -74,6 +81,7 @@ private:
 	std::function<void()> history_checking_function; //functions for each data type, to check if data entries' history is valid
 	std::function<void()> initialization_function; //functions for each data type, to initialize their entries
 	std::function<void()> history_initialization_function; //functions for each data type, to initialize their entries' history
+	std::function<void(memory_report &)> memory_usage_function; //functions for each data type, to add the memory used by them to a memory report
 };
 
 }
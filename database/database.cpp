@@ -49,6 +49,7 @@
 #include "util/parse_util.h"
 #include "util/qunique_ptr.h"
 #include "util/random.h"
+#include "util/string_interner.h"
 #include "util/string_util.h"
 #include "util/translator.h"
 #include "util/vector_random_util.h"
@@ -384,7 +385,7 @@ QVariant database::process_gsml_scope_value(const gsml_data &scope, const QMetaP
 	return new_property_value;
 }
 
-void database::parse_folder(const std::filesystem::path &path, std::vector<gsml_data> &gsml_data_list)
+void database::parse_folder(const std::filesystem::path &path, std::vector<gsml_data> &gsml_data_list, std::pmr::memory_resource *memory_resource)
 {
 	std::filesystem::recursive_directory_iterator dir_iterator(path);
 
@@ -393,7 +394,7 @@ void database::parse_folder(const std::filesystem::path &path, std::vector<gsml_
 			continue;
 		}
 
-		gsml_parser parser(dir_entry.path());
+		gsml_parser parser(dir_entry.path(), memory_resource);
 		gsml_data_list.push_back(parser.parse());
 	}
 }
@@ -502,6 +503,15 @@ void database::register_metadata(std::unique_ptr<data_type_metadata> &&metadata)
 	this->metadata.push_back(std::move(metadata));
 }
 
+void database::add_memory_usage(memory_report &report) const
+{
+	for (const std::unique_ptr<data_type_metadata> &metadata : this->metadata) {
+		metadata->get_memory_usage_function()(report);
+	}
+
+	string_interner::add_memory_usage(report.get_usage("interned_string"));
+}
+
 void database::process_modules()
 {
 	this->process_modules_at_dir(database::get_modules_path());
@@ -619,7 +629,7 @@ const std::filesystem::path &database::get_tagged_image_path(const std::map<std:
 	for (const std::string &suffix : suffix_combinations) {
 		auto find_iterator = image_paths_by_tag.find(base_tag + suffix + final_suffix);
 		if (find_iterator != image_paths_by_tag.end()) {
-			return vector::get_random(find_iterator->second);
+			return vector::get_random(find_iterator->second, random_stream::interface);
 		}
 	}
 
@@ -10,6 +10,7 @@
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <variant>
 #include <vector>
@@ -18,6 +19,7 @@ namespace metternich {
 
 class data_entry;
 class data_type_metadata;
+class memory_report;
 class module;
 
 class database final : public singleton<database>
@@ -98,7 +100,7 @@ public:
 		return cache_path;
 	}
 
-	static void parse_folder(const std::filesystem::path &path, std::vector<gsml_data> &gsml_data_list);
+	static void parse_folder(const std::filesystem::path &path, std::vector<gsml_data> &gsml_data_list, std::pmr::memory_resource *memory_resource = std::pmr::get_default_resource());
 
 public:
 	database();
@@ -108,6 +110,7 @@ public:
 	void initialize();
 	void initialize_history();
 	void register_metadata(std::unique_ptr<data_type_metadata> &&metadata);
+	void add_memory_usage(memory_report &report) const;
 
 	void process_modules();
 	void process_modules_at_dir(const std::filesystem::path &path, module *parent_module = nullptr);
@@ -35,6 +35,10 @@ class defines final : public QObject, public singleton<defines>
 	Q_PROPERTY(int trade_node_score_religion_group_modifier MEMBER trade_node_score_religion_group_modifier READ get_trade_node_score_religion_group_modifier)
 	Q_PROPERTY(int trade_cost_modifier_per_distance MEMBER trade_cost_modifier_per_distance READ get_trade_cost_modifier_per_distance)
 	Q_PROPERTY(int base_port_trade_cost_modifier MEMBER base_port_trade_cost_modifier READ get_base_port_trade_cost_modifier)
+	Q_PROPERTY(int technology_diffusion_rate MEMBER technology_diffusion_rate READ get_technology_diffusion_rate)
+	Q_PROPERTY(int technology_diffusion_threshold MEMBER technology_diffusion_threshold READ get_technology_diffusion_threshold)
+	Q_PROPERTY(int technology_diffusion_trade_route_weight MEMBER technology_diffusion_trade_route_weight READ get_technology_diffusion_trade_route_weight)
+	Q_PROPERTY(int technology_diffusion_trade_node_modifier MEMBER technology_diffusion_trade_node_modifier READ get_technology_diffusion_trade_node_modifier)
 
 public:
 
@@ -123,6 +127,26 @@ public:
 		return base_port_trade_cost_modifier;
 	}
 
+	int get_technology_diffusion_rate() const
+	{
+		return this->technology_diffusion_rate;
+	}
+
+	int get_technology_diffusion_threshold() const
+	{
+		return this->technology_diffusion_threshold;
+	}
+
+	int get_technology_diffusion_trade_route_weight() const
+	{
+		return this->technology_diffusion_trade_route_weight;
+	}
+
+	int get_technology_diffusion_trade_node_modifier() const
+	{
+		return this->technology_diffusion_trade_node_modifier;
+	}
+
 private:
 	timeline *default_timeline = nullptr;
 	QDateTime start_date;
@@ -140,6 +164,10 @@ private:
 	int trade_node_score_religion_group_modifier = 0;
 	int trade_cost_modifier_per_distance = 0; //trade cost modifier for every [province::base_distance] kilometers
 	int base_port_trade_cost_modifier = 0; //base trade cost modifier when going from a water province to a land one or vice-versa
+	int technology_diffusion_rate = 0; //the monthly technology progress a province gains from a neighbor with the same population which has the technology and surrounds it entirely; technologies don't diffuse if this is 0
+	int technology_diffusion_threshold = 10000; //the technology progress needed for a province to acquire a technology
+	int technology_diffusion_trade_route_weight = 0; //permille; the weight of the connection between the endpoints of an active trade route for technology diffusion, relative to a province being entirely surrounded by another
+	int technology_diffusion_trade_node_modifier = 0; //the technology diffusion modifier between provinces in the same trade node
 };
 
 }
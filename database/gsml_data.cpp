@@ -2,6 +2,7 @@
 
 #include "database/gsml_operator.h"
 #include "database/gsml_property_visitor.h"
+#include "util/memory_usage.h"
 
 namespace metternich {
 
@@ -60,4 +61,30 @@ void gsml_data::print(std::ofstream &ofstream, const size_t indentation, const b
 	}
 }
 
+/**
+**	@brief	Add the heap memory owned by the GSML data, recursively, counting each scope as an instance
+**
+**	@param	usage	The memory usage to be added to
+*/
+void gsml_data::add_memory_usage(memory_usage &usage) const
+{
+	usage.add_string(this->tag);
+
+	usage.add_vector(this->values);
+	for (const std::string &value : this->values) {
+		usage.add_string(value);
+	}
+
+	usage.add_vector(this->elements);
+	for (const std::variant<gsml_property, gsml_data> &element : this->elements) {
+		if (std::holds_alternative<gsml_property>(element)) {
+			std::get<gsml_property>(element).add_memory_usage(usage);
+		} else {
+			const gsml_data &child_data = std::get<gsml_data>(element);
+			usage.increment_instance_count();
+			child_data.add_memory_usage(usage);
+		}
+	}
+}
+
 }
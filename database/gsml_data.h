@@ -13,6 +13,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory_resource>
 #include <string>
 #include <variant>
 #include <vector>
@@ -20,13 +21,18 @@
 namespace metternich {
 
 class gsml_parser;
+class memory_usage;
 
 /**
 **	@brief	Grand strategy markup language data
+**
+**	The element and value lists are allocated with a polymorphic allocator, so that parsed data trees can be placed in an arena and released in one go. Copies of GSML data use the default memory resource, and as such may safely outlive the arena of the copied data.
 */
 class gsml_data
 {
 public:
+	using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
 	template <typename point_type>
 	static gsml_data from_point(const point_type &point, const std::string &tag = std::string())
 	{
@@ -65,6 +71,11 @@ public:
 	{
 	}
 
+	gsml_data(std::string &&tag, const gsml_operator scope_operator, const allocator_type &allocator)
+		: tag(std::move(tag)), scope_operator(scope_operator), values(allocator), elements(allocator)
+	{
+	}
+
 	gsml_data(const std::string &tag) : gsml_data(std::string(tag))
 	{
 	}
@@ -79,6 +90,11 @@ public:
 		return this->tag;
 	}
 
+	allocator_type get_allocator() const
+	{
+		return this->elements.get_allocator();
+	}
+
 	gsml_operator get_operator() const
 	{
 		return this->scope_operator;
@@ -122,7 +138,7 @@ public:
 
 	gsml_data &add_child()
 	{
-		this->elements.push_back(gsml_data());
+		this->elements.push_back(gsml_data(std::string(), gsml_operator::assignment, this->get_allocator()));
 		return std::get<gsml_data>(this->elements.back());
 	}
 
@@ -133,7 +149,7 @@ public:
 
 	gsml_data &add_child(std::string &&tag, const gsml_operator gsml_operator)
 	{
-		this->elements.push_back(gsml_data(std::move(tag), gsml_operator));
+		this->elements.push_back(gsml_data(std::move(tag), gsml_operator, this->get_allocator()));
 		return std::get<gsml_data>(this->elements.back());
 	}
 
@@ -187,7 +203,7 @@ public:
 		}
 	}
 
-	const std::vector<std::string> &get_values() const
+	const std::pmr::vector<std::string> &get_values() const
 	{
 		return this->values;
 	}
@@ -207,7 +223,7 @@ public:
 		return this->get_elements().empty() && this->get_values().empty();
 	}
 
-	const std::vector<std::variant<gsml_property, gsml_data>> &get_elements() const
+	const std::pmr::vector<std::variant<gsml_property, gsml_data>> &get_elements() const
 	{
 		return this->elements;
 	}
@@ -315,6 +331,7 @@ public:
 	}
 
 	void print(std::ofstream &ofstream, const size_t indentation, const bool new_line) const;
+	void add_memory_usage(memory_usage &usage) const;
 
 	void print_components(std::ofstream &ofstream, const size_t indentation = 0) const
 	{
@@ -363,8 +380,8 @@ private:
 	std::string tag;
 	gsml_operator scope_operator;
 	gsml_data *parent = nullptr;
-	std::vector<std::string> values; //values directly attached to the GSML data scope, used for e.g. name arrays
-	std::vector<std::variant<gsml_property, gsml_data>> elements;
+	std::pmr::vector<std::string> values; //values directly attached to the GSML data scope, used for e.g. name arrays
+	std::pmr::vector<std::variant<gsml_property, gsml_data>> elements;
 
 	friend gsml_parser;
 };
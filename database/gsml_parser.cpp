@@ -8,8 +8,8 @@
 
 namespace metternich {
 
-gsml_parser::gsml_parser(const std::filesystem::path &filepath)
-	: filepath(filepath), current_property_operator(gsml_operator::none)
+gsml_parser::gsml_parser(const std::filesystem::path &filepath, std::pmr::memory_resource *memory_resource)
+	: filepath(filepath), memory_resource(memory_resource), current_property_operator(gsml_operator::none)
 {
 }
 
@@ -25,7 +25,7 @@ gsml_data gsml_parser::parse()
 		throw std::runtime_error("Failed to open file: " + this->filepath.string());
 	}
 
-	gsml_data file_gsml_data(this->filepath.stem().string());
+	gsml_data file_gsml_data(this->filepath.stem().string(), gsml_operator::assignment, this->memory_resource);
 
 	std::string line;
 	int line_index = 1;
@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <memory_resource>
 
 namespace metternich {
 
@@ -11,7 +12,7 @@ enum class gsml_operator;
 class gsml_parser
 {
 public:
-	gsml_parser(const std::filesystem::path &filepath);
+	gsml_parser(const std::filesystem::path &filepath, std::pmr::memory_resource *memory_resource = std::pmr::get_default_resource());
 
 	gsml_data parse();
 
@@ -23,6 +24,7 @@ private:
 
 private:
 	std::filesystem::path filepath;
+	std::pmr::memory_resource *memory_resource = nullptr; //the memory resource from which to allocate the parsed data's element and value lists
 	std::vector<std::string> tokens;
 	gsml_data *current_gsml_data = nullptr;
 	std::string current_key;
@@ -1,6 +1,7 @@
 #include "database/gsml_property.h"
 
 #include "database/gsml_operator.h"
+#include "util/memory_usage.h"
 
 namespace metternich {
 
@@ -25,4 +26,10 @@ void gsml_property::print(std::ofstream &ofstream, const size_t indentation) con
 	ofstream << " " << this->get_value() << "\n";
 }
 
+void gsml_property::add_memory_usage(memory_usage &usage) const
+{
+	usage.add_string(this->key);
+	usage.add_string(this->value);
+}
+
 }
@@ -5,6 +5,7 @@
 
 namespace metternich {
 
+class memory_usage;
 enum class gsml_operator;
 
 class gsml_property
@@ -36,6 +37,7 @@ public:
 	}
 
 	void print(std::ofstream &ofstream, const size_t indentation) const;
+	void add_memory_usage(memory_usage &usage) const;
 
 private:
 	std::string key;
@@ -1,15 +1,18 @@
 #pragma once
 
+#include "util/flat_string_map.h"
+#include "util/memory_usage.h"
 #include "util/qunique_ptr.h"
+#include "util/string_interner.h"
 
-#include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 namespace metternich {
 
-//a type with an identifier to instance database
+//a type with an identifier to instance database, keyed by interned identifiers, so that lookups can be done with string views without allocating
 template <typename T, bool is_qobject = false>
 class identifiable_type
 {
@@ -17,22 +20,22 @@ class identifiable_type
 	using unique_ptr = std::conditional_t<is_qobject, qunique_ptr<U>, std::unique_ptr<U>>;
 
 public:
-	static T *get(const std::string &identifier)
+	static T *get(const std::string_view &identifier)
 	{
 		T *instance = T::try_get(identifier);
 
 		if (instance == nullptr) {
-			throw std::runtime_error("Invalid " + std::string(T::class_identifier) + " instance: \"" + identifier + "\".");
+			throw std::runtime_error("Invalid " + std::string(T::class_identifier) + " instance: \"" + std::string(identifier) + "\".");
 		}
 
 		return instance;
 	}
 
-	static T *try_get(const std::string &identifier)
+	static T *try_get(const std::string_view &identifier)
 	{
-		auto find_iterator = identifiable_type::instances_by_identifier.find(identifier);
-		if (find_iterator != identifiable_type::instances_by_identifier.end()) {
-			return find_iterator->second.get();
+		const unique_ptr<T> *instance = identifiable_type::instances_by_identifier.find(identifier);
+		if (instance != nullptr) {
+			return instance->get();
 		}
 
 		return nullptr;
@@ -48,7 +51,7 @@ public:
 		return T::add(identifier);
 	}
 
-	static bool exists(const std::string &identifier)
+	static bool exists(const std::string_view &identifier)
 	{
 		return identifiable_type::instances_by_identifier.contains(identifier);
 	}
@@ -63,14 +66,16 @@ public:
 			throw std::runtime_error("Tried to add a " + std::string(T::class_identifier) + " instance with the already-used \"" + identifier + "\" string identifier.");
 		}
 
+		const std::string_view interned_identifier = string_interner::intern(identifier);
+
+		unique_ptr<T> instance;
 		if constexpr (is_qobject) {
-			identifiable_type::instances_by_identifier[identifier] = make_qunique<T>(identifier);
+			instance = make_qunique<T>(identifier);
 		} else {
-			identifiable_type::instances_by_identifier[identifier] = std::make_unique<T>(identifier);
+			instance = std::make_unique<T>(identifier);
 		}
-		T *instance = identifiable_type::instances_by_identifier.find(identifier)->second.get();
 
-		return instance;
+		return identifiable_type::instances_by_identifier.insert_or_assign(interned_identifier, std::move(instance)).get();
 	}
 
 	static void remove(T *instance)
@@ -78,7 +83,7 @@ public:
 		identifiable_type::instances_by_identifier.erase(instance->get_identifier());
 	}
 
-	static void remove(const std::string &identifier)
+	static void remove(const std::string_view &identifier)
 	{
 		T::remove(T::get(identifier));
 	}
@@ -88,8 +93,14 @@ public:
 		identifiable_type::instances_by_identifier.clear();
 	}
 
+	static void add_registry_memory_usage(memory_usage &usage)
+	{
+		//the identifiers themselves are owned by the string interner
+		usage.add_allocation(identifiable_type::instances_by_identifier.get_allocated_size());
+	}
+
 private:
-	static inline std::map<std::string, unique_ptr<T>> instances_by_identifier;
+	static inline flat_string_map<unique_ptr<T>> instances_by_identifier;
 };
 
 }
@@ -34,7 +34,7 @@ public:
 				continue;
 			}
 
-			database::parse_folder(history_path, T::gsml_history_data_to_process);
+			database::parse_folder(history_path, T::gsml_history_data_to_process, T::get_gsml_history_data_arena());
 		}
 	}
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "util/object_pool.h"
+
 namespace metternich {
 
 class building_slot;
@@ -7,7 +9,7 @@ class employment_type;
 class holding;
 class population_unit;
 
-class employment
+class employment final : public pooled_object<employment>
 {
 public:
 	employment(const employment_type *type, building_slot *building_slot)
@@ -24,6 +26,11 @@ public:
 		return type;
 	}
 
+	metternich::building_slot *get_building_slot() const
+	{
+		return this->building_slot;
+	}
+
 	holding *get_holding() const;
 
 	int get_workforce() const
@@ -60,6 +67,11 @@ public:
 		return find_iterator->second;
 	}
 
+	const std::map<population_unit *, int> &get_employee_sizes() const
+	{
+		return this->employee_sizes;
+	}
+
 	void set_employee_size(population_unit *employee, const int size);
 
 	void change_employee_size(population_unit *employee, const int change)
@@ -16,6 +16,9 @@ void trade_node::initialize()
 	}
 
 	this->get_world()->add_trade_node(this);
+
+	//the name uses the tag suffixes of the center of trade
+	connect(this->get_center_of_trade(), &province::name_changed, this, &identifiable_data_entry_base::name_changed, Qt::ConnectionType::DirectConnection);
 }
 
 void trade_node::check() const
@@ -35,7 +38,9 @@ void trade_node::check() const
 
 std::string trade_node::get_name() const
 {
-	return translator::get()->translate(this->get_identifier_with_aliases(), this->get_center_of_trade()->get_tag_suffix_list_with_fallbacks());
+	return this->cached_name.get([this]() {
+		return translator::get()->translate(this->get_identifier_with_aliases(), this->get_center_of_trade()->get_tag_suffix_list_with_fallbacks());
+	});
 }
 
 void trade_node::set_center_of_trade(province *province)
@@ -2,6 +2,7 @@
 
 #include "database/data_entry.h"
 #include "database/data_type.h"
+#include "util/cached_translation.h"
 
 #include <QColor>
 
@@ -21,7 +22,14 @@ class trade_node final : public data_entry, public data_type<trade_node>
 	Q_PROPERTY(bool active READ is_active NOTIFY active_changed)
 
 public:
-	trade_node(const std::string &identifier) : data_entry(identifier) {}
+	trade_node(const std::string &identifier) : data_entry(identifier)
+	{
+		connect(this, &identifiable_data_entry_base::name_changed, this, [this]() {
+			this->cached_name.invalidate();
+		}, Qt::ConnectionType::DirectConnection);
+		//the trade node's name is tagged like its center of trade
+		connect(this, &trade_node::center_of_trade_changed, this, &identifiable_data_entry_base::name_changed, Qt::ConnectionType::DirectConnection);
+	}
 
 	static constexpr const char *class_identifier = "trade_node";
 	static constexpr const char *database_folder = "trade_nodes";
@@ -103,6 +111,7 @@ private:
 	std::set<province *> provinces;
 	std::map<const trade_node *, int> trade_costs; //trade costs with other trade nodes
 	std::map<const trade_node *, std::vector<province *>> trade_paths; //paths to other trade nodes
+	cached_translation cached_name;
 };
 
 }
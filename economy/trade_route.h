@@ -54,6 +54,11 @@ public:
 		return this->path_endpoints.contains(province);
 	}
 
+	const std::set<const province *> &get_path_endpoints() const
+	{
+		return this->path_endpoints;
+	}
+
 	bool has_connection_between(const province *source_province, const province *target_province) const;
 	bool has_any_land_connection_for_province(const province *province) const;
 
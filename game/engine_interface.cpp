@@ -2,6 +2,7 @@
 
 #include "database/defines.h"
 #include "game/game.h"
+#include "game/tick_pacer.h"
 #include "holding/holding.h"
 #include "landed_title/landed_title.h"
 #include "landed_title/landed_title_tier.h"
@@ -97,7 +98,7 @@ bool engine_interface::is_paused() const
 
 void engine_interface::set_paused(const bool paused)
 {
-	game::get()->post_order([paused]() {
+	game::get()->post_order(paused ? "pause" : "unpause", [paused]() {
 		game::get()->set_paused(paused);
 	});
 }
@@ -109,7 +110,7 @@ int engine_interface::get_map_mode() const
 
 void engine_interface::set_map_mode(const int map_mode)
 {
-	game::get()->post_order([map_mode]() {
+	game::get()->post_order("set_map_mode " + std::to_string(map_mode), [map_mode]() {
 		map::get()->set_mode(static_cast<metternich::map_mode>(map_mode));
 	});
 }
@@ -129,23 +130,29 @@ QVariantList engine_interface::get_event_instances() const
 
 void engine_interface::add_event_instance(qunique_ptr<event_instance> &&event_instance)
 {
+	bool first_event_instance = false;
+
 	{
 		std::unique_lock<std::shared_mutex> lock(this->event_instances_mutex);
 
-		if (this->event_instances.empty()) {
-			game::get()->post_order([]() {
-				game::get()->set_paused(true);
-			});
-		}
-
+		first_event_instance = this->event_instances.empty();
 		this->event_instances.push_back(std::move(event_instance));
 	}
 
+	//the order is posted without holding the lock, so that posting never blocks the interface thread while it waits for the event instances
+	if (first_event_instance) {
+		game::get()->post_order("pause_for_event", []() {
+			game::get()->set_paused(true);
+		});
+	}
+
 	emit event_instances_changed();
 }
 
 void engine_interface::remove_event_instance(const QVariant &event_instance_variant)
 {
+	bool no_event_instances_left = false;
+
 	{
 		std::unique_lock<std::shared_mutex> lock(this->event_instances_mutex);
 
@@ -160,14 +167,58 @@ void engine_interface::remove_event_instance(const QVariant &event_instance_vari
 			}
 		}
 
-		if (this->event_instances.empty()) {
-			game::get()->post_order([]() {
-				game::get()->set_paused(false);
-			});
-		}
+		no_event_instances_left = this->event_instances.empty();
+	}
+
+	if (no_event_instances_left) {
+		game::get()->post_order("unpause_after_events", []() {
+			game::get()->set_paused(false);
+		});
 	}
 
 	emit event_instances_changed();
 }
 
+/**
+**	@brief	Get statistics for the duration of game ticks, in milliseconds, so that it can be seen how much of the tick budget is being used
+**
+**	@return	The tick statistics
+*/
+QVariantMap engine_interface::get_tick_statistics() const
+{
+	const tick_pacer &tick_pacer = game::get()->get_tick_pacer();
+	const duration_histogram &histogram = tick_pacer.get_tick_duration_histogram();
+
+	const auto to_ms = [](const std::chrono::nanoseconds duration) {
+		return std::chrono::duration<double, std::milli>(duration).count();
+	};
+
+	QVariantMap tick_statistics;
+	tick_statistics["budget"] = to_ms(tick_pacer.get_tick_budget());
+	tick_statistics["mean"] = to_ms(histogram.get_mean());
+	tick_statistics["p50"] = to_ms(histogram.get_percentile(50));
+	tick_statistics["p90"] = to_ms(histogram.get_percentile(90));
+	tick_statistics["p99"] = to_ms(histogram.get_percentile(99));
+	tick_statistics["max"] = to_ms(histogram.get_max());
+	tick_statistics["tick_count"] = QVariant::fromValue(histogram.get_count());
+	tick_statistics["catch_up_tick_count"] = QVariant::fromValue(tick_pacer.get_catch_up_tick_count());
+	tick_statistics["dropped_tick_count"] = QVariant::fromValue(tick_pacer.get_dropped_tick_count());
+	return tick_statistics;
+}
+
+qint64 engine_interface::get_kinematics_day() const
+{
+	return world::get_kinematics_day();
+}
+
+/**
+**	@brief	Sample the orbits and rotations of worlds at the current game date; called once per rendered frame, so that worlds are not updated in the game's ticks
+*/
+void engine_interface::sample_cosmic_map_kinematics()
+{
+	if (world::sample_kinematics(game::get()->get_current_date())) {
+		emit kinematics_day_changed();
+	}
+}
+
 }
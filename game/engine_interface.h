@@ -44,6 +44,7 @@ class engine_interface final : public QObject, public singleton<engine_interface
 	Q_PROPERTY(QVariantList event_instances READ get_event_instances NOTIFY event_instances_changed)
 	Q_PROPERTY(QStringList notifications READ get_notifications NOTIFY notifications_changed)
 	Q_PROPERTY(QString current_notification READ get_current_notification NOTIFY current_notification_changed)
+	Q_PROPERTY(qint64 kinematics_day READ get_kinematics_day NOTIFY kinematics_day_changed)
 
 public:
 	static constexpr int max_notifications = 10;
@@ -108,6 +109,11 @@ public:
 	void add_event_instance(qunique_ptr<event_instance> &&event_instance);
 	Q_INVOKABLE void remove_event_instance(const QVariant &event_instance_variant);
 
+	Q_INVOKABLE QVariantMap get_tick_statistics() const;
+
+	qint64 get_kinematics_day() const;
+	void sample_cosmic_map_kinematics();
+
 	const QStringList &get_notifications() const
 	{
 		return this->notifications;
@@ -161,6 +167,7 @@ signals:
 	void event_instances_changed();
 	void notifications_changed();
 	void current_notification_changed();
+	void kinematics_day_changed(); //the orbit positions, rotations and cosmic map positions of worlds change with the kinematics day, without the worlds themselves notifying it
 
 private:
 	QString loading_message; //the loading message to be displayed
@@ -2,6 +2,7 @@
 
 #include "character/character.h"
 #include "database/defines.h"
+#include "game/game_snapshot.h"
 #include "game/game_speed.h"
 #include "game/tick_period.h"
 #include "history/history.h"
@@ -12,11 +13,13 @@
 #include "map/map_mode.h"
 #include "map/province.h"
 #include "map/star_system.h"
+#include "map/territory.h"
 #include "map/world.h"
 #include "script/condition/condition_check_base.h"
 #include "script/event/event_trigger.h"
 
 #include <chrono>
+#include <thread>
 
 namespace metternich {
 
@@ -24,7 +27,14 @@ game::game() : speed(game_speed::normal), tick_period(tick_period::day)
 {
 }
 
-void game::start(const timeline *timeline, const QDateTime &start_date)
+/**
+**	@brief	Start the game
+**
+**	@param	timeline	The timeline to be played
+**	@param	start_date	The start date
+**	@param	headless	Whether the game is being run without an interface; if so, there is no player character, and the game loop thread is not started, the caller being responsible for running ticks instead
+*/
+void game::start(const timeline *timeline, const QDateTime &start_date, const bool headless)
 {
 	this->starting = true;
 	this->speed = defines::get()->get_default_game_speed();
@@ -41,69 +51,91 @@ void game::start(const timeline *timeline, const QDateTime &start_date)
 	this->amalgamate_map_inactive_worlds();
 	this->purge_superfluous_characters();
 
-	if (defines::get()->get_player_character_title()->get_holder() != nullptr) {
+	if (headless) {
+		this->set_player_character(nullptr);
+	} else if (defines::get()->get_player_character_title()->get_holder() != nullptr) {
 		this->set_player_character(defines::get()->get_player_character_title()->get_holder());
 	} else {
 		throw std::runtime_error("No valid player character.");
 	}
 
-	map::get()->set_mode(map_mode::country);
-	this->set_tick_period(tick_period::day);
-
-	this->starting = false;
-	this->running = true;
-	emit running_changed();
-	this->set_paused(true);
+	this->begin_running();
 
 	for (character *character : character::get_all_living()) {
 		character_event_trigger::game_start->do_events(character);
 	}
 
+	if (headless) {
+		return;
+	}
+
 	std::thread game_loop_thread(&game::run, this);
 	game_loop_thread.detach();
 }
 
-void game::run()
+/**
+**	@brief	Start the game from a saved snapshot of its state, instead of loading history
+**
+**	@param	filepath	The path of the snapshot file
+**	@param	headless	Whether the game is being run without an interface
+*/
+void game::load(const std::filesystem::path &filepath, const bool headless)
 {
-	while (!this->should_stop) {
-		std::chrono::time_point<std::chrono::system_clock> tick_start = std::chrono::system_clock::now();
+	this->starting = true;
+	this->speed = defines::get()->get_default_game_speed();
 
-		this->do_tick();
+	game_snapshot().load(filepath);
 
-		std::chrono::time_point<std::chrono::system_clock> tick_end = std::chrono::system_clock::now();
+	if (headless) {
+		this->set_player_character(nullptr);
+	} else if (this->get_player_character() == nullptr) {
+		//the snapshot may have been saved by a headless run
+		if (defines::get()->get_player_character_title()->get_holder() != nullptr) {
+			this->set_player_character(defines::get()->get_player_character_title()->get_holder());
+		} else {
+			throw std::runtime_error("No valid player character.");
+		}
+	}
 
-		std::chrono::milliseconds tick_run_ms = std::chrono::duration_cast<std::chrono::milliseconds>(tick_end - tick_start);
+	this->begin_running();
 
-		//sleep for the remaining duration of the tick, if any
-		std::chrono::milliseconds tick_ms;
+	if (headless) {
+		return;
+	}
 
-		switch (this->speed) {
-			case game_speed::slowest: {
-				tick_ms = std::chrono::milliseconds(2000);
-				break;
-			}
-			case game_speed::slow: {
-				tick_ms = std::chrono::milliseconds(1000);
-				break;
-			}
-			case game_speed::normal: {
-				tick_ms = std::chrono::milliseconds(500);
-				break;
-			}
-			case game_speed::fast: {
-				tick_ms = std::chrono::milliseconds(100);
-				break;
-			}
-			case game_speed::fastest: {
-				tick_ms = std::chrono::milliseconds(1); //about as fast as possible, but leaving a bit of time for the UI thread to process its event loop
-				break;
-			}
-		}
+	std::thread game_loop_thread(&game::run, this);
+	game_loop_thread.detach();
+}
+
+/**
+**	@brief	Save a snapshot of the game's state
+**
+**	@param	filepath	The path of the snapshot file
+**
+**	This must be called either from the game loop thread, or while the game loop is not running.
+*/
+void game::save(const std::filesystem::path &filepath) const
+{
+	game_snapshot().save(filepath);
+}
 
-		tick_ms -= tick_run_ms;
-		if (tick_ms > std::chrono::milliseconds(0)) {
-			std::this_thread::sleep_for(tick_ms);
+void game::run()
+{
+	this->tick_pacer.reset(this->speed);
+
+	while (!this->should_stop) {
+		const int tick_count = this->tick_pacer.begin_wakeup(this->speed);
+
+		//run several ticks in a single wakeup if the game loop has fallen behind
+		for (int i = 0; i < tick_count && !this->should_stop; ++i) {
+			const tick_pacer::clock::time_point tick_start = tick_pacer::clock::now();
+
+			this->do_tick();
+
+			this->tick_pacer.record_tick_duration(tick_pacer::clock::now() - tick_start);
 		}
+
+		this->tick_pacer.wait_for_next_tick();
 	}
 
 	this->running = false;
@@ -112,7 +144,13 @@ void game::run()
 
 void game::do_tick()
 {
+	TRACE_SCOPE("game::do_tick");
+
+	//the ticks may be run by the caller in headless mode, rather than by the game loop thread
+	this->game_loop_thread_id.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
 	condition_check_base::recalculate_pending_checks();
+	territory::update_pending_technology_slots();
 
 	//process the orders given by the player
 	this->do_orders();
@@ -158,6 +196,36 @@ void game::do_tick()
 
 			break;
 	}
+
+	TRACE_SAMPLE_COUNTERS();
+}
+
+void game::do_orders()
+{
+	//execute the orders which have been posted up to now in a single batch, leaving any orders posted by the executed ones for the next tick
+	std::vector<queued_order> game_loop_orders = std::move(this->game_loop_orders);
+	this->game_loop_orders.clear();
+
+	for (queued_order &order : game_loop_orders) {
+		this->execute_order(std::move(order));
+	}
+
+	this->orders.drain([this](queued_order &&order) {
+		this->execute_order(std::move(order));
+	});
+}
+
+void game::execute_order(queued_order &&order)
+{
+	if (order.post_time != std::chrono::steady_clock::time_point()) {
+		this->order_latency_histogram.record(std::chrono::steady_clock::now() - order.post_time);
+	}
+
+	order.function();
+
+	if (this->is_order_log_enabled()) {
+		this->order_log.push_back(std::move(order.description));
+	}
 }
 
 void game::do_day()
@@ -168,9 +236,17 @@ void game::do_day()
 	const size_t current_day = static_cast<size_t>(date.day());
 	const size_t current_year_day = static_cast<size_t>(date.dayOfYear());
 
+	this->construction_scheduler.do_day();
+
+	//the remaining construction days of holdings change every day, but only those of the selected holding are shown by the interface, so other holdings are not notified of it
+	holding *selected_holding = holding::get_selected_holding();
+	if (selected_holding != nullptr && selected_holding->get_under_construction_building() != nullptr) {
+		emit selected_holding->construction_days_changed();
+	}
+
 	this->do_day_for_type<holding_slot>(days_in_month, days_in_year, current_day, current_year_day);
 	this->do_day_for_type<province>(days_in_month, days_in_year, current_day, current_year_day);
-	this->do_day_for_type<world>(days_in_month, days_in_year, current_day, current_year_day);
+	this->do_day_for_type<world, false>(days_in_month, days_in_year, current_day, current_year_day);
 	this->do_day_for_type<star_system>(days_in_month, days_in_year, current_day, current_year_day);
 	this->do_day_for_type<character, false>(days_in_month, days_in_year, current_day, current_year_day);
 }
@@ -231,6 +307,37 @@ void game::set_player_character(character *character)
 	}
 }
 
+void game::begin_running()
+{
+	this->calculate_realm_statistics();
+
+	map::get()->set_mode(map_mode::country);
+	this->set_tick_period(tick_period::day);
+
+	this->starting = false;
+	this->running = true;
+	emit running_changed();
+	this->set_paused(true);
+}
+
+/**
+**	@brief	Calculate the aggregate statistics of realms and de jure titles from scratch, after which they are kept up to date incrementally
+*/
+void game::calculate_realm_statistics()
+{
+	for (character *character : character::get_all()) {
+		if (character->get_liege() == nullptr) {
+			character->calculate_de_facto_statistics();
+		}
+	}
+
+	for (landed_title *landed_title : landed_title::get_all()) {
+		if (landed_title->get_de_jure_liege_title() == nullptr) {
+			landed_title->calculate_de_jure_statistics();
+		}
+	}
+}
+
 void game::generate_missing_title_holders()
 {
 	std::vector<landed_title *> landed_titles = landed_title::get_all();
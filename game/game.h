@@ -1,15 +1,23 @@
 #pragma once
 
+#include "game/tick_pacer.h"
+#include "holding/construction_scheduler.h"
+#include "util/duration_histogram.h"
+#include "util/mpsc_queue.h"
 #include "util/singleton.h"
+#include "util/small_function.h"
+#include "util/trace.h"
 
 #include <QDateTime>
 #include <QLocale>
 #include <QObject>
 
-#include <functional>
-#include <queue>
-#include <shared_mutex>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace metternich {
 
@@ -27,10 +35,18 @@ class game final : public QObject, public singleton<game>
 	Q_PROPERTY(QString current_date_string READ get_current_date_string NOTIFY current_date_changed)
 	Q_PROPERTY(metternich::character* player_character READ get_player_character NOTIFY player_character_changed)
 
+	friend class game_snapshot;
+
 public:
+	using order_function = small_function<void()>;
+
+	static constexpr size_t order_queue_capacity = 1024;
+
 	game();
 
-	void start(const timeline *timeline, const QDateTime &start_date);
+	void start(const timeline *timeline, const QDateTime &start_date, const bool headless = false);
+	void load(const std::filesystem::path &filepath, const bool headless = false);
+	void save(const std::filesystem::path &filepath) const;
 
 	void stop() {
 		this->should_stop = true;
@@ -67,11 +83,36 @@ public:
 		emit paused_changed();
 	}
 
+	game_speed get_speed() const
+	{
+		return this->speed;
+	}
+
+	void set_speed(const game_speed speed)
+	{
+		this->speed = speed;
+	}
+
+	const metternich::tick_pacer &get_tick_pacer() const
+	{
+		return this->tick_pacer;
+	}
+
+	metternich::construction_scheduler &get_construction_scheduler()
+	{
+		return this->construction_scheduler;
+	}
+
 	void set_tick_period(const tick_period tick_period)
 	{
 		this->tick_period = tick_period;
 	}
 
+	unsigned long long get_total_ticks() const
+	{
+		return this->total_ticks;
+	}
+
 	const QDateTime &get_current_date() const
 	{
 		return this->current_date;
@@ -86,34 +127,78 @@ public:
 
 	void set_player_character(character *character);
 
-	void post_order(const std::function<void()> &function)
+	/**
+	**	@brief	Post an order to be executed by the game loop thread; can be called from any thread
+	**
+	**	@param	description	A description of the order, recorded in the order log if it is enabled
+	**	@param	function	The order's function
+	**
+	**	Orders posted from the game loop thread itself are kept in an unbounded list instead of the queue, as the game loop thread is the queue's only consumer, and as such would never be able to make room in it if it were full.
+	*/
+	void post_order(std::string &&description, order_function &&function)
 	{
-		std::unique_lock<std::shared_mutex> lock(this->mutex);
-		this->orders.push(function);
+		queued_order order;
+		order.description = std::move(description);
+		order.function = std::move(function);
+
+		if (this->is_order_latency_tracked()) {
+			order.post_time = std::chrono::steady_clock::now();
+		}
+
+		if (std::this_thread::get_id() == this->game_loop_thread_id.load(std::memory_order_relaxed)) {
+			this->game_loop_orders.push_back(std::move(order));
+			return;
+		}
+
+		this->orders.push(std::move(order));
 	}
 
-	void do_orders()
+	void do_orders();
+
+	bool is_order_log_enabled() const
 	{
-		std::function<void()> order;
-		while ((order = this->get_next_order())) {
-			order();
-		}
+		return this->order_log_enabled;
 	}
 
-private:
-	std::function<void()> get_next_order()
+	//set whether the descriptions of executed orders are recorded; must be set while the game loop is not running
+	void set_order_log_enabled(const bool enabled)
 	{
-		std::shared_lock<std::shared_mutex> lock(this->mutex);
+		this->order_log_enabled = enabled;
+	}
 
-		if (this->orders.empty()) {
-			return std::function<void()>();
-		}
+	//get the descriptions of the orders executed since the last call, in execution order
+	std::vector<std::string> take_order_log()
+	{
+		return std::move(this->order_log);
+	}
 
-		std::function<void()> order = std::move(this->orders.front());
-		this->orders.pop();
-		return order;
+	bool is_order_latency_tracked() const
+	{
+		return this->order_latency_tracked.load(std::memory_order_relaxed);
+	}
+
+	void set_order_latency_tracked(const bool tracked)
+	{
+		this->order_latency_tracked = tracked;
+	}
+
+	//the latency between an order being posted and it being executed, only recorded if order latency tracking is enabled
+	const duration_histogram &get_order_latency_histogram() const
+	{
+		return this->order_latency_histogram;
 	}
 
+private:
+	struct queued_order
+	{
+		std::string description;
+		order_function function;
+		std::chrono::steady_clock::time_point post_time; //only set if order latency tracking was enabled when the order was posted
+	};
+
+	void execute_order(queued_order &&order);
+	void begin_running();
+	void calculate_realm_statistics();
 	void generate_missing_title_holders();
 	void purge_superfluous_characters();
 	void amalgamate_map_inactive_worlds();
@@ -121,6 +206,8 @@ private:
 	template <typename type, bool do_day = true>
 	void do_day_for_type(const size_t days_in_month, const size_t days_in_year, const size_t current_day, const size_t current_year_day)
 	{
+		TRACE_SCOPE(type::class_identifier);
+
 		const std::vector<type *> &instances = type::get_all_active();
 
 		for (size_t i = (current_year_day - 1); i < instances.size(); i += days_in_year) {
@@ -168,12 +255,19 @@ private:
 	bool paused = false;
 	std::atomic<bool> should_stop = false;
 	QDateTime current_date;
-	game_speed speed;
+	std::atomic<game_speed> speed;
 	character *player_character = nullptr;
 	unsigned long long total_ticks = 0; //the total amount of ticks which have passed in the game
 	tick_period tick_period;
-	std::queue<std::function<void()>> orders; //orders given by the player, received from the UI thread
-	mutable std::shared_mutex mutex;
+	metternich::tick_pacer tick_pacer;
+	metternich::construction_scheduler construction_scheduler;
+	mpsc_queue<queued_order, order_queue_capacity> orders; //orders given by the player, received from the UI thread
+	std::vector<queued_order> game_loop_orders; //orders posted by the game loop thread itself, only touched by it
+	std::atomic<std::thread::id> game_loop_thread_id; //the thread running the game's ticks, which consumes the orders
+	std::atomic<bool> order_latency_tracked = false;
+	duration_histogram order_latency_histogram;
+	bool order_log_enabled = false;
+	std::vector<std::string> order_log; //the descriptions of executed orders, if the order log is enabled
 };
 
 }
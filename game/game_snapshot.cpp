@@ -0,0 +1,835 @@
+#include "game/game_snapshot.h"
+
+#include "character/character.h"
+#include "character/dynasty.h"
+#include "character/item.h"
+#include "character/trait.h"
+#include "culture/culture.h"
+#include "database/database.h"
+#include "economy/commodity.h"
+#include "economy/employment.h"
+#include "economy/trade_node.h"
+#include "game/game.h"
+#include "history/history.h"
+#include "history/timeline.h"
+#include "holding/building.h"
+#include "holding/building_slot.h"
+#include "holding/holding.h"
+#include "holding/holding_slot.h"
+#include "holding/holding_type.h"
+#include "landed_title/landed_title.h"
+#include "map/province.h"
+#include "map/world.h"
+#include "politics/law.h"
+#include "politics/law_group.h"
+#include "population/population_type.h"
+#include "population/population_unit.h"
+#include "religion/religion.h"
+#include "script/flag/scoped_flag.h"
+#include "species/phenotype.h"
+#include "species/species.h"
+#include "species/wildlife_unit.h"
+#include "technology/technology.h"
+#include "util/qunique_ptr.h"
+#include "util/random.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace metternich {
+
+constexpr uint32_t game_tag = game_snapshot::make_tag("GAME");
+constexpr uint32_t random_tag = game_snapshot::make_tag("RAND");
+constexpr uint32_t reference_tables_tag = game_snapshot::make_tag("REFS");
+constexpr uint32_t dynasties_tag = game_snapshot::make_tag("DYNS");
+constexpr uint32_t characters_tag = game_snapshot::make_tag("CHAR");
+constexpr uint32_t landed_titles_tag = game_snapshot::make_tag("TITL");
+constexpr uint32_t holdings_tag = game_snapshot::make_tag("HOLD");
+constexpr uint32_t territories_tag = game_snapshot::make_tag("TERR");
+constexpr uint32_t wildlife_units_tag = game_snapshot::make_tag("WILD");
+constexpr uint32_t technology_progress_tag = game_snapshot::make_tag("TPRG");
+
+constexpr int64_t invalid_date = std::numeric_limits<int64_t>::min();
+
+template <typename T>
+static void write_reference(binary_writer &writer, const T *instance)
+{
+	writer.write<uint32_t>(instance != nullptr ? static_cast<uint32_t>(instance->get_index()) : game_snapshot::null_index);
+}
+
+template <typename container_type>
+static void write_references(binary_writer &writer, const container_type &container)
+{
+	writer.write<uint32_t>(static_cast<uint32_t>(container.size()));
+	for (const auto *instance : container) {
+		write_reference(writer, instance);
+	}
+}
+
+//write the identifiers of a data type's instances by their index, so that references to them can be stored as indices
+template <typename T>
+static void write_identifier_table(binary_writer &writer)
+{
+	const size_t count = T::get_index_count();
+	writer.write<uint32_t>(static_cast<uint32_t>(count));
+
+	for (size_t i = 0; i < count; ++i) {
+		const T *instance = T::get_by_index(i);
+		writer.write_string(instance != nullptr ? std::string_view(instance->get_identifier()) : std::string_view());
+	}
+}
+
+static void write_date(binary_writer &writer, const QDateTime &date)
+{
+	writer.write<int64_t>(date.isValid() ? date.toMSecsSinceEpoch() : invalid_date);
+}
+
+static QDateTime read_date(binary_reader &reader)
+{
+	const int64_t msecs = reader.read<int64_t>();
+	if (msecs == invalid_date) {
+		return QDateTime();
+	}
+
+	return QDateTime::fromMSecsSinceEpoch(msecs, Qt::UTC);
+}
+
+/**
+**	@brief	Save the game's current state to a file
+**
+**	@param	filepath	The path of the file
+*/
+void game_snapshot::save(const std::filesystem::path &filepath)
+{
+	std::ofstream ofstream(filepath, std::ios::binary | std::ios::trunc);
+
+	if (!ofstream) {
+		throw std::runtime_error("Failed to open file \"" + filepath.string() + "\" for writing a game snapshot.");
+	}
+
+	binary_writer writer(ofstream);
+	writer.write<uint32_t>(game_snapshot::magic);
+	writer.write<uint32_t>(game_snapshot::byte_order_mark);
+	writer.write<uint32_t>(game_snapshot::version);
+
+	this->write_game(writer);
+	this->write_reference_tables(writer);
+	this->write_dynasties(writer);
+	this->write_characters(writer);
+	this->write_landed_titles(writer);
+	this->write_holdings(writer);
+	this->write_territories(writer);
+	this->write_wildlife_units(writer);
+	this->write_technology_progress(writer);
+}
+
+/**
+**	@brief	Load the game's state from a file, replacing the loading of history
+**
+**	@param	filepath	The path of the file
+*/
+void game_snapshot::load(const std::filesystem::path &filepath)
+{
+	std::ifstream ifstream(filepath, std::ios::binary);
+
+	if (!ifstream) {
+		throw std::runtime_error("Failed to open game snapshot file \"" + filepath.string() + "\".");
+	}
+
+	binary_reader reader(ifstream);
+
+	if (reader.read<uint32_t>() != game_snapshot::magic) {
+		throw std::runtime_error("File \"" + filepath.string() + "\" is not a game snapshot.");
+	}
+
+	if (reader.read<uint32_t>() != game_snapshot::byte_order_mark) {
+		throw std::runtime_error("Game snapshot \"" + filepath.string() + "\" was saved with a different byte order.");
+	}
+
+	const uint32_t snapshot_version = reader.read<uint32_t>();
+	//snapshots of other versions are rejected, as their sections have a different layout, e.g. version 1 snapshots lack the random seed
+	if (snapshot_version != game_snapshot::version) {
+		throw std::runtime_error("Game snapshot \"" + filepath.string() + "\" has version " + std::to_string(snapshot_version) + ", but only version " + std::to_string(game_snapshot::version) + " is supported.");
+	}
+
+	while (!reader.is_at_end()) {
+		const binary_reader::section_header section = reader.read_section_header();
+		const size_t section_end_pos = reader.get_pos() + section.length;
+
+		switch (section.tag) {
+			case game_tag:
+				this->read_game(reader);
+				break;
+			case random_tag:
+				random::set_state(std::string(reader.read_string()));
+				break;
+			case reference_tables_tag:
+				this->read_reference_tables(reader);
+				break;
+			case dynasties_tag:
+				this->read_dynasties(reader);
+				break;
+			case characters_tag:
+				this->read_characters(reader);
+				break;
+			case landed_titles_tag:
+				this->read_landed_titles(reader);
+				break;
+			case holdings_tag:
+				this->read_holdings(reader);
+				break;
+			case territories_tag:
+				this->read_territories(reader);
+				break;
+			case wildlife_units_tag:
+				this->read_wildlife_units(reader);
+				break;
+			case technology_progress_tag:
+				this->read_technology_progress(reader);
+				break;
+			default:
+				//skip sections unknown to this version
+				reader.skip(section.length);
+				break;
+		}
+
+		if (reader.get_pos() != section_end_pos) {
+			throw std::runtime_error("A section of game snapshot \"" + filepath.string() + "\" has a different length than the one read.");
+		}
+	}
+
+	//recalculate derived state, as it would be after loading history
+	database::get()->initialize_history();
+
+	for (const auto &[province, trade_node] : this->province_trade_nodes) {
+		province->set_trade_node(trade_node);
+	}
+
+	game::get()->set_player_character(!this->player_character_identifier.empty() ? character::get(this->player_character_identifier) : nullptr);
+}
+
+void game_snapshot::write_game(binary_writer &writer) const
+{
+	const game *game = game::get();
+	const timeline *timeline = history::get()->get_timeline();
+
+	writer.begin_section(game_tag);
+	writer.write_string(timeline != nullptr ? timeline->get_identifier() : std::string());
+	write_date(writer, history::get()->get_start_date());
+	write_date(writer, game->get_current_date());
+	writer.write<uint64_t>(game->total_ticks);
+	writer.write_string(game->get_player_character() != nullptr ? game->get_player_character()->get_identifier() : std::string());
+	writer.end_section();
+
+	writer.begin_section(random_tag);
+	writer.write_string(random::get_state());
+	writer.end_section();
+}
+
+void game_snapshot::read_game(binary_reader &reader)
+{
+	game *game = game::get();
+
+	const std::string_view timeline_identifier = reader.read_string();
+	history::get()->set_timeline(!timeline_identifier.empty() ? timeline::get(timeline_identifier) : nullptr);
+	history::get()->set_start_date(read_date(reader));
+	game->current_date = read_date(reader);
+	emit game->current_date_changed();
+	game->total_ticks = reader.read<uint64_t>();
+	this->player_character_identifier = reader.read_string();
+}
+
+void game_snapshot::write_reference_tables(binary_writer &writer) const
+{
+	writer.begin_section(reference_tables_tag);
+	write_identifier_table<building>(writer);
+	write_identifier_table<commodity>(writer);
+	write_identifier_table<culture>(writer);
+	write_identifier_table<holding_slot>(writer);
+	write_identifier_table<holding_type>(writer);
+	write_identifier_table<item>(writer);
+	write_identifier_table<landed_title>(writer);
+	write_identifier_table<law>(writer);
+	write_identifier_table<phenotype>(writer);
+	write_identifier_table<population_type>(writer);
+	write_identifier_table<province>(writer);
+	write_identifier_table<religion>(writer);
+	write_identifier_table<species>(writer);
+	write_identifier_table<technology>(writer);
+	write_identifier_table<trade_node>(writer);
+	write_identifier_table<trait>(writer);
+	write_identifier_table<world>(writer);
+	writer.end_section();
+}
+
+void game_snapshot::read_reference_tables(binary_reader &reader)
+{
+	this->building_table.read(reader);
+	this->commodity_table.read(reader);
+	this->culture_table.read(reader);
+	this->holding_slot_table.read(reader);
+	this->holding_type_table.read(reader);
+	this->item_table.read(reader);
+	this->landed_title_table.read(reader);
+	this->law_table.read(reader);
+	this->phenotype_table.read(reader);
+	this->population_type_table.read(reader);
+	this->province_table.read(reader);
+	this->religion_table.read(reader);
+	this->species_table.read(reader);
+	this->technology_table.read(reader);
+	this->trade_node_table.read(reader);
+	this->trait_table.read(reader);
+	this->world_table.read(reader);
+}
+
+void game_snapshot::write_dynasties(binary_writer &writer) const
+{
+	writer.begin_section(dynasties_tag);
+
+	//dynasties generated during the game are created on load, so their definitions are written along with the identifiers
+	write_identifier_table<dynasty>(writer);
+	for (size_t i = 0; i < dynasty::get_index_count(); ++i) {
+		const dynasty *dynasty = dynasty::get_by_index(i);
+		if (dynasty == nullptr) {
+			continue;
+		}
+
+		writer.write_string(dynasty->get_name());
+		write_reference(writer, dynasty->get_culture());
+	}
+
+	writer.end_section();
+}
+
+void game_snapshot::read_dynasties(binary_reader &reader)
+{
+	const std::vector<dynasty *> created_dynasties = this->dynasty_table.read(reader, true);
+
+	for (uint32_t i = 0; i < this->dynasty_table.get_count(); ++i) {
+		dynasty *dynasty = this->dynasty_table.get(i);
+		if (dynasty == nullptr) {
+			continue;
+		}
+
+		const std::string_view name = reader.read_string();
+		culture *culture = this->read_reference(reader, this->culture_table);
+
+		if (std::find(created_dynasties.begin(), created_dynasties.end(), dynasty) != created_dynasties.end()) {
+			dynasty->set_name(std::string(name));
+			dynasty->set_culture(culture);
+		}
+	}
+}
+
+void game_snapshot::write_characters(binary_writer &writer) const
+{
+	writer.begin_section(characters_tag);
+
+	write_identifier_table<character>(writer);
+
+	const std::vector<character *> &characters = character::get_all();
+	writer.write<uint32_t>(static_cast<uint32_t>(characters.size()));
+
+	for (const character *character : characters) {
+		write_reference(writer, character);
+		writer.write_string(character->name);
+		writer.write<uint8_t>(character->alive);
+		writer.write<uint8_t>(character->female);
+		write_reference(writer, character->dynasty);
+		write_reference(writer, character->culture);
+		write_reference(writer, character->religion);
+		write_reference(writer, character->phenotype);
+		write_reference(writer, character->father);
+		write_reference(writer, character->mother);
+		write_reference(writer, character->spouse);
+		write_reference(writer, character->liege);
+		write_reference(writer, character->primary_title);
+		write_date(writer, character->birth_date);
+		write_date(writer, character->death_date);
+		write_references(writer, character->traits);
+		write_references(writer, character->items);
+		writer.write<int32_t>(character->prowess);
+		writer.write<int32_t>(character->wealth);
+
+		writer.write<uint32_t>(static_cast<uint32_t>(character->stored_commodities.size()));
+		for (const auto &[commodity, quantity] : character->stored_commodities) {
+			write_reference(writer, commodity);
+			writer.write<int32_t>(quantity);
+		}
+
+		writer.write<uint32_t>(static_cast<uint32_t>(character->flags.size()));
+		for (const scoped_flag<metternich::character> *flag : character->flags) {
+			writer.write_string(flag->get_identifier());
+		}
+	}
+
+	writer.end_section();
+}
+
+void game_snapshot::read_characters(binary_reader &reader)
+{
+	this->character_table.read(reader, true);
+
+	const uint32_t count = reader.read<uint32_t>();
+
+	for (uint32_t i = 0; i < count; ++i) {
+		character *character = this->read_reference(reader, this->character_table);
+		character->set_name(std::string(reader.read_string()));
+		character->set_alive(reader.read<uint8_t>() != 0);
+		character->female = reader.read<uint8_t>() != 0;
+		character->set_dynasty(this->read_reference(reader, this->dynasty_table));
+		character->set_culture(this->read_reference(reader, this->culture_table));
+		character->religion = this->read_reference(reader, this->religion_table);
+		character->phenotype = this->read_reference(reader, this->phenotype_table);
+
+		metternich::character *father = this->read_reference(reader, this->character_table);
+		if (father != nullptr) {
+			character->set_father(father);
+		}
+
+		metternich::character *mother = this->read_reference(reader, this->character_table);
+		if (mother != nullptr) {
+			character->set_mother(mother);
+		}
+
+		metternich::character *spouse = this->read_reference(reader, this->character_table);
+		if (spouse != nullptr) {
+			character->set_spouse(spouse);
+		}
+
+		character->set_liege(this->read_reference(reader, this->character_table));
+
+		landed_title *primary_title = this->read_reference(reader, this->landed_title_table);
+		if (primary_title != nullptr) {
+			this->primary_titles.emplace_back(character, primary_title);
+		}
+
+		character->birth_date = read_date(reader);
+		character->death_date = read_date(reader);
+
+		const uint32_t trait_count = reader.read<uint32_t>();
+		for (uint32_t j = 0; j < trait_count; ++j) {
+			character->add_trait(this->read_reference(reader, this->trait_table));
+		}
+
+		const uint32_t item_count = reader.read<uint32_t>();
+		for (uint32_t j = 0; j < item_count; ++j) {
+			character->add_item(this->read_reference(reader, this->item_table));
+		}
+
+		//set after adding traits, as the saved values already include trait modifiers
+		character->set_prowess(reader.read<int32_t>());
+		character->set_wealth(reader.read<int32_t>());
+
+		const uint32_t stored_commodity_count = reader.read<uint32_t>();
+		for (uint32_t j = 0; j < stored_commodity_count; ++j) {
+			const commodity *commodity = this->read_reference(reader, this->commodity_table);
+			character->stored_commodities[commodity] = reader.read<int32_t>();
+		}
+
+		const uint32_t flag_count = reader.read<uint32_t>();
+		for (uint32_t j = 0; j < flag_count; ++j) {
+			const std::string_view flag_identifier = reader.read_string();
+			const scoped_flag<metternich::character> *flag = scoped_flag<metternich::character>::try_get(flag_identifier);
+			if (flag == nullptr) {
+				flag = scoped_flag<metternich::character>::add(std::string(flag_identifier));
+			}
+			character->add_flag(flag);
+		}
+	}
+}
+
+void game_snapshot::write_landed_titles(binary_writer &writer) const
+{
+	writer.begin_section(landed_titles_tag);
+
+	//titles are written from the highest tier downwards, so that on load the holders of lower tier titles are restored after any changes propagated to them from higher tier ones
+	std::vector<landed_title *> landed_titles = landed_title::get_all();
+	std::stable_sort(landed_titles.begin(), landed_titles.end(), [](const landed_title *a, const landed_title *b) {
+		return a->get_tier() > b->get_tier();
+	});
+
+	writer.write<uint32_t>(static_cast<uint32_t>(landed_titles.size()));
+
+	for (const landed_title *landed_title : landed_titles) {
+		write_reference(writer, landed_title);
+		write_reference(writer, landed_title->get_holder());
+
+		std::vector<const law *> title_laws;
+		for (law_group *law_group : law_group::get_all()) {
+			const law *law = landed_title->get_law(law_group);
+			if (law != nullptr) {
+				title_laws.push_back(law);
+			}
+		}
+		write_references(writer, title_laws);
+	}
+
+	writer.end_section();
+}
+
+void game_snapshot::read_landed_titles(binary_reader &reader)
+{
+	const uint32_t count = reader.read<uint32_t>();
+
+	std::vector<std::pair<landed_title *, std::vector<law *>>> title_laws;
+	title_laws.reserve(count);
+
+	for (uint32_t i = 0; i < count; ++i) {
+		landed_title *landed_title = this->read_reference(reader, this->landed_title_table);
+		landed_title->set_holder(this->read_reference(reader, this->character_table));
+
+		std::vector<law *> laws;
+		const uint32_t law_count = reader.read<uint32_t>();
+		for (uint32_t j = 0; j < law_count; ++j) {
+			laws.push_back(this->read_reference(reader, this->law_table));
+		}
+		title_laws.emplace_back(landed_title, std::move(laws));
+	}
+
+	//restore primary titles and laws only after all holders have been set, since changing the holder or primary title of a title changes its laws
+	for (const auto &[character, primary_title] : this->primary_titles) {
+		character->set_primary_title(primary_title);
+	}
+
+	for (const auto &[landed_title, laws] : title_laws) {
+		for (law *law : laws) {
+			landed_title->add_law(law);
+		}
+	}
+}
+
+void game_snapshot::write_holdings(binary_writer &writer) const
+{
+	writer.begin_section(holdings_tag);
+
+	std::vector<const holding *> holdings;
+	for (const holding_slot *holding_slot : holding_slot::get_all()) {
+		if (holding_slot->get_holding() != nullptr) {
+			holdings.push_back(holding_slot->get_holding());
+		}
+	}
+
+	writer.write<uint32_t>(static_cast<uint32_t>(holdings.size()));
+
+	std::vector<uint32_t> type_column;
+	std::vector<uint32_t> culture_column;
+	std::vector<uint32_t> religion_column;
+	std::vector<uint32_t> phenotype_column;
+	std::vector<int32_t> size_column;
+	std::vector<int32_t> wealth_column;
+	std::map<const population_unit *, uint32_t> population_unit_indices;
+
+	const auto get_index = [](const auto *instance) {
+		return instance != nullptr ? static_cast<uint32_t>(instance->get_index()) : game_snapshot::null_index;
+	};
+
+	for (const holding *holding : holdings) {
+		write_reference(writer, holding->get_slot());
+		write_reference(writer, holding->get_type());
+		write_reference(writer, holding->get_owner());
+		write_reference(writer, holding->get_culture());
+		write_reference(writer, holding->get_religion());
+		write_reference(writer, holding->get_commodity());
+		write_references(writer, holding->get_buildings());
+		write_reference(writer, holding->get_under_construction_building());
+		writer.write<int32_t>(holding->get_construction_days());
+
+		//write the population units column by column
+		type_column.clear();
+		culture_column.clear();
+		religion_column.clear();
+		phenotype_column.clear();
+		size_column.clear();
+		wealth_column.clear();
+		population_unit_indices.clear();
+
+		for (const qunique_ptr<population_unit> &population_unit : holding->get_population_units()) {
+			population_unit_indices[population_unit.get()] = static_cast<uint32_t>(type_column.size());
+			type_column.push_back(get_index(population_unit->get_type()));
+			culture_column.push_back(get_index(population_unit->get_culture()));
+			religion_column.push_back(get_index(population_unit->get_religion()));
+			phenotype_column.push_back(get_index(population_unit->get_phenotype()));
+			size_column.push_back(population_unit->get_size());
+			wealth_column.push_back(population_unit->get_wealth());
+		}
+
+		writer.write_vector(type_column);
+		writer.write_vector(culture_column);
+		writer.write_vector(religion_column);
+		writer.write_vector(phenotype_column);
+		writer.write_vector(size_column);
+		writer.write_vector(wealth_column);
+
+		writer.write<uint32_t>(static_cast<uint32_t>(holding->get_employments().size()));
+		for (const employment *employment : holding->get_employments()) {
+			write_reference(writer, employment->get_building_slot()->get_building());
+
+			writer.write<uint32_t>(static_cast<uint32_t>(employment->get_employee_sizes().size()));
+			for (const auto &[employee, employee_size] : employment->get_employee_sizes()) {
+				writer.write<uint32_t>(population_unit_indices.at(employee));
+				writer.write<int32_t>(employee_size);
+			}
+		}
+	}
+
+	writer.end_section();
+}
+
+void game_snapshot::read_holdings(binary_reader &reader)
+{
+	const uint32_t count = reader.read<uint32_t>();
+
+	std::vector<population_unit *> population_units;
+
+	for (uint32_t i = 0; i < count; ++i) {
+		holding_slot *holding_slot = this->read_reference(reader, this->holding_slot_table);
+		holding_type *holding_type = this->read_reference(reader, this->holding_type_table);
+
+		if (holding_slot->get_holding() == nullptr) {
+			holding_slot->get_territory()->create_holding(holding_slot, holding_type);
+		} else {
+			holding_slot->get_holding()->set_type(holding_type);
+		}
+
+		holding *holding = holding_slot->get_holding();
+		holding->set_owner(this->read_reference(reader, this->character_table));
+		holding->set_culture(this->read_reference(reader, this->culture_table));
+		holding->set_religion(this->read_reference(reader, this->religion_table));
+		holding->set_commodity(this->read_reference(reader, this->commodity_table));
+
+		const uint32_t building_count = reader.read<uint32_t>();
+		for (uint32_t j = 0; j < building_count; ++j) {
+			holding->add_building(this->read_reference(reader, this->building_table));
+		}
+
+		holding->set_under_construction_building(this->read_reference(reader, this->building_table));
+		holding->set_construction_days(reader.read<int32_t>());
+
+		const std::vector<uint32_t> type_column = reader.read_vector<uint32_t>();
+		const std::vector<uint32_t> culture_column = reader.read_vector<uint32_t>();
+		const std::vector<uint32_t> religion_column = reader.read_vector<uint32_t>();
+		const std::vector<uint32_t> phenotype_column = reader.read_vector<uint32_t>();
+		const std::vector<int32_t> size_column = reader.read_vector<int32_t>();
+		const std::vector<int32_t> wealth_column = reader.read_vector<int32_t>();
+
+		const size_t population_unit_count = type_column.size();
+		if (culture_column.size() != population_unit_count || religion_column.size() != population_unit_count || phenotype_column.size() != population_unit_count || size_column.size() != population_unit_count || wealth_column.size() != population_unit_count) {
+			throw std::runtime_error("The population unit columns of holding \"" + holding_slot->get_identifier() + "\" in the game snapshot have different sizes.");
+		}
+
+		population_units.clear();
+		for (size_t j = 0; j < population_unit_count; ++j) {
+			population_unit *population_unit = holding->create_population_unit(this->population_type_table.get(type_column[j]), this->culture_table.get(culture_column[j]), this->religion_table.get(religion_column[j]), this->phenotype_table.get(phenotype_column[j]), size_column[j]);
+			population_unit->set_wealth(wealth_column[j]);
+			population_units.push_back(population_unit);
+		}
+
+		const uint32_t employment_count = reader.read<uint32_t>();
+		for (uint32_t j = 0; j < employment_count; ++j) {
+			const building *building = this->read_reference(reader, this->building_table);
+			const auto find_iterator = std::find_if(holding->get_employments().begin(), holding->get_employments().end(), [building](const employment *employment) {
+				return employment->get_building_slot()->get_building() == building;
+			});
+
+			if (find_iterator == holding->get_employments().end()) {
+				throw std::runtime_error("The game snapshot has an employment for building \"" + building->get_identifier() + "\" in holding \"" + holding_slot->get_identifier() + "\", but the holding has no such employment.");
+			}
+
+			employment *employment = *find_iterator;
+
+			const uint32_t employee_count = reader.read<uint32_t>();
+			for (uint32_t k = 0; k < employee_count; ++k) {
+				const uint32_t population_unit_index = reader.read<uint32_t>();
+				const int employee_size = reader.read<int32_t>();
+
+				if (population_unit_index >= population_units.size()) {
+					throw std::runtime_error("Invalid population unit index in the game snapshot for holding \"" + holding_slot->get_identifier() + "\".");
+				}
+
+				population_unit *employee = population_units[population_unit_index];
+				employment->set_employee_size(employee, employee_size);
+				employee->change_unemployed_size(-employee_size);
+			}
+		}
+	}
+}
+
+void game_snapshot::write_territories(binary_writer &writer) const
+{
+	writer.begin_section(territories_tag);
+
+	const std::vector<province *> &provinces = province::get_all();
+	writer.write<uint32_t>(static_cast<uint32_t>(provinces.size()));
+	for (const province *province : provinces) {
+		write_reference(writer, province);
+		this->write_territory_data(writer, province);
+		write_reference(writer, province->get_trade_node());
+	}
+
+	const std::vector<world *> &worlds = world::get_all();
+	writer.write<uint32_t>(static_cast<uint32_t>(worlds.size()));
+	for (const world *world : worlds) {
+		write_reference(writer, world);
+		this->write_territory_data(writer, world);
+	}
+
+	writer.end_section();
+}
+
+void game_snapshot::read_territories(binary_reader &reader)
+{
+	const uint32_t province_count = reader.read<uint32_t>();
+	for (uint32_t i = 0; i < province_count; ++i) {
+		province *province = this->read_reference(reader, this->province_table);
+		this->read_territory_data(reader, province);
+		this->province_trade_nodes.emplace_back(province, this->read_reference(reader, this->trade_node_table));
+	}
+
+	const uint32_t world_count = reader.read<uint32_t>();
+	for (uint32_t i = 0; i < world_count; ++i) {
+		world *world = this->read_reference(reader, this->world_table);
+		this->read_territory_data(reader, world);
+	}
+}
+
+void game_snapshot::write_territory_data(binary_writer &writer, const territory *territory) const
+{
+	write_reference(writer, territory->get_culture());
+	write_reference(writer, territory->get_religion());
+	write_references(writer, territory->get_technologies());
+	write_reference(writer, territory->get_capital_holding_slot());
+}
+
+void game_snapshot::read_territory_data(binary_reader &reader, territory *territory)
+{
+	culture *culture = this->read_reference(reader, this->culture_table);
+	if (culture != nullptr) {
+		territory->set_culture(culture);
+	}
+
+	religion *religion = this->read_reference(reader, this->religion_table);
+	if (religion != nullptr) {
+		territory->set_religion(religion);
+	}
+
+	const uint32_t technology_count = reader.read<uint32_t>();
+	for (uint32_t i = 0; i < technology_count; ++i) {
+		territory->add_technology(this->read_reference(reader, this->technology_table));
+	}
+
+	//set after the holdings have been created, since creating a settlement holding makes it the capital if there is none
+	territory->set_capital_holding_slot(this->read_reference(reader, this->holding_slot_table));
+}
+
+void game_snapshot::write_wildlife_units(binary_writer &writer) const
+{
+	writer.begin_section(wildlife_units_tag);
+
+	std::vector<const province *> provinces;
+	for (const province *province : province::get_all()) {
+		if (!province->get_wildlife_units().empty()) {
+			provinces.push_back(province);
+		}
+	}
+
+	writer.write<uint32_t>(static_cast<uint32_t>(provinces.size()));
+
+	std::vector<uint32_t> species_column;
+	std::vector<int32_t> size_column;
+
+	for (const province *province : provinces) {
+		write_reference(writer, province);
+
+		species_column.clear();
+		size_column.clear();
+
+		for (const qunique_ptr<wildlife_unit> &wildlife_unit : province->get_wildlife_units()) {
+			species_column.push_back(static_cast<uint32_t>(wildlife_unit->get_species()->get_index()));
+			size_column.push_back(wildlife_unit->get_size());
+		}
+
+		writer.write_vector(species_column);
+		writer.write_vector(size_column);
+	}
+
+	writer.end_section();
+}
+
+void game_snapshot::read_wildlife_units(binary_reader &reader)
+{
+	const uint32_t count = reader.read<uint32_t>();
+
+	for (uint32_t i = 0; i < count; ++i) {
+		province *province = this->read_reference(reader, this->province_table);
+
+		const std::vector<uint32_t> species_column = reader.read_vector<uint32_t>();
+		const std::vector<int32_t> size_column = reader.read_vector<int32_t>();
+
+		if (species_column.size() != size_column.size()) {
+			throw std::runtime_error("The wildlife unit columns of province \"" + province->get_identifier() + "\" in the game snapshot have different sizes.");
+		}
+
+		for (size_t j = 0; j < species_column.size(); ++j) {
+			auto wildlife_unit = make_qunique<metternich::wildlife_unit>(this->species_table.get(species_column[j]));
+			wildlife_unit->set_province(province);
+			wildlife_unit->set_size(size_column[j]);
+			province->add_wildlife_unit(std::move(wildlife_unit));
+		}
+	}
+}
+
+
+void game_snapshot::write_technology_progress(binary_writer &writer) const
+{
+	writer.begin_section(technology_progress_tag);
+
+	std::vector<const province *> provinces;
+	for (const province *province : province::get_all()) {
+		if (!province->get_technology_progress().empty()) {
+			provinces.push_back(province);
+		}
+	}
+
+	writer.write<uint32_t>(static_cast<uint32_t>(provinces.size()));
+
+	for (const province *province : provinces) {
+		write_reference(writer, province);
+
+		//the progress is indexed by technology index, which is the technology's index in the reference table
+		const std::vector<int> &technology_progress = province->get_technology_progress();
+		writer.write_vector(std::vector<int32_t>(technology_progress.begin(), technology_progress.end()));
+	}
+
+	writer.end_section();
+}
+
+void game_snapshot::read_technology_progress(binary_reader &reader)
+{
+	const uint32_t count = reader.read<uint32_t>();
+
+	for (uint32_t i = 0; i < count; ++i) {
+		province *province = this->read_reference(reader, this->province_table);
+
+		const std::vector<int32_t> progress_column = reader.read_vector<int32_t>();
+		if (progress_column.size() > this->technology_table.get_count()) {
+			throw std::runtime_error("The technology progress of province \"" + province->get_identifier() + "\" in the game snapshot has more entries than there are technologies.");
+		}
+
+		//the progress is indexed by technology index, which includes the indices of removed technologies
+		std::vector<int> technology_progress(technology::get_index_count(), 0);
+		for (uint32_t j = 0; j < progress_column.size(); ++j) {
+			const technology *technology = this->technology_table.get(j);
+			if (technology == nullptr) {
+				continue; //a technology which had been removed when the snapshot was saved
+			}
+
+			technology_progress[technology->get_index()] = progress_column[j];
+		}
+
+		province->set_technology_progress(std::move(technology_progress));
+	}
+}
+
+}
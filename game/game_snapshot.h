@@ -0,0 +1,168 @@
+#pragma once
+
+#include "util/binary_stream.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace metternich {
+
+class building;
+class character;
+class commodity;
+class culture;
+class dynasty;
+class holding_slot;
+class holding_type;
+class item;
+class landed_title;
+class law;
+class phenotype;
+class population_type;
+class province;
+class religion;
+class species;
+class technology;
+class territory;
+class timeline;
+class trade_node;
+class trait;
+class world;
+
+/**
+**	@brief	A snapshot of the game's runtime state, saved in a compact binary format
+**
+**	The snapshot is made of tagged sections, written incrementally to the file. References to data entries are stored as indices into identifier tables written at the start of the snapshot, so that they are resolved only once per entry on load, and the rest of the data can be read without any parsing. State which is derived from other state (e.g. modifiers, population groups) is not stored, but recalculated on load instead.
+*/
+class game_snapshot final
+{
+public:
+	static constexpr uint32_t magic = 0x4E53544D; //"MTSN"
+	static constexpr uint32_t byte_order_mark = 0x01020304;
+	static constexpr uint32_t version = 2;
+	static constexpr uint32_t null_index = std::numeric_limits<uint32_t>::max();
+
+	static constexpr uint32_t make_tag(const char (&tag)[5])
+	{
+		return static_cast<uint32_t>(tag[0]) | (static_cast<uint32_t>(tag[1]) << 8) | (static_cast<uint32_t>(tag[2]) << 16) | (static_cast<uint32_t>(tag[3]) << 24);
+	}
+
+	void save(const std::filesystem::path &filepath);
+	void load(const std::filesystem::path &filepath);
+
+private:
+	//the instances of a data type, by the indices they had when the snapshot was saved
+	template <typename T>
+	class reference_table final
+	{
+	public:
+		//read the table, returning the instances which had to be created, if creating missing instances is enabled
+		std::vector<T *> read(binary_reader &reader, const bool create_missing = false)
+		{
+			std::vector<T *> created_instances;
+
+			const uint32_t count = reader.read<uint32_t>();
+			this->instances.reserve(count);
+
+			for (uint32_t i = 0; i < count; ++i) {
+				const std::string_view identifier = reader.read_string();
+
+				if (identifier.empty()) {
+					this->instances.push_back(nullptr);
+				} else if (create_missing) {
+					T *instance = T::try_get(identifier);
+					if (instance == nullptr) {
+						instance = T::add(std::string(identifier));
+						created_instances.push_back(instance);
+					}
+					this->instances.push_back(instance);
+				} else {
+					this->instances.push_back(T::get(identifier));
+				}
+			}
+
+			return created_instances;
+		}
+
+		uint32_t get_count() const
+		{
+			return static_cast<uint32_t>(this->instances.size());
+		}
+
+		T *get(const uint32_t index) const
+		{
+			if (index == game_snapshot::null_index) {
+				return nullptr;
+			}
+
+			if (index >= this->instances.size()) {
+				throw std::runtime_error("Invalid " + std::string(T::class_identifier) + " reference index in game snapshot: " + std::to_string(index) + ".");
+			}
+
+			return this->instances[index];
+		}
+
+	private:
+		std::vector<T *> instances;
+	};
+
+	void write_game(binary_writer &writer) const;
+	void write_reference_tables(binary_writer &writer) const;
+	void write_dynasties(binary_writer &writer) const;
+	void write_characters(binary_writer &writer) const;
+	void write_landed_titles(binary_writer &writer) const;
+	void write_holdings(binary_writer &writer) const;
+	void write_territories(binary_writer &writer) const;
+	void write_wildlife_units(binary_writer &writer) const;
+	void write_technology_progress(binary_writer &writer) const;
+	void write_territory_data(binary_writer &writer, const territory *territory) const;
+
+	void read_game(binary_reader &reader);
+	void read_reference_tables(binary_reader &reader);
+	void read_dynasties(binary_reader &reader);
+	void read_characters(binary_reader &reader);
+	void read_landed_titles(binary_reader &reader);
+	void read_holdings(binary_reader &reader);
+	void read_territories(binary_reader &reader);
+	void read_wildlife_units(binary_reader &reader);
+	void read_technology_progress(binary_reader &reader);
+	void read_territory_data(binary_reader &reader, territory *territory);
+
+	template <typename T>
+	T *read_reference(binary_reader &reader, const reference_table<T> &table) const
+	{
+		return table.get(reader.read<uint32_t>());
+	}
+
+private:
+	reference_table<building> building_table;
+	reference_table<commodity> commodity_table;
+	reference_table<culture> culture_table;
+	reference_table<holding_slot> holding_slot_table;
+	reference_table<holding_type> holding_type_table;
+	reference_table<item> item_table;
+	reference_table<landed_title> landed_title_table;
+	reference_table<law> law_table;
+	reference_table<phenotype> phenotype_table;
+	reference_table<population_type> population_type_table;
+	reference_table<province> province_table;
+	reference_table<religion> religion_table;
+	reference_table<species> species_table;
+	reference_table<technology> technology_table;
+	reference_table<trade_node> trade_node_table;
+	reference_table<trait> trait_table;
+	reference_table<world> world_table;
+	reference_table<dynasty> dynasty_table;
+	reference_table<character> character_table;
+	std::string player_character_identifier;
+	std::vector<std::pair<character *, landed_title *>> primary_titles; //applied once title holders have been restored
+	std::vector<std::pair<province *, trade_node *>> province_trade_nodes; //applied after history initialization, which recalculates trade nodes
+};
+
+}
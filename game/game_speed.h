@@ -8,7 +8,8 @@ enum class game_speed
 	slow,
 	normal,
 	fast,
-	fastest
+	fastest,
+	max_throughput //unthrottled, for batch runs
 };
 
 inline game_speed string_to_game_speed(const std::string &str)
@@ -23,6 +24,8 @@ inline game_speed string_to_game_speed(const std::string &str)
 		return game_speed::fast;
 	} else if (str == "fastest") {
 		return game_speed::fastest;
+	} else if (str == "max_throughput") {
+		return game_speed::max_throughput;
 	}
 
 	throw std::runtime_error("Invalid game speed: \"" + str + "\".");
@@ -41,6 +44,8 @@ inline std::string game_speed_to_string(const game_speed speed)
 			return "fast";
 		case game_speed::fastest:
 			return "fastest";
+		case game_speed::max_throughput:
+			return "max_throughput";
 	}
 
 	throw std::runtime_error("Invalid game speed: \"" + std::to_string(static_cast<int>(speed)) + "\".");
@@ -0,0 +1,318 @@
+#include "game/state_hash_log.h"
+
+#include "character/character.h"
+#include "culture/culture.h"
+#include "game/game.h"
+#include "game/game_snapshot.h"
+#include "holding/building.h"
+#include "holding/holding.h"
+#include "holding/holding_slot.h"
+#include "holding/holding_type.h"
+#include "landed_title/landed_title.h"
+#include "population/population_type.h"
+#include "population/population_unit.h"
+#include "religion/religion.h"
+#include "species/phenotype.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+
+namespace metternich {
+
+static constexpr uint32_t entities_tag = game_snapshot::make_tag("ENTS");
+static constexpr uint32_t tick_tag = game_snapshot::make_tag("TICK");
+
+static uint64_t mix_hash(uint64_t value)
+{
+	//the SplitMix64 finalizer
+	value ^= value >> 30;
+	value *= 0xBF58476D1CE4E5B9ULL;
+	value ^= value >> 27;
+	value *= 0x94D049BB133111EBULL;
+	value ^= value >> 31;
+	return value;
+}
+
+//a hash accumulator; values added in sequence are order-dependent, while add_unordered() is order-independent, for elements whose order is not part of the state (e.g. sets keyed by pointers)
+class state_hash final
+{
+public:
+	void add(const uint64_t value)
+	{
+		this->value = mix_hash(this->value ^ mix_hash(value + 0x9E3779B97F4A7C15ULL));
+	}
+
+	void add_unordered(const uint64_t value)
+	{
+		this->unordered_value += mix_hash(value);
+	}
+
+	template <typename T>
+	void add_reference(const T *instance)
+	{
+		this->add(instance != nullptr ? instance->get_index() + 1 : 0);
+	}
+
+	uint64_t get_value() const
+	{
+		return mix_hash(this->value ^ this->unordered_value);
+	}
+
+private:
+	uint64_t value = 0;
+	uint64_t unordered_value = 0;
+};
+
+template <typename T>
+static uint64_t get_reference_value(const T *instance)
+{
+	return instance != nullptr ? instance->get_index() + 1 : 0;
+}
+
+static uint64_t get_holding_hash(const holding *holding)
+{
+	if (holding == nullptr) {
+		return 0;
+	}
+
+	state_hash hash;
+	hash.add_reference(holding->get_type());
+	hash.add_reference(holding->get_owner());
+	hash.add_reference(holding->get_under_construction_building());
+	hash.add(static_cast<uint64_t>(holding->get_construction_days()));
+
+	for (const building *building : holding->get_buildings()) {
+		hash.add_unordered(get_reference_value(building));
+	}
+
+	for (const qunique_ptr<population_unit> &population_unit : holding->get_population_units()) {
+		state_hash population_unit_hash;
+		population_unit_hash.add_reference(population_unit->get_type());
+		population_unit_hash.add_reference(population_unit->get_culture());
+		population_unit_hash.add_reference(population_unit->get_religion());
+		population_unit_hash.add_reference(population_unit->get_phenotype());
+		population_unit_hash.add(static_cast<uint64_t>(population_unit->get_size()));
+		population_unit_hash.add(static_cast<uint64_t>(population_unit->get_wealth()));
+		population_unit_hash.add(static_cast<uint64_t>(population_unit->get_unemployed_size()));
+		hash.add_unordered(population_unit_hash.get_value());
+	}
+
+	return hash.get_value();
+}
+
+static uint64_t get_landed_title_hash(const landed_title *landed_title)
+{
+	state_hash hash;
+	hash.add_reference(landed_title->get_holder());
+
+	if (landed_title->get_holder() != nullptr) {
+		hash.add(static_cast<uint64_t>(landed_title->get_holder()->get_wealth()));
+	}
+
+	return hash.get_value();
+}
+
+static uint64_t get_characters_hash()
+{
+	state_hash hash;
+
+	for (const character *character : character::get_all_living()) {
+		if (character == nullptr) {
+			continue;
+		}
+
+		state_hash character_hash;
+		character_hash.add_reference(character);
+		character_hash.add(static_cast<uint64_t>(character->get_wealth()));
+		character_hash.add(static_cast<uint64_t>(character->get_prowess()));
+		hash.add_unordered(character_hash.get_value());
+	}
+
+	return hash.get_value();
+}
+
+/**
+**	@brief	Compare two state hash logs, writing the first divergence between them to an output stream
+**
+**	@param	filepath		The path of the first log
+**	@param	other_filepath	The path of the other log
+**	@param	output			The output stream
+**
+**	@return	True if the logs are identical, or false otherwise
+*/
+bool state_hash_log::compare(const std::filesystem::path &filepath, const std::filesystem::path &other_filepath, std::ostream &output)
+{
+	const auto open_log = [](const std::filesystem::path &filepath) {
+		std::ifstream ifstream(filepath, std::ios::binary);
+		if (!ifstream) {
+			throw std::runtime_error("Failed to open state hash log \"" + filepath.string() + "\".");
+		}
+
+		binary_reader reader(ifstream);
+		if (reader.read<uint32_t>() != state_hash_log::magic || reader.read<uint32_t>() != state_hash_log::version) {
+			throw std::runtime_error("File \"" + filepath.string() + "\" is not a state hash log of the current version.");
+		}
+
+		return reader;
+	};
+
+	const auto read_entities = [](binary_reader &reader) {
+		const binary_reader::section_header section = reader.read_section_header();
+		if (section.tag != entities_tag) {
+			throw std::runtime_error("State hash log has no entity table.");
+		}
+
+		std::vector<std::string> entities(reader.read<uint32_t>());
+		for (std::string &entity : entities) {
+			entity = reader.read_string();
+		}
+		return entities;
+	};
+
+	binary_reader reader = open_log(filepath);
+	binary_reader other_reader = open_log(other_filepath);
+
+	const std::vector<std::string> entities = read_entities(reader);
+	if (entities != read_entities(other_reader)) {
+		output << "The logs have different entities, and so cannot be compared.\n";
+		return false;
+	}
+
+	uint64_t tick_count = 0;
+
+	while (!reader.is_at_end() && !other_reader.is_at_end()) {
+		for (binary_reader *tick_reader : { &reader, &other_reader }) {
+			if (tick_reader->read_section_header().tag != tick_tag) {
+				throw std::runtime_error("Invalid section in state hash log.");
+			}
+		}
+
+		const uint64_t tick = reader.read<uint64_t>();
+		const uint64_t other_tick = other_reader.read<uint64_t>();
+		const int64_t date = reader.read<int64_t>();
+		const int64_t other_date = other_reader.read<int64_t>();
+
+		if (tick != other_tick || date != other_date) {
+			output << "The logs diverge in tick " << tick << ": the other log is at tick " << other_tick << " instead, with a different date.\n";
+			return false;
+		}
+
+		const uint32_t order_count = reader.read<uint32_t>();
+		const uint32_t other_order_count = other_reader.read<uint32_t>();
+		for (uint32_t i = 0; i < std::max(order_count, other_order_count); ++i) {
+			const std::string_view order = i < order_count ? reader.read_string() : std::string_view();
+			const std::string_view other_order = i < other_order_count ? other_reader.read_string() : std::string_view();
+
+			if (order != other_order) {
+				output << "The logs diverge in tick " << tick << ", in order " << i << ": \"" << order << "\" vs. \"" << other_order << "\".\n";
+				return false;
+			}
+		}
+
+		const uint64_t tick_hash = reader.read<uint64_t>();
+		const uint64_t other_tick_hash = other_reader.read<uint64_t>();
+		const std::vector<uint64_t> entity_hashes = reader.read_vector<uint64_t>();
+		const std::vector<uint64_t> other_entity_hashes = other_reader.read_vector<uint64_t>();
+
+		if (tick_hash != other_tick_hash) {
+			size_t diverging_entity_count = 0;
+			size_t first_diverging_entity_index = entities.size();
+
+			for (size_t i = 0; i < entities.size(); ++i) {
+				if (entity_hashes.at(i) != other_entity_hashes.at(i)) {
+					if (diverging_entity_count == 0) {
+						first_diverging_entity_index = i;
+					}
+					++diverging_entity_count;
+				}
+			}
+
+			output << "The logs diverge in tick " << tick;
+			if (first_diverging_entity_index < entities.size()) {
+				output << ", first for entity \"" << entities[first_diverging_entity_index] << "\", with " << diverging_entity_count << " entities diverging in total";
+			}
+			output << ".\n";
+			return false;
+		}
+
+		++tick_count;
+	}
+
+	if (!reader.is_at_end() || !other_reader.is_at_end()) {
+		output << "The logs are identical for " << tick_count << " ticks, but one of them has more ticks than the other.\n";
+		return false;
+	}
+
+	output << "The logs are identical for " << tick_count << " ticks.\n";
+	return true;
+}
+
+/**
+**	@brief	Create a state hash log, writing its entity table
+**
+**	@param	filepath	The path of the log file
+*/
+state_hash_log::state_hash_log(const std::filesystem::path &filepath)
+	: ofstream(filepath, std::ios::binary | std::ios::trunc), writer(this->ofstream)
+{
+	if (!this->ofstream) {
+		throw std::runtime_error("Failed to open file \"" + filepath.string() + "\" for writing a state hash log.");
+	}
+
+	this->holding_slots.assign(holding_slot::get_all().begin(), holding_slot::get_all().end());
+	this->landed_titles.assign(landed_title::get_all().begin(), landed_title::get_all().end());
+	this->entity_hashes.resize(this->holding_slots.size() + this->landed_titles.size() + 1);
+
+	this->writer.write<uint32_t>(state_hash_log::magic);
+	this->writer.write<uint32_t>(state_hash_log::version);
+
+	this->writer.begin_section(entities_tag);
+	this->writer.write<uint32_t>(static_cast<uint32_t>(this->entity_hashes.size()));
+	for (const holding_slot *holding_slot : this->holding_slots) {
+		this->writer.write_string("holding_slot " + holding_slot->get_identifier());
+	}
+	for (const landed_title *landed_title : this->landed_titles) {
+		this->writer.write_string("landed_title " + landed_title->get_identifier());
+	}
+	this->writer.write_string("characters");
+	this->writer.end_section();
+}
+
+/**
+**	@brief	Record the state hashes for the current tick, together with the orders executed since the last recorded tick
+*/
+void state_hash_log::record_tick()
+{
+	const game *game = game::get();
+
+	size_t entity_index = 0;
+	for (const holding_slot *holding_slot : this->holding_slots) {
+		this->entity_hashes[entity_index++] = get_holding_hash(holding_slot->get_holding());
+	}
+	for (const landed_title *landed_title : this->landed_titles) {
+		this->entity_hashes[entity_index++] = get_landed_title_hash(landed_title);
+	}
+	this->entity_hashes[entity_index++] = get_characters_hash();
+
+	state_hash hash;
+	for (const uint64_t entity_hash : this->entity_hashes) {
+		hash.add(entity_hash);
+	}
+
+	this->writer.begin_section(tick_tag);
+	this->writer.write<uint64_t>(game->get_total_ticks());
+	this->writer.write<int64_t>(game->get_current_date().toMSecsSinceEpoch());
+
+	const std::vector<std::string> orders = game::get()->take_order_log();
+	this->writer.write<uint32_t>(static_cast<uint32_t>(orders.size()));
+	for (const std::string &order : orders) {
+		this->writer.write_string(order);
+	}
+
+	this->writer.write<uint64_t>(hash.get_value());
+	this->writer.write_vector(this->entity_hashes);
+	this->writer.end_section();
+}
+
+}
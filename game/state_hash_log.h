@@ -0,0 +1,42 @@
+#pragma once
+
+#include "util/binary_stream.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace metternich {
+
+class holding_slot;
+class landed_title;
+
+/**
+**	@brief	A log of hashes of the game state for each tick, used to find where two runs of the simulation diverge
+**
+**	For each tick, a hash is recorded for each entity (holding slot and landed title, as well as one for all characters), together with the orders executed in the tick. Comparing the logs of two runs started with the same random seed then shows the first tick and entity for which they differ, e.g. to verify that an optimization keeps the simulation identical.
+*/
+class state_hash_log final
+{
+public:
+	static constexpr uint32_t magic = 0x4C48534D; //"MSHL"
+	static constexpr uint32_t version = 1;
+
+	static bool compare(const std::filesystem::path &filepath, const std::filesystem::path &other_filepath, std::ostream &output);
+
+	explicit state_hash_log(const std::filesystem::path &filepath);
+
+	void record_tick();
+
+private:
+	std::ofstream ofstream;
+	binary_writer writer;
+	std::vector<const holding_slot *> holding_slots;
+	std::vector<const landed_title *> landed_titles;
+	std::vector<uint64_t> entity_hashes;
+};
+
+}
@@ -0,0 +1,97 @@
+#include "game/tick_pacer.h"
+
+#include "game/game_speed.h"
+
+#include <thread>
+
+namespace metternich {
+
+std::chrono::nanoseconds tick_pacer::get_tick_duration(const game_speed speed)
+{
+	switch (speed) {
+		case game_speed::slowest:
+			return std::chrono::milliseconds(2000);
+		case game_speed::slow:
+			return std::chrono::milliseconds(1000);
+		case game_speed::normal:
+			return std::chrono::milliseconds(500);
+		case game_speed::fast:
+			return std::chrono::milliseconds(100);
+		case game_speed::fastest:
+			return std::chrono::milliseconds(1); //about as fast as possible, but leaving a bit of time for the UI thread to process its event loop
+		case game_speed::max_throughput:
+			return std::chrono::nanoseconds(0);
+	}
+
+	throw std::runtime_error("Invalid game speed: \"" + std::to_string(static_cast<int>(speed)) + "\".");
+}
+
+void tick_pacer::reset(const game_speed speed)
+{
+	this->speed = speed;
+	this->tick_budget_ns = tick_pacer::get_tick_duration(speed).count();
+	this->next_tick_time = clock::now();
+}
+
+/**
+**	@brief	Begin a wakeup of the game loop
+**
+**	@param	speed	The current game speed
+**
+**	@return	The amount of ticks to be run in this wakeup
+*/
+int tick_pacer::begin_wakeup(const game_speed speed)
+{
+	if (speed != this->speed) {
+		this->reset(speed);
+	}
+
+	const std::chrono::nanoseconds tick_duration = this->get_tick_budget();
+	const clock::time_point now = clock::now();
+
+	if (tick_duration.count() == 0) {
+		this->next_tick_time = now;
+		return 1;
+	}
+
+	int tick_count = 1;
+
+	if (now > this->next_tick_time) {
+		const long long due_ticks = 1 + (now - this->next_tick_time) / tick_duration;
+
+		if (due_ticks > tick_pacer::max_catch_up_ticks) {
+			//too far behind, so run as many ticks as allowed and drop the rest of the backlog
+			tick_count = tick_pacer::max_catch_up_ticks;
+			this->dropped_tick_count += static_cast<unsigned long long>(due_ticks - tick_pacer::max_catch_up_ticks);
+			this->next_tick_time = now + tick_duration;
+			this->catch_up_tick_count += static_cast<unsigned long long>(tick_count - 1);
+			return tick_count;
+		}
+
+		tick_count = static_cast<int>(due_ticks);
+		this->catch_up_tick_count += static_cast<unsigned long long>(tick_count - 1);
+	}
+
+	this->next_tick_time += tick_duration * tick_count;
+	return tick_count;
+}
+
+void tick_pacer::wait_for_next_tick() const
+{
+	if (this->get_tick_budget().count() == 0) {
+		std::this_thread::yield();
+		return;
+	}
+
+	//sleep until shortly before the deadline, and then yield until it is reached, for sub-millisecond precision
+	const clock::time_point sleep_end_time = this->next_tick_time - tick_pacer::spin_margin;
+	if (clock::now() < sleep_end_time) {
+		std::this_thread::sleep_until(sleep_end_time);
+	}
+
+	while (clock::now() < this->next_tick_time) {
+		std::this_thread::yield();
+	}
+}
+
+}
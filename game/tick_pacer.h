@@ -0,0 +1,65 @@
+#pragma once
+
+#include "util/duration_histogram.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace metternich {
+
+enum class game_speed;
+
+/**
+**	@brief	Paces the game loop's ticks according to the game speed
+**
+**	Tick deadlines are scheduled on an absolute steady clock timeline, so that the time spent running ticks doesn't cause drift. If the game loop falls behind, several ticks are run per wakeup to catch up, up to a limit beyond which the backlog is dropped.
+*/
+class tick_pacer final
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	static constexpr int max_catch_up_ticks = 8; //the maximum amount of ticks to be run in a single wakeup
+	static constexpr std::chrono::microseconds spin_margin = std::chrono::microseconds(500); //the time before a deadline at which to stop sleeping and start yielding instead, as sleeping is imprecise
+
+	static std::chrono::nanoseconds get_tick_duration(const game_speed speed);
+
+	void reset(const game_speed speed);
+	int begin_wakeup(const game_speed speed);
+	void wait_for_next_tick() const;
+
+	void record_tick_duration(const std::chrono::nanoseconds duration)
+	{
+		this->tick_duration_histogram.record(duration);
+	}
+
+	const duration_histogram &get_tick_duration_histogram() const
+	{
+		return this->tick_duration_histogram;
+	}
+
+	std::chrono::nanoseconds get_tick_budget() const
+	{
+		return std::chrono::nanoseconds(this->tick_budget_ns.load(std::memory_order_relaxed));
+	}
+
+	unsigned long long get_catch_up_tick_count() const
+	{
+		return this->catch_up_tick_count.load(std::memory_order_relaxed);
+	}
+
+	unsigned long long get_dropped_tick_count() const
+	{
+		return this->dropped_tick_count.load(std::memory_order_relaxed);
+	}
+
+private:
+	game_speed speed;
+	clock::time_point next_tick_time; //the time at which the next tick is due
+	duration_histogram tick_duration_histogram; //the time spent running each tick
+	std::atomic<long long> tick_budget_ns = 0; //the tick duration for the current speed
+	std::atomic<unsigned long long> catch_up_tick_count = 0; //the amount of extra ticks run to catch up
+	std::atomic<unsigned long long> dropped_tick_count = 0; //the amount of ticks skipped due to the game loop being too far behind
+};
+
+}
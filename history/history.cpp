@@ -11,162 +11,18 @@
 #include "map/province_profile.h"
 #include "map/region.h"
 #include "map/world.h"
+#include "population/population_generator.h"
 #include "population/population_unit.h"
+#include "species/wildlife_generator.h"
 #include "species/wildlife_unit.h"
 #include "util/string_util.h"
+#include "util/trace.h"
 
-namespace metternich {
-
-/**
-**	@brief	Create population units, based on population history for regions, territories and settlement holdings
-*/
-void history::generate_population_units()
-{
-	std::vector<population_unit *> base_population_units;
-
-	//add population units with discount existing enabled to the vector of population units used for generation (holding-level population units with that enabled are not used for generation per se, but generated population units may still be discounted from their size), as well as any population units in territories or regions
-	for (province *province : province::get_all()) {
-		for (holding *holding : province->get_settlement_holdings()) {
-			for (const qunique_ptr<population_unit> &population_unit : holding->get_population_units()) {
-				if (population_unit->discounts_existing()) {
-					base_population_units.push_back(population_unit.get());
-				}
-			}
-		}
-
-		for (const qunique_ptr<population_unit> &population_unit : province->get_population_units()) {
-			base_population_units.push_back(population_unit.get());
-		}
-	}
-
-	for (world *world : world::get_all()) {
-		for (holding *holding : world->get_settlement_holdings()) {
-			for (const qunique_ptr<population_unit> &population_unit : holding->get_population_units()) {
-				if (population_unit->discounts_existing()) {
-					base_population_units.push_back(population_unit.get());
-				}
-			}
-		}
-
-		for (const qunique_ptr<population_unit> &population_unit : world->get_population_units()) {
-			base_population_units.push_back(population_unit.get());
-		}
-	}
-
-	for (region *region : region::get_all()) {
-		for (const qunique_ptr<population_unit> &population_unit : region->get_population_units()) {
-			base_population_units.push_back(population_unit.get());
-		}
-	}
-
-	//sort regions so that ones with less territories are applied first
-	std::sort(base_population_units.begin(), base_population_units.end(), [](population_unit *a, population_unit *b) {
-		//give priority to population units which discount less types
-		if (a->get_discount_types().size() != b->get_discount_types().size()) {
-			return a->get_discount_types().size() < b->get_discount_types().size();
-		}
-
-		//give priority to population units located in holdings, then to territories, then to smaller regions
-		if ((a->get_holding() != nullptr) != (b->get_holding() != nullptr)) {
-			return a->get_holding() != nullptr;
-		} else if ((a->get_territory() != nullptr) != (b->get_territory() != nullptr)) {
-			return a->get_territory() != nullptr;
-		} else if (a->get_region() != b->get_region()) {
-			return a->get_region()->get_territories().size() < b->get_region()->get_territories().size();
-		}
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
-		//give priority to population units with a culture
-		if ((a->get_culture() != nullptr) != (b->get_culture() != nullptr)) {
-			return a->get_culture() != nullptr;
-		}
-
-		//give priority to population units with a religion
-		if ((a->get_religion() != nullptr) != (b->get_religion() != nullptr)) {
-			return a->get_religion() != nullptr;
-		}
-
-		//give priority to population units with a phenotype
-		if ((a->get_phenotype() != nullptr) != (b->get_phenotype() != nullptr)) {
-			return a->get_phenotype() != nullptr;
-		}
-
-		return a->get_size() < b->get_size();
-	});
-
-	for (population_unit *population_unit : base_population_units) {
-		//subtract the size of other population units for population units that have discount_existing enabled
-		if (population_unit->discounts_existing()) {
-			population_unit->subtract_existing_sizes();
-		}
-
-		//distribute territory and region population units to the settlement holdings located in them
-		if (population_unit->get_holding() == nullptr) {
-			if (population_unit->get_territory() != nullptr) {
-				population_unit->distribute_to_holdings(population_unit->get_territory()->get_settlement_holdings());
-			} else if (population_unit->get_region() != nullptr) {
-				population_unit->distribute_to_holdings(population_unit->get_region()->get_holdings());
-			}
-		}
-	}
-
-	for (population_unit *population_unit : base_population_units) {
-		if (population_unit->discounts_existing()) {
-			population_unit->set_discount_existing(false);
-		}
-	}
-}
-
-void history::generate_wildlife_units()
-{
-	std::vector<wildlife_unit *> base_wildlife_units;
-
-	//add wildlife units with discount existing enabled to the vector of wildlife units used for generation (province-level population units with that enabled are not used for generation per se, but generated wildlife units may still be discounted from their size), as well as any wildlife units in regions
-	for (province *province : province::get_all()) {
-		for (const qunique_ptr<wildlife_unit> &wildlife_unit : province->get_wildlife_units()) {
-			if (wildlife_unit->discounts_existing()) {
-				base_wildlife_units.push_back(wildlife_unit.get());
-			}
-		}
-	}
-
-	for (region *region : region::get_all()) {
-		for (const qunique_ptr<wildlife_unit> &wildlife_unit : region->get_wildlife_units()) {
-			base_wildlife_units.push_back(wildlife_unit.get());
-		}
-	}
-
-	//sort regions so that ones with less provinces are applied first
-	std::sort(base_wildlife_units.begin(), base_wildlife_units.end(), [](wildlife_unit *a, wildlife_unit *b) {
-		//give priority to population units located in provinces, then to smaller regions
-		if ((a->get_province() != nullptr) != (b->get_province() != nullptr)) {
-			return a->get_province() != nullptr;
-		} else if (a->get_region() != b->get_region()) {
-			return a->get_region()->get_provinces().size() < b->get_region()->get_provinces().size();
-		}
-
-		return a->get_size() < b->get_size();
-	});
-
-	for (wildlife_unit *wildlife_unit : base_wildlife_units) {
-		//subtract the size of other wildlife units for wildlife units that have discount_existing enabled
-		if (wildlife_unit->discounts_existing()) {
-			wildlife_unit->subtract_existing_sizes();
-		}
-
-		//distribute region wildlife units to the provinces located in them
-		if (wildlife_unit->get_province() == nullptr) {
-			if (wildlife_unit->get_region() != nullptr) {
-				wildlife_unit->distribute_to_provinces(wildlife_unit->get_region()->get_provinces());
-			}
-		}
-	}
-
-	for (wildlife_unit *wildlife_unit : base_wildlife_units) {
-		if (wildlife_unit->discounts_existing()) {
-			wildlife_unit->set_discount_existing(false);
-		}
-	}
-}
+namespace metternich {
 
 QDateTime history::string_to_date(const std::string &date_str)
 {
@@ -207,36 +63,157 @@ void history::load()
 	this->loading = true;
 	engine_interface::get()->set_loading_message("Loading History...");
 
-	region::parse_history_database();
-	province::parse_history_database();
-	province_profile::parse_history_database();
-	world::parse_history_database();
-	character::parse_history_database();
-	landed_title::parse_history_database();
-	population_unit::parse_history_database();
-	wildlife_unit::parse_history_database();
+	const std::vector<load_stage> stages = {
+		//parsing is independent for each data type
+		{ "parse_region_history", {}, region::parse_history_database, true },
+		{ "parse_province_history", {}, province::parse_history_database, true },
+		{ "parse_province_profile_history", {}, province_profile::parse_history_database, true },
+		{ "parse_world_history", {}, world::parse_history_database, true },
+		{ "parse_character_history", {}, character::parse_history_database, true },
+		{ "parse_landed_title_history", {}, landed_title::parse_history_database, true },
+		{ "parse_population_unit_history", {}, population_unit::parse_history_database, true },
+		{ "parse_wildlife_unit_history", {}, wildlife_unit::parse_history_database, true },
+
+		{ "define_character_history", { "parse_character_history" }, [] { character::process_history_database(true); } },
 
-	character::process_history_database(true);
+		{ "process_region_history", { "parse_region_history" }, [] { region::process_history_database(false); } },
+		{ "process_province_history", { "parse_province_history", "define_character_history" }, [] { province::process_history_database(false); } },
+		{ "process_province_profile_history", { "parse_province_profile_history", "process_province_history" }, [] { province_profile::process_history_database(false); } },
+		{ "process_world_history", { "parse_world_history", "define_character_history" }, [] { world::process_history_database(false); } },
+		{ "process_character_history", { "parse_character_history", "define_character_history" }, [] { character::process_history_database(false); } },
+		{ "process_landed_title_history", { "parse_landed_title_history", "define_character_history" }, [] { landed_title::process_history_database(false); } },
 
-	region::process_history_database(false);
-	province::process_history_database(false);
-	province_profile::process_history_database(false);
-	world::process_history_database(false);
-	character::process_history_database(false);
-	landed_title::process_history_database(false);
+		//process population units after the province/world history, so that holdings will have been created
+		{ "process_population_unit_history", { "parse_population_unit_history", "process_region_history", "process_province_history", "process_province_profile_history", "process_world_history" }, population_unit::process_history_database },
+		{ "process_wildlife_unit_history", { "parse_wildlife_unit_history", "process_region_history", "process_province_history", "process_province_profile_history" }, wildlife_unit::process_history_database },
 
-	//process population units after the province/world history, so that holdings will have been created
-	population_unit::process_history_database();
-	wildlife_unit::process_history_database();
+		{ "generate_population_units", { "process_population_unit_history" }, [] { population_generator().generate(); } },
+		{ "generate_wildlife_units", { "process_wildlife_unit_history" }, [] { wildlife_generator().generate(); } },
 
-	history::generate_population_units();
-	history::generate_wildlife_units();
+		{ "initialize_history", { "process_character_history", "process_landed_title_history", "generate_population_units", "generate_wildlife_units" }, [] { database::get()->initialize_history(); } },
+	};
 
-	database::get()->initialize_history();
+	this->run_load_stages(stages);
 
 	this->loading = false;
 }
 
+/**
+**	@brief	Run history load stages, each once the stages it depends on have completed
+**
+**	@param	stages	The stages
+**
+**	Concurrent stages are run in their own threads as soon as they are ready, while other stages are run in the calling thread.
+*/
+void history::run_load_stages(const std::vector<load_stage> &stages)
+{
+	std::vector<std::vector<size_t>> stage_dependency_indices(stages.size());
+
+	for (size_t i = 0; i < stages.size(); ++i) {
+		for (const char *dependency : stages[i].dependencies) {
+			const auto find_iterator = std::find_if(stages.begin(), stages.end(), [dependency](const load_stage &stage) {
+				return std::string_view(stage.name) == dependency;
+			});
+
+			if (find_iterator == stages.end()) {
+				throw std::runtime_error("History load stage \"" + std::string(stages[i].name) + "\" depends on the nonexistent \"" + dependency + "\" stage.");
+			}
+
+			stage_dependency_indices[i].push_back(static_cast<size_t>(find_iterator - stages.begin()));
+		}
+	}
+
+	this->load_stage_durations.clear();
+
+	std::mutex mutex;
+	std::condition_variable stage_completed_condition;
+	std::vector<bool> started_stages(stages.size(), false);
+	std::vector<bool> completed_stages(stages.size(), false);
+	size_t running_stage_count = 0;
+	size_t completed_stage_count = 0;
+	std::exception_ptr exception;
+	std::vector<std::thread> threads;
+
+	const auto is_stage_ready = [&](const size_t index) {
+		return std::all_of(stage_dependency_indices[index].begin(), stage_dependency_indices[index].end(), [&](const size_t dependency_index) {
+			return completed_stages[dependency_index];
+		});
+	};
+
+	const auto run_stage = [&](const size_t index) {
+		const load_stage &stage = stages[index];
+		const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+		std::exception_ptr stage_exception;
+		try {
+			TRACE_SCOPE(stage.name);
+			stage.function();
+		} catch (...) {
+			try {
+				std::throw_with_nested(std::runtime_error("Failed to run the \"" + std::string(stage.name) + "\" history load stage."));
+			} catch (...) {
+				stage_exception = std::current_exception();
+			}
+		}
+
+		const std::chrono::milliseconds duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (stage_exception != nullptr && exception == nullptr) {
+			exception = stage_exception;
+		}
+		completed_stages[index] = true;
+		running_stage_count--;
+		completed_stage_count++;
+		this->load_stage_durations.emplace_back(stage.name, duration);
+		stage_completed_condition.notify_all();
+	};
+
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while (exception == nullptr && completed_stage_count < stages.size()) {
+		for (size_t i = 0; i < stages.size(); ++i) {
+			if (stages[i].concurrent && !started_stages[i] && is_stage_ready(i)) {
+				started_stages[i] = true;
+				running_stage_count++;
+				threads.emplace_back(run_stage, i);
+			}
+		}
+
+		//non-concurrent stages are run in order, so that the next one is always the first which hasn't started yet
+		size_t next_stage_index = 0;
+		while (next_stage_index < stages.size() && (stages[next_stage_index].concurrent || started_stages[next_stage_index])) {
+			++next_stage_index;
+		}
+
+		if (next_stage_index < stages.size() && is_stage_ready(next_stage_index)) {
+			started_stages[next_stage_index] = true;
+			running_stage_count++;
+			lock.unlock();
+			run_stage(next_stage_index);
+			lock.lock();
+			continue;
+		}
+
+		if (running_stage_count == 0) {
+			exception = std::make_exception_ptr(std::runtime_error("The history load stages have circular dependencies."));
+			break;
+		}
+
+		stage_completed_condition.wait(lock);
+	}
+
+	lock.unlock();
+
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+
+	if (exception != nullptr) {
+		std::rethrow_exception(exception);
+	}
+}
+
 bool history::contains_timeline_date(const metternich::timeline *timeline, const QDateTime &date) const
 {
 	if (this->get_timeline() == timeline) {
@@ -5,7 +5,10 @@
 #include <QDateTime>
 #include <QString>
 
+#include <chrono>
+#include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace metternich {
@@ -14,10 +17,18 @@ class timeline;
 
 class history final : public singleton<history>
 {
-public:
-	static void generate_population_units();
-	static void generate_wildlife_units();
+	/**
+	**	@brief	A stage of history loading, run once the stages it depends on have completed
+	*/
+	struct load_stage final
+	{
+		const char *name = nullptr; //must be a string literal, as it is also used for tracing
+		std::vector<const char *> dependencies; //the names of the stages which must have completed before this one can run
+		std::function<void()> function;
+		bool concurrent = false; //whether the stage can run concurrently with any other stage, e.g. because it only parses data; other stages mutate shared state, and so run one at a time, in declaration order
+	};
 
+public:
 	static QDateTime string_to_date(const std::string &date_str);
 
 public:
@@ -50,10 +61,20 @@ public:
 
 	bool contains_timeline_date(const timeline *timeline, const QDateTime &date) const;
 
+	//get the durations of the stages of the last history load, in order of completion
+	const std::vector<std::pair<std::string, std::chrono::milliseconds>> &get_load_stage_durations() const
+	{
+		return this->load_stage_durations;
+	}
+
+private:
+	void run_load_stages(const std::vector<load_stage> &stages);
+
 private:
 	bool loading = false;
 	const timeline *timeline = nullptr;
 	QDateTime start_date;
+	std::vector<std::pair<std::string, std::chrono::milliseconds>> load_stage_durations;
 };
 
 }
@@ -2,7 +2,6 @@
 
 #include "holding/holding_type.h"
 #include "script/condition/and_condition.h"
-#include "script/condition/has_technology_condition.h"
 #include "technology/technology.h"
 #include "util/container_util.h"
 
@@ -31,16 +30,14 @@ void building::process_gsml_scope(const gsml_data &scope)
 
 void building::initialize()
 {
-	if (!this->get_required_technologies().empty()) {
-		if (this->preconditions == nullptr) {
-			this->preconditions = std::make_unique<and_condition<holding>>();
-		}
-
-		for (technology *required_technology : this->get_required_technologies()) {
-			auto condition = std::make_unique<has_technology_condition<holding>>(required_technology);
-			this->preconditions->add_condition(std::move(condition));
-		}
+	//the required technologies are checked with bitsets by holding types, whose results are shared by their holdings, rather than by condition checks
+	this->required_technology_bitset = technology_bitset(technology::get_index_count());
+
+	for (const technology *required_technology : this->get_required_technologies()) {
+		this->required_technology_bitset.insert(required_technology->get_index());
 	}
+
+	data_entry_base::initialize();
 }
 
 const std::filesystem::path &building::get_icon_path() const
@@ -2,6 +2,7 @@
 
 #include "database/data_entry.h"
 #include "database/data_type.h"
+#include "technology/technology_bitset.h"
 
 #include <vector>
 
@@ -109,6 +110,11 @@ public:
 		return this->required_technologies;
 	}
 
+	const technology_bitset &get_required_technology_bitset() const
+	{
+		return this->required_technology_bitset;
+	}
+
 	QVariantList get_required_technologies_qvariant_list() const;
 	Q_INVOKABLE void add_required_technology(technology *technology);
 	Q_INVOKABLE void remove_technology(technology *technology);
@@ -127,6 +133,7 @@ private:
 	metternich::employment_type *employment_type = nullptr;
 	int workforce = 0; //how many workers does this building allow for its employment type
 	std::set<technology *> required_technologies;
+	technology_bitset required_technology_bitset; //the required technologies, as a bitset
 	std::unique_ptr<and_condition<holding>> preconditions;
 	std::unique_ptr<condition<holding>> conditions;
 };
@@ -105,7 +105,12 @@ int building_slot::get_workforce_capacity() const
 void building_slot::create_condition_checks()
 {
 	//create the condition checks only when initializing history, so that their result won't be calculated until history is ready
-	this->precondition_check = std::make_unique<metternich::condition_check<metternich::holding>>(this->get_building()->get_preconditions(), this->holding, [this](bool result){ this->set_available(result); });
+	if (this->get_building()->get_preconditions() != nullptr) {
+		this->precondition_check = std::make_unique<metternich::condition_check<metternich::holding>>(this->get_building()->get_preconditions(), this->holding, [this](bool result){ this->set_preconditions_fulfilled(result); });
+	} else {
+		this->set_preconditions_fulfilled(true);
+	}
+
 	this->condition_check = std::make_unique<metternich::condition_check<metternich::holding>>(this->get_building()->get_conditions(), this->holding, [this](bool result){ this->set_buildable(result); });
 }
 
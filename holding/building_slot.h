@@ -1,5 +1,7 @@
 #pragma once
 
+#include "util/object_pool.h"
+
 #include <QObject>
 
 namespace metternich {
@@ -15,7 +17,7 @@ class condition_check;
 /**
 **	@brief	The slot for a given building in a holding
 */
-class building_slot final : public QObject
+class building_slot final : public QObject, public pooled_object<building_slot>
 {
 	Q_OBJECT
 
@@ -57,7 +59,25 @@ public:
 		return this->available;
 	}
 
-	void set_available(const bool available);
+	void set_technology_allowed(const bool technology_allowed)
+	{
+		if (technology_allowed == this->technology_allowed) {
+			return;
+		}
+
+		this->technology_allowed = technology_allowed;
+		this->set_available(this->technology_allowed && this->preconditions_fulfilled);
+	}
+
+	void set_preconditions_fulfilled(const bool preconditions_fulfilled)
+	{
+		if (preconditions_fulfilled == this->preconditions_fulfilled) {
+			return;
+		}
+
+		this->preconditions_fulfilled = preconditions_fulfilled;
+		this->set_available(this->technology_allowed && this->preconditions_fulfilled);
+	}
 
 	bool is_buildable() const
 	{
@@ -97,10 +117,15 @@ signals:
 	void workforce_changed();
 	void workforce_capacity_changed();
 
+private:
+	void set_available(const bool available);
+
 private:
 	building *building = nullptr;
 	holding *holding = nullptr; //the building slot's holding
 	bool available = false; //whether the building is at all available
+	bool technology_allowed = false; //whether the technologies of the holding's territory allow the building
+	bool preconditions_fulfilled = false;
 	bool buildable = false; //whether the building is buildable
 	bool built = false;
 	std::unique_ptr<condition_check<metternich::holding>> precondition_check;
@@ -0,0 +1,72 @@
+#include "holding/construction_scheduler.h"
+
+#include "holding/holding.h"
+#include "util/trace.h"
+
+#include <algorithm>
+
+namespace metternich {
+
+/**
+**	@brief	Schedule the completion of a holding's construction
+**
+**	@param	holding	The holding, whose completion day must be after the current day
+*/
+void construction_scheduler::schedule(holding *holding)
+{
+	this->buckets[construction_scheduler::get_bucket_index(holding->get_construction_completion_day())].push_back(holding);
+	this->scheduled_count++;
+}
+
+/**
+**	@brief	Remove a holding from the scheduler, if it is scheduled
+**
+**	@param	holding	The holding
+*/
+void construction_scheduler::unschedule(holding *holding)
+{
+	std::vector<metternich::holding *> &bucket = this->buckets[construction_scheduler::get_bucket_index(holding->get_construction_completion_day())];
+
+	//the order of the bucket is preserved, so that completions happen in a deterministic order
+	const auto find_iterator = std::find(bucket.begin(), bucket.end(), holding);
+	if (find_iterator != bucket.end()) {
+		bucket.erase(find_iterator);
+		this->scheduled_count--;
+	}
+}
+
+/**
+**	@brief	Advance the scheduler by a day, completing the constructions due for the new day
+*/
+void construction_scheduler::do_day()
+{
+	TRACE_SCOPE("construction_scheduler::do_day");
+
+	this->current_day++;
+
+	std::vector<holding *> &bucket = this->buckets[construction_scheduler::get_bucket_index(this->current_day)];
+	if (bucket.empty()) {
+		return;
+	}
+
+	//holdings whose completion day is a later turn of the wheel are kept in the bucket
+	this->completed_holdings.clear();
+	std::erase_if(bucket, [this](holding *holding) {
+		if (holding->get_construction_completion_day() > this->current_day) {
+			return false;
+		}
+
+		this->completed_holdings.push_back(holding);
+		return true;
+	});
+
+	this->scheduled_count -= this->completed_holdings.size();
+
+	for (holding *holding : this->completed_holdings) {
+		holding->complete_construction();
+	}
+
+	TRACE_COUNTER(constructions_completed, this->completed_holdings.size());
+}
+
+}
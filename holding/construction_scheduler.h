@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace metternich {
+
+class holding;
+
+/**
+**	@brief	Schedules the completion of buildings under construction
+**
+**	Holdings under construction are kept in a timing wheel, with a bucket per day: each day only the bucket for the current day is visited, so that holdings which have nothing to complete cost nothing. Constructions which take longer than the wheel's size stay in their bucket until the wheel has turned enough times for their completion day to be reached.
+*/
+class construction_scheduler final
+{
+public:
+	static constexpr size_t wheel_size = 256; //the amount of buckets in the wheel, which must be a power of two
+
+	static_assert((wheel_size & (wheel_size - 1)) == 0);
+
+	uint64_t get_current_day() const
+	{
+		return this->current_day;
+	}
+
+	size_t get_scheduled_count() const
+	{
+		return this->scheduled_count;
+	}
+
+	void schedule(holding *holding);
+	void unschedule(holding *holding);
+	void do_day();
+
+private:
+	static size_t get_bucket_index(const uint64_t day)
+	{
+		return static_cast<size_t>(day & (wheel_size - 1));
+	}
+
+private:
+	uint64_t current_day = 0; //the amount of days which have passed since the scheduler was created; completion days are relative to this
+	std::array<std::vector<holding *>, wheel_size> buckets; //the holdings under construction, in the bucket of their completion day
+	std::vector<holding *> completed_holdings; //the holdings completing their construction in the current day, kept to avoid reallocating it every day
+	size_t scheduled_count = 0;
+};
+
+}
@@ -13,6 +13,7 @@
 #include "history/history.h"
 #include "holding/building.h"
 #include "holding/building_slot.h"
+#include "holding/construction_scheduler.h"
 #include "holding/holding_slot.h"
 #include "holding/holding_slot_type.h"
 #include "holding/holding_type.h"
@@ -21,21 +22,27 @@
 #include "map/map_mode.h"
 #include "map/province.h"
 #include "map/terrain_type.h"
+#include "map/territory.h"
 #include "politics/government_type.h"
 #include "politics/government_type_group.h"
 #include "population/population_type.h"
 #include "population/population_unit.h"
+#include "population/population_unit_view.h"
 #include "religion/religion.h"
 #include "religion/religion_group.h"
 #include "script/holding_modifier.h"
 #include "script/modifier.h"
 #include "technology/technology.h"
 #include "util/container_util.h"
+#include "util/memory_usage.h"
+#include "util/proxy_pool.h"
 #include "util/random.h"
+#include "util/trace.h"
 #include "util/translator.h"
 #include "util/vector_random_util.h"
 #include "warfare/troop_type.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace metternich {
@@ -53,11 +60,12 @@ holding::holding(metternich::holding_slot *slot, holding_type *type) : data_entr
 		this->get_terrain()->get_holding_modifier()->apply(this);
 	}
 
-	for (technology *technology : this->get_territory()->get_technologies()) {
+	this->get_territory()->get_technology_bitset().for_each([this](const size_t index) {
+		const technology *technology = metternich::technology::get_by_index(index);
 		if (technology->get_holding_modifier() != nullptr) {
 			technology->get_holding_modifier()->apply(this);
 		}
-	}
+	});
 
 	this->change_base_population_capacity(this->get_territory()->get_population_capacity_additive_modifier());
 	this->change_population_capacity_modifier(this->get_territory()->get_population_capacity_modifier());
@@ -65,7 +73,8 @@ holding::holding(metternich::holding_slot *slot, holding_type *type) : data_entr
 
 	if (this->is_settlement()) {
 		if (!slot->get_available_commodities().empty()) {
-			metternich::commodity *commodity = vector::get_random(slot->get_available_commodities());
+			random_generator generator = random::get_generator(random_stream::map, "holding_commodity", slot->get_index());
+			metternich::commodity *commodity = vector::get_random(slot->get_available_commodities(), generator);
 			this->set_commodity(commodity);
 		} else {
 			throw std::runtime_error("Holding slot \"" + slot->get_identifier() + "\" has no available commodities to produce.");
@@ -73,16 +82,52 @@ holding::holding(metternich::holding_slot *slot, holding_type *type) : data_entr
 	}
 
 	connect(slot, &holding_slot::terrain_changed, this, &holding::terrain_changed);
+
+	//population units are notified of terrain changes by the holding, rather than each having its own connection to it, as they are created and destroyed constantly
+	connect(this, &holding::terrain_changed, this, [this]() {
+		for (const qunique_ptr<population_unit> &population_unit : this->get_population_units()) {
+			emit population_unit->terrain_changed();
+		}
+	});
+
+	//the proxies are updated in the main thread, in which the holding lives, as they are only used by the interface
+	connect(this, &holding::population_units_changed, this, [this]() {
+		if (this->is_selected()) {
+			this->update_population_unit_views();
+		}
+	});
 	connect(slot, &holding_slot::active_trade_routes_changed, this, &holding::active_trade_routes_changed);
+	connect(this, &holding::name_changed, this, [this]() {
+		this->cached_name.invalidate();
+	}, Qt::ConnectionType::DirectConnection);
+	//the holding's name is tagged with its barony's government type and with its own or its territory's culture and religion, and is its territory's name if it has no barony
+	connect(this, &holding::culture_changed, this, &holding::name_changed, Qt::ConnectionType::DirectConnection);
+	connect(this, &holding::religion_changed, this, &holding::name_changed, Qt::ConnectionType::DirectConnection);
+	connect(this->get_territory(), &territory::name_changed, this, &holding::name_changed, Qt::ConnectionType::DirectConnection);
+	if (this->get_barony() != nullptr) {
+		connect(this->get_barony(), &landed_title::government_type_changed, this, &holding::name_changed, Qt::ConnectionType::DirectConnection);
+	}
+	connect(this, &holding::name_changed, this, &holding::titled_name_changed);
 	connect(this, &holding::type_changed, this, &holding::titled_name_changed);
 	connect(this, &holding::type_changed, this, &holding::portrait_path_changed);
 	connect(this, &holding::culture_changed, this, &holding::portrait_path_changed);
 	connect(this, &holding::religion_changed, this, &holding::portrait_path_changed);
+
+	connect(this->get_territory(), &territory::technologies_changed, this, [this]() {
+		if (this->is_history_initialized() || !history::get()->is_loading()) {
+			this->update_technology_allowed_buildings();
+		}
+	}, Qt::ConnectionType::DirectConnection);
 }
 
 holding::~holding()
 {
+	if (this->get_under_construction_building() != nullptr) {
+		game::get()->get_construction_scheduler().unschedule(this);
+	}
+
 	this->building_slots.clear();
+	this->release_population_unit_views();
 }
 
 void holding::initialize_history()
@@ -118,6 +163,8 @@ void holding::initialize_history()
 		building_slot->initialize_history();
 	}
 
+	this->update_technology_allowed_buildings();
+
 	data_entry_base::initialize_history();
 }
 
@@ -144,17 +191,33 @@ void holding::check_history() const
 	}
 }
 
-void holding::do_day()
+void holding::add_owned_memory_usage(memory_usage &usage, memory_report &report) const
 {
-	//handle construction
-	if (this->get_under_construction_building() != nullptr) {
-		this->change_construction_days(-1);
-		if (this->get_construction_days() <= 0) {
-			this->add_building(this->get_under_construction_building());
-			this->set_under_construction_building(nullptr);
-		}
+	data_entry::add_owned_memory_usage(usage, report);
+
+	usage.add_vector(this->population_units);
+	for (const qunique_ptr<population_unit> &population_unit : this->population_units) {
+		report.add_instance(population_unit.get(), "population_unit");
+	}
+
+	usage.add_tree(this->building_slots);
+	for (size_t i = 0; i < this->building_slots.size(); ++i) {
+		report.get_usage("building_slot").add_instance<building_slot>();
 	}
 
+	usage.add_tree(this->modifiers);
+	usage.add_tree(this->employments);
+	usage.add_tree(this->population_per_type);
+	usage.add_tree(this->population_per_culture.get_values());
+	usage.add_tree(this->population_per_religion.get_values());
+	usage.add_tree(this->levies);
+	usage.add_tree(this->troop_attack_modifiers);
+	usage.add_tree(this->troop_defense_modifiers);
+}
+
+void holding::do_day()
+{
+	//construction is handled by the construction scheduler, so that holdings without a building under construction don't need to check it every day
 	for (employment *employment : this->get_employments()) {
 		employment->do_day();
 	}
@@ -162,6 +225,8 @@ void holding::do_day()
 
 void holding::do_month()
 {
+	TRACE_SCOPE("holding::do_month");
+
 	if (this->is_settlement()) {
 		this->do_population_growth();
 
@@ -170,9 +235,12 @@ void holding::do_month()
 		for (size_t i = 0; i < pop_units_size; ++i) {
 			this->population_units[i]->do_month();
 		}
+		TRACE_COUNTER(population_units_processed, pop_units_size);
 
 		this->remove_empty_population_units();
-		this->calculate_population_groups();
+
+		//the population groups are kept up to date as population units change, so only the interface needs to be notified
+		emit population_groups_changed();
 	}
 }
 
@@ -183,11 +251,13 @@ void holding::do_year()
 
 std::string holding::get_name() const
 {
-	if (this->get_barony() != nullptr) {
-		return translator::get()->translate(this->get_barony()->get_identifier_with_aliases(), this->get_tag_suffix_list_with_fallbacks());
-	}
+	return this->cached_name.get([this]() {
+		if (this->get_barony() != nullptr) {
+			return translator::get()->translate(this->get_barony()->get_identifier_with_aliases(), this->get_tag_suffix_list_with_fallbacks());
+		}
 
-	return this->get_territory()->get_name();
+		return this->get_territory()->get_name();
+	});
 }
 
 std::string holding::get_type_name() const
@@ -255,6 +325,11 @@ void holding::set_type(holding_type *type)
 	}
 
 	emit type_changed();
+
+	if (this->get_barony() != nullptr) {
+		emit this->get_barony()->name_changed(); //the barony's name depends on the holding's type
+	}
+
 	this->calculate_building_slots();
 	this->update_population_types();
 }
@@ -285,6 +360,7 @@ void holding::set_owner(character *new_owner)
 	character *old_owner = this->get_owner();
 	if (old_owner != nullptr) {
 		old_owner->remove_holding(this);
+		old_owner->change_de_facto_statistics(-this->get_realm_statistics());
 	}
 
 	if (this->get_barony() != nullptr && this->get_barony()->get_holder() != new_owner) {
@@ -298,6 +374,7 @@ void holding::set_owner(character *new_owner)
 
 	if (new_owner != nullptr) {
 		new_owner->add_holding(this);
+		new_owner->change_de_facto_statistics(this->get_realm_statistics());
 	}
 
 	if (this->get_province() != nullptr && this->get_slot()->get_type() == holding_slot_type::trading_post && map::get()->get_mode() == map_mode::trade_zone) {
@@ -398,6 +475,32 @@ population_unit *holding::get_population_unit(const population_type *type, const
 	return nullptr;
 }
 
+/**
+**	@brief	Create a population unit in the holding, without checking whether one with the same characteristics already exists
+**
+**	@param	type		The population type
+**	@param	culture		The culture
+**	@param	religion	The religion
+**	@param	phenotype	The phenotype
+**	@param	size		The size
+**
+**	@return	The new population unit
+*/
+population_unit *holding::create_population_unit(population_type *type, metternich::culture *culture, metternich::religion *religion, phenotype *phenotype, const int size)
+{
+	auto new_population_unit = make_qunique<metternich::population_unit>(type);
+	new_population_unit->moveToThread(QApplication::instance()->thread());
+	new_population_unit->set_holding(this);
+	new_population_unit->set_size(size);
+	new_population_unit->set_culture(culture);
+	new_population_unit->set_religion(religion);
+	new_population_unit->set_phenotype(phenotype);
+
+	population_unit *population_unit = new_population_unit.get();
+	this->add_population_unit(std::move(new_population_unit));
+	return population_unit;
+}
+
 /**
 **	@brief	Change the population size of the holding's population unit with a given type, culture, religion and phenotype, creating a new one if no population unit is found with those characteristics and the change is positive
 **
@@ -414,26 +517,54 @@ void holding::change_population_size(population_type *type, metternich::culture
 	if (population_unit != nullptr) {
 		population_unit->change_size(change);
 	} else if (change > 0) {
-		auto new_population_unit = make_qunique<metternich::population_unit>(type);
-		new_population_unit->moveToThread(QApplication::instance()->thread());
-		new_population_unit->set_holding(this);
-		new_population_unit->set_size(change);
-		new_population_unit->set_culture(culture);
-		new_population_unit->set_religion(religion);
-		new_population_unit->set_phenotype(phenotype);
-		this->add_population_unit(std::move(new_population_unit));
+		this->create_population_unit(type, culture, religion, phenotype, change);
 	}
 }
 
+//the interface is given proxies of the population units, rather than the population units themselves
 QVariantList holding::get_population_units_qvariant_list() const
 {
-	QVariantList list;
+	return container::to_qvariant_list(this->population_unit_views);
+}
+
+/**
+**	@brief	Bind the holding's population unit proxies to its current population units, acquiring or releasing proxies as needed
+**
+**	Proxies which are kept are rebound in place, so that the interface's items for them stay valid.
+*/
+void holding::update_population_unit_views()
+{
+	const std::vector<qunique_ptr<population_unit>> &population_units = this->get_population_units();
 
-	for (const qunique_ptr<population_unit> &population_unit : this->get_population_units()) {
-		list.append(QVariant::fromValue(population_unit.get()));
+	while (this->population_unit_views.size() > population_units.size()) {
+		proxy_pool<population_unit_view>::get().release(this->population_unit_views.back());
+		this->population_unit_views.pop_back();
+	}
+
+	while (this->population_unit_views.size() < population_units.size()) {
+		this->population_unit_views.push_back(proxy_pool<population_unit_view>::get().acquire());
+	}
+
+	for (size_t i = 0; i < population_units.size(); ++i) {
+		this->population_unit_views[i]->set_population_unit(population_units[i].get());
 	}
 
-	return list;
+	emit population_unit_views_changed();
+}
+
+//return the proxies of the population units to their pool, as the interface is no longer viewing them
+void holding::release_population_unit_views()
+{
+	if (this->population_unit_views.empty()) {
+		return;
+	}
+
+	for (population_unit_view *population_unit_view : this->population_unit_views) {
+		proxy_pool<metternich::population_unit_view>::get().release(population_unit_view);
+	}
+
+	this->population_unit_views.clear();
+	emit population_unit_views_changed();
 }
 
 void holding::sort_population_units()
@@ -502,6 +633,10 @@ void holding::set_population(const int population)
 	//change the population count for the territory as well
 	const int population_change = population - old_population;
 	this->get_territory()->change_population(population_change);
+
+	realm_statistics statistics_change;
+	statistics_change.population = population_change;
+	this->change_realm_statistics(statistics_change);
 }
 
 void holding::calculate_population()
@@ -574,50 +709,87 @@ void holding::check_overpopulation()
 	}
 }
 
-void holding::calculate_population_groups()
+/**
+**	@brief	Change the population of a population group in the holding, propagating the change to its territory
+**
+**	@param	type		The population type; null if the change doesn't apply to population types
+**	@param	culture		The culture; null if the change doesn't apply to cultures
+**	@param	religion	The religion; null if the change doesn't apply to religions
+**	@param	change		The population change
+*/
+void holding::change_population_group(population_type *type, metternich::culture *culture, metternich::religion *religion, const int change)
 {
-	std::unique_lock<std::shared_mutex> lock(this->population_groups_mutex);
+	if (change == 0) {
+		return;
+	}
 
-	this->population_per_type.clear();
-	this->population_per_culture.clear();
-	this->population_per_religion.clear();
+	{
+		std::unique_lock<std::shared_mutex> lock(this->population_groups_mutex);
 
-	for (const qunique_ptr<population_unit> &population_unit : this->get_population_units()) {
-		this->population_per_type[population_unit->get_type()] += population_unit->get_size();
-		this->population_per_culture[population_unit->get_culture()] += population_unit->get_size();
-		this->population_per_religion[population_unit->get_religion()] += population_unit->get_size();
+		if (type != nullptr) {
+			int &type_population = this->population_per_type[type];
+			type_population += change;
+			if (type_population <= 0) {
+				this->population_per_type.erase(type);
+			}
+		}
+
+		if (culture != nullptr) {
+			this->population_per_culture.change(culture, change);
+		}
+
+		if (religion != nullptr) {
+			this->population_per_religion.change(religion, change);
+		}
 	}
 
-	emit population_groups_changed();
+	this->calculate_culture_and_religion();
+
+	this->get_territory()->change_population_group(type, culture, religion, change);
+}
+
+/**
+**	@brief	Recalculate the population groups from the holding's population units, e.g. after initializing its history
+*/
+void holding::calculate_population_groups()
+{
+	{
+		std::unique_lock<std::shared_mutex> lock(this->population_groups_mutex);
 
-	//update the holding's main culture and religion
+		this->population_per_type.clear();
+		this->population_per_culture.clear();
+		this->population_per_religion.clear();
 
-	metternich::culture *plurality_culture = nullptr;
-	int plurality_culture_size = 0;
+		for (const qunique_ptr<population_unit> &population_unit : this->get_population_units()) {
+			if (population_unit->get_size() == 0) {
+				continue;
+			}
 
-	for (const auto &kv_pair : this->population_per_culture) {
-		metternich::culture *culture = kv_pair.first;
-		const int culture_size = kv_pair.second;
-		if (plurality_culture == nullptr || culture_size > plurality_culture_size) {
-			plurality_culture = culture;
-			plurality_culture_size = culture_size;
+			this->population_per_type[population_unit->get_type()] += population_unit->get_size();
+			this->population_per_culture.change(population_unit->get_culture(), population_unit->get_size());
+			this->population_per_religion.change(population_unit->get_religion(), population_unit->get_size());
 		}
 	}
 
-	metternich::religion *plurality_religion = nullptr;
-	int plurality_religion_size = 0;
+	emit population_groups_changed();
 
-	for (const auto &kv_pair : this->population_per_religion) {
-		metternich::religion *religion = kv_pair.first;
-		const int religion_size = kv_pair.second;
-		if (plurality_religion == nullptr || religion_size > plurality_religion_size) {
-			plurality_religion = religion;
-			plurality_religion_size = religion_size;
-		}
+	this->calculate_culture_and_religion();
+}
+
+/**
+**	@brief	Update the holding's main culture and religion to its plurality ones; these are kept if the holding has no population
+*/
+void holding::calculate_culture_and_religion()
+{
+	metternich::culture *plurality_culture = this->population_per_culture.get_plurality();
+	if (plurality_culture != nullptr) {
+		this->set_culture(plurality_culture);
 	}
 
-	this->set_culture(plurality_culture);
-	this->set_religion(plurality_religion);
+	metternich::religion *plurality_religion = this->population_per_religion.get_plurality();
+	if (plurality_religion != nullptr) {
+		this->set_religion(plurality_religion);
+	}
 }
 
 std::vector<building_slot *> holding::get_building_slots() const
@@ -735,21 +907,87 @@ void holding::calculate_building_slots()
 	}
 
 	if (changed) {
+		//building availability is calculated only once history has been initialized, as before that buildings can be added by history regardless of technologies
+		this->technology_allowed_buildings = nullptr;
+		if (this->is_history_initialized() || !history::get()->is_loading()) {
+			this->update_technology_allowed_buildings();
+		}
+
 		emit building_slots_changed();
 	}
 }
 
+/**
+**	@brief	Update whether the technologies of the holding's territory allow each of its buildings
+**
+**	The buildings allowed by a set of technologies are shared by all holdings of the same type, so nothing needs to be done if the technologies which changed are irrelevant for the type's buildings.
+*/
+void holding::update_technology_allowed_buildings()
+{
+	const std::set<building *> &allowed_buildings = this->get_type()->get_technology_allowed_buildings(this->get_territory()->get_technology_bitset());
+	if (&allowed_buildings == this->technology_allowed_buildings) {
+		return;
+	}
+
+	this->technology_allowed_buildings = &allowed_buildings;
+
+	for (const auto &kv_pair : this->building_slots) {
+		kv_pair.second->set_technology_allowed(allowed_buildings.contains(kv_pair.first));
+	}
+}
+
 void holding::set_under_construction_building(building *building)
 {
 	if (building == this->get_under_construction_building()) {
 		return;
 	}
 
+	if (this->get_under_construction_building() != nullptr) {
+		game::get()->get_construction_scheduler().unschedule(this);
+	}
+
 	this->under_construction_building = building;
 	emit under_construction_building_changed();
+
 	if (building != nullptr) {
 		this->set_construction_days(building->get_construction_days());
+	} else {
+		emit construction_days_changed();
+	}
+}
+
+int holding::get_construction_days() const
+{
+	if (this->get_under_construction_building() == nullptr) {
+		return 0;
+	}
+
+	return static_cast<int>(this->construction_completion_day - game::get()->get_construction_scheduler().get_current_day());
+}
+
+/**
+**	@brief	Set the amount of days remaining to construct the building under construction
+**
+**	@param	construction_days	The amount of days; buildings are completed in the next day at the earliest
+*/
+void holding::set_construction_days(const int construction_days)
+{
+	if (this->get_under_construction_building() == nullptr) {
+		return;
 	}
+
+	construction_scheduler &scheduler = game::get()->get_construction_scheduler();
+	scheduler.unschedule(this);
+	this->construction_completion_day = scheduler.get_current_day() + static_cast<uint64_t>(std::max(construction_days, 1));
+	scheduler.schedule(this);
+
+	emit construction_days_changed();
+}
+
+void holding::complete_construction()
+{
+	this->add_building(this->get_under_construction_building());
+	this->set_under_construction_building(nullptr);
 }
 
 int holding::get_holding_size() const
@@ -802,6 +1040,38 @@ QVariantList holding::get_troop_stats_qvariant_list() const
 	return troop_stats;
 }
 
+/**
+**	@brief	Get the holding's contribution to the statistics of its owner's realm and of its de jure titles
+**
+**	@return	The holding's statistics
+*/
+realm_statistics holding::get_realm_statistics() const
+{
+	realm_statistics statistics;
+	statistics.population = this->get_population();
+	for (const auto &kv_pair : this->levies) {
+		statistics.levies += kv_pair.second;
+	}
+	statistics.holding_count = 1;
+	return statistics;
+}
+
+/**
+**	@brief	Propagate a change in the holding's statistics to its owner's realm and to its territory's de jure titles
+**
+**	@param	change	The statistics change
+*/
+void holding::change_realm_statistics(const realm_statistics &change)
+{
+	if (this->get_owner() != nullptr) {
+		this->get_owner()->change_de_facto_statistics(change);
+	}
+
+	if (this->get_territory()->get_county() != nullptr) {
+		this->get_territory()->get_county()->change_de_jure_statistics(change);
+	}
+}
+
 int holding::get_troop_attack(troop_type *troop_type) const
 {
 	return troop_type->get_attack() + this->get_troop_attack_modifier(troop_type);
@@ -819,15 +1089,24 @@ void holding::set_selected(const bool selected, const bool notify_engine_interfa
 	}
 
 	if (selected) {
-		if (holding::selected_holding != nullptr) {
-			holding::selected_holding->set_selected(false, false);
+		holding *old_selected_holding = holding::get_selected_holding();
+		if (old_selected_holding != nullptr) {
+			old_selected_holding->set_selected(false, false);
 		}
-		holding::selected_holding = this;
+		holding::selected_holding.store(this, std::memory_order_release);
 	} else {
-		holding::selected_holding = nullptr;
+		holding::selected_holding.store(nullptr, std::memory_order_release);
 	}
 
 	this->selected = selected;
+
+	//the population units are only viewed by the interface for the selected holding
+	if (selected) {
+		this->update_population_unit_views();
+	} else {
+		this->release_population_unit_views();
+	}
+
 	emit selected_changed();
 
 	if (notify_engine_interface) {
@@ -857,7 +1136,7 @@ QVariantList holding::get_population_per_culture_qvariant_list() const
 
 	QVariantList population_per_culture;
 
-	for (const auto &kv_pair : this->population_per_culture) {
+	for (const auto &kv_pair : this->get_population_per_culture()) {
 		QVariantMap culture_population;
 		culture_population["culture"] = QVariant::fromValue(kv_pair.first);
 		culture_population["population"] = QVariant::fromValue(kv_pair.second);
@@ -873,7 +1152,7 @@ QVariantList holding::get_population_per_religion_qvariant_list() const
 
 	QVariantList population_per_religion;
 
-	for (const auto &kv_pair : this->population_per_religion) {
+	for (const auto &kv_pair : this->get_population_per_religion()) {
 		QVariantMap religion_population;
 		religion_population["religion"] = QVariant::fromValue(kv_pair.first);
 		religion_population["population"] = QVariant::fromValue(kv_pair.second);
@@ -887,7 +1166,7 @@ void holding::order_construction(const QVariant &building_variant)
 {
 	QObject *building_object = qvariant_cast<QObject *>(building_variant);
 	building *building = static_cast<metternich::building *>(building_object);
-	game::get()->post_order([this, building]() {
+	game::get()->post_order("order_construction " + this->get_slot()->get_identifier() + " " + building->get_identifier(), [this, building]() {
 		this->set_under_construction_building(building);
 	});
 }
@@ -1,11 +1,17 @@
 #pragma once
 
 #include "database/data_entry.h"
+#include "landed_title/realm_statistics.h"
+#include "util/cached_translation.h"
+#include "util/object_pool.h"
+#include "util/plurality_map.h"
 #include "util/qunique_ptr.h"
 #include "warfare/troop_type_map.h"
 
 #include <QVariant>
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <string>
@@ -27,6 +33,7 @@ class landed_title;
 class phenotype;
 class population_type;
 class population_unit;
+class population_unit_view;
 class province;
 class religion;
 class terrain_type;
@@ -34,7 +41,7 @@ class territory;
 class troop_type;
 class world;
 
-class holding final : public data_entry
+class holding final : public data_entry, public pooled_object<holding>
 {
 	Q_OBJECT
 
@@ -49,7 +56,7 @@ class holding final : public data_entry
 	Q_PROPERTY(int population READ get_population WRITE set_population NOTIFY population_changed)
 	Q_PROPERTY(int population_capacity READ get_population_capacity NOTIFY population_capacity_changed)
 	Q_PROPERTY(int population_growth READ get_population_growth NOTIFY population_growth_changed)
-	Q_PROPERTY(QVariantList population_units READ get_population_units_qvariant_list NOTIFY population_units_changed)
+	Q_PROPERTY(QVariantList population_units READ get_population_units_qvariant_list NOTIFY population_unit_views_changed)
 	Q_PROPERTY(QVariantList building_slots READ get_building_slots_qvariant_list NOTIFY building_slots_changed)
 	Q_PROPERTY(QVariantList buildings READ get_buildings_qvariant_list NOTIFY buildings_changed)
 	Q_PROPERTY(metternich::building* under_construction_building READ get_under_construction_building NOTIFY under_construction_building_changed)
@@ -64,11 +71,11 @@ class holding final : public data_entry
 public:
 	static holding *get_selected_holding()
 	{
-		return holding::selected_holding;
+		return holding::selected_holding.load(std::memory_order_acquire);
 	}
 
 private:
-	static inline holding *selected_holding = nullptr;
+	static inline std::atomic<holding *> selected_holding = nullptr; //set by the interface, and read by the game loop thread to notify the interface of changes to the selected holding
 
 public:
 	holding(holding_slot *slot, holding_type *type);
@@ -76,6 +83,7 @@ public:
 
 	virtual void initialize_history() override;
 	virtual void check_history() const override;
+	virtual void add_owned_memory_usage(memory_usage &usage, memory_report &report) const override;
 
 	void do_day();
 	void do_month();
@@ -148,8 +156,11 @@ public:
 
 	void add_population_unit(qunique_ptr<population_unit> &&population_unit);
 	population_unit *get_population_unit(const population_type *type, const culture *culture, const religion *religion, const phenotype *phenotype) const;
+	population_unit *create_population_unit(population_type *type, culture *culture, religion *religion, phenotype *phenotype, const int size);
 	void change_population_size(population_type *type, culture *culture, religion *religion, phenotype *phenotype, const int change);
 	QVariantList get_population_units_qvariant_list() const;
+	void update_population_unit_views();
+	void release_population_unit_views();
 	void sort_population_units();
 	void remove_empty_population_units();
 	void move_population_units_to(holding *other_holding);
@@ -298,35 +309,27 @@ public:
 
 	const std::map<metternich::culture *, int> &get_population_per_culture() const
 	{
-		return this->population_per_culture;
+		return this->population_per_culture.get_values();
 	}
 
 	int get_culture_population(metternich::culture *culture) const
 	{
-		auto find_iterator = this->population_per_culture.find(culture);
-		if (find_iterator == this->population_per_culture.end()) {
-			return 0;
-		}
-
-		return find_iterator->second;
+		return this->population_per_culture.get_value(culture);
 	}
 
 	const std::map<metternich::religion *, int> &get_population_per_religion() const
 	{
-		return this->population_per_religion;
+		return this->population_per_religion.get_values();
 	}
 
 	int get_religion_population(metternich::religion *religion) const
 	{
-		auto find_iterator = this->population_per_religion.find(religion);
-		if (find_iterator == this->population_per_religion.end()) {
-			return 0;
-		}
-
-		return find_iterator->second;
+		return this->population_per_religion.get_value(religion);
 	}
 
+	void change_population_group(population_type *type, metternich::culture *culture, metternich::religion *religion, const int change);
 	void calculate_population_groups();
+	void calculate_culture_and_religion();
 
 	std::vector<building_slot *> get_building_slots() const;
 	QVariantList get_building_slots_qvariant_list() const;
@@ -336,6 +339,7 @@ public:
 	Q_INVOKABLE void add_building(building *building);
 	Q_INVOKABLE void remove_building(building *building);
 	void calculate_building_slots();
+	void update_technology_allowed_buildings();
 
 	building *get_under_construction_building() const
 	{
@@ -344,25 +348,15 @@ public:
 
 	void set_under_construction_building(building *building);
 
-	int get_construction_days() const
-	{
-		return this->construction_days;
-	}
+	int get_construction_days() const;
+	void set_construction_days(const int construction_days);
 
-	void set_construction_days(const int construction_days)
+	uint64_t get_construction_completion_day() const
 	{
-		if (construction_days == this->get_construction_days()) {
-			return;
-		}
-
-		this->construction_days = construction_days;
-		emit construction_days_changed();
+		return this->construction_completion_day;
 	}
 
-	void change_construction_days(const int change)
-	{
-		this->set_construction_days(this->get_construction_days() + change);
-	}
+	void complete_construction();
 
 	metternich::commodity *get_commodity() const
 	{
@@ -448,6 +442,9 @@ public:
 			return;
 		}
 
+		realm_statistics statistics_change;
+		statistics_change.levies = levy - this->get_levy(troop_type);
+
 		if (levy == 0) {
 			this->levies.erase(troop_type);
 		} else {
@@ -455,6 +452,8 @@ public:
 		}
 
 		emit levies_changed();
+
+		this->change_realm_statistics(statistics_change);
 	}
 
 	void change_levy(troop_type *troop_type, const int change)
@@ -464,6 +463,9 @@ public:
 
 	QVariantList get_troop_stats_qvariant_list() const;
 
+	realm_statistics get_realm_statistics() const;
+	void change_realm_statistics(const realm_statistics &change);
+
 	int get_troop_attack(troop_type *troop_type) const;
 
 	int get_troop_attack_modifier(troop_type *troop_type) const
@@ -558,6 +560,7 @@ signals:
 	void portrait_path_changed();
 	void owner_changed();
 	void population_units_changed();
+	void population_unit_views_changed();
 	void population_changed();
 	void population_capacity_changed();
 	void population_growth_changed();
@@ -580,6 +583,7 @@ private:
 	holding_type *type = nullptr;
 	character *owner = nullptr; //the owner of the holding
 	std::vector<qunique_ptr<population_unit>> population_units;
+	std::vector<population_unit_view *> population_unit_views; //the pooled proxies through which the interface views the population units; only kept while the holding is selected
 	int base_population_capacity = 0; //the base population capacity
 	int population_capacity_modifier = 100; //the population capacity modifier
 	int population_capacity = 0; //the population capacity
@@ -588,20 +592,22 @@ private:
 	int population_growth = 0; //the population growth, in permyriad (per 10,000)
 	std::map<building *, qunique_ptr<building_slot>> building_slots; //the building slots for each building
 	building *under_construction_building = nullptr; //the building currently under construction
-	int construction_days = 0; //the amount of days remaining to construct the building under construction
+	uint64_t construction_completion_day = 0; //the day of the construction scheduler in which the building under construction will be completed
+	const std::set<building *> *technology_allowed_buildings = nullptr; //the buildings allowed by the territory's technologies, shared by the holdings of the same type with the same relevant technologies
 	metternich::commodity *commodity = nullptr; //the commodity produced by the holding (if any)
 	metternich::culture *culture = nullptr; //the holding's culture
 	metternich::religion *religion = nullptr; //the holding's religion
 	std::set<holding_modifier *> modifiers; //modifiers applied to the holding
 	std::set<employment *> employments;
 	std::map<population_type *, int> population_per_type; //the population for each population type
-	std::map<metternich::culture *, int> population_per_culture; //the population for each culture
-	std::map<metternich::religion *, int> population_per_religion; //the population for each religion
+	plurality_map<metternich::culture> population_per_culture; //the population for each culture
+	plurality_map<metternich::religion> population_per_religion; //the population for each religion
 	mutable std::shared_mutex population_groups_mutex;
 	troop_type_map<int> levies; //levies per troop type
 	troop_type_map<int> troop_attack_modifiers;
 	troop_type_map<int> troop_defense_modifiers;
 	bool selected = false;
+	cached_translation cached_name;
 };
 
 }
@@ -20,6 +20,7 @@
 #include "script/chance_util.h"
 #include "script/modifier.h"
 #include "util/container_util.h"
+#include "util/memory_usage.h"
 #include "util/random.h"
 #include "util/translator.h"
 #include "util/vector_util.h"
@@ -145,6 +146,18 @@ void holding_slot::check_history() const
 	this->check();
 }
 
+void holding_slot::add_owned_memory_usage(memory_usage &usage, memory_report &report) const
+{
+	data_entry::add_owned_memory_usage(usage, report);
+
+	usage.add_vector(this->available_commodities);
+	usage.add_vector(this->megalopolis_provinces);
+
+	if (this->get_holding() != nullptr) {
+		report.add_instance(this->get_holding(), "holding");
+	}
+}
+
 void holding_slot::do_day()
 {
 	if (this->get_holding() != nullptr) {
@@ -328,7 +341,8 @@ void holding_slot::generate_available_commodity()
 		}
 	}
 
-	metternich::commodity *commodity = calculate_chance_list_result(commodity_chances, this);
+	random_generator generator = random::get_generator(random_stream::map, "available_commodity", this->get_index(), this->get_available_commodities().size());
+	metternich::commodity *commodity = calculate_chance_list_result(commodity_chances, this, &generator);
 	this->add_available_commodity(commodity);
 }
 
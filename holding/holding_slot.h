@@ -80,6 +80,7 @@ public:
 	virtual void initialize_history() override;
 	virtual void check() const override;
 	virtual void check_history() const override;
+	virtual void add_owned_memory_usage(memory_usage &usage, memory_report &report) const override;
 
 	void do_day();
 	void do_month();
@@ -1,6 +1,7 @@
 #include "holding/holding_type.h"
 
 #include "database/gsml_data.h"
+#include "holding/building.h"
 #include "politics/law.h"
 #include "script/modifier.h"
 #include "util/container_util.h"
@@ -36,6 +37,53 @@ void holding_type::process_gsml_scope(const gsml_data &scope)
 	}
 }
 
+void holding_type::initialize()
+{
+	for (building *building : this->get_buildings()) {
+		if (!building->is_initialized()) {
+			building->initialize();
+		}
+
+		this->building_technology_bitset |= building->get_required_technology_bitset();
+	}
+
+	data_entry_base::initialize();
+}
+
+/**
+**	@brief	Get the buildings of the holding type allowed by a set of technologies
+**
+**	@param	technologies	The technologies
+**
+**	@return	The allowed buildings; the result is cached for the technologies relevant for the holding type's buildings, so that it is shared by all holdings of the type which have the same relevant technologies
+*/
+const std::set<building *> &holding_type::get_technology_allowed_buildings(const technology_bitset &technologies) const
+{
+	technology_bitset relevant_technologies = this->building_technology_bitset;
+	relevant_technologies &= technologies;
+
+	{
+		std::shared_lock<std::shared_mutex> lock(this->technology_allowed_buildings_mutex);
+
+		const auto find_iterator = this->technology_allowed_buildings.find(relevant_technologies);
+		if (find_iterator != this->technology_allowed_buildings.end()) {
+			return find_iterator->second;
+		}
+	}
+
+	std::set<building *> allowed_buildings;
+	for (building *building : this->get_buildings()) {
+		if (relevant_technologies.contains_all(building->get_required_technology_bitset())) {
+			allowed_buildings.insert(building);
+		}
+	}
+
+	std::unique_lock<std::shared_mutex> lock(this->technology_allowed_buildings_mutex);
+	//if another thread added the same technologies in the meantime, the existing buildings are kept
+	const auto result = this->technology_allowed_buildings.try_emplace(std::move(relevant_technologies), std::move(allowed_buildings));
+	return result.first->second;
+}
+
 QVariantList holding_type::get_default_laws_qvariant_list() const
 {
 	return container::to_qvariant_list(map_container::get_values(this->default_laws));
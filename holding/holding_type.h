@@ -2,7 +2,11 @@
 
 #include "database/data_entry.h"
 #include "database/data_type.h"
+#include "technology/technology_bitset.h"
 
+#include <map>
+#include <set>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -35,6 +39,7 @@ public:
 	virtual ~holding_type() override;
 
 	virtual void process_gsml_scope(const gsml_data &scope) override;
+	virtual void initialize() override;
 
 	holding_slot_type get_slot_type() const
 	{
@@ -89,6 +94,8 @@ public:
 		this->buildings.erase(building);
 	}
 
+	const std::set<building *> &get_technology_allowed_buildings(const technology_bitset &technologies) const;
+
 	const std::map<law_group *, law *> &get_default_laws() const
 	{
 		return this->default_laws;
@@ -107,6 +114,9 @@ private:
 	holding_slot_type slot_type;	//the slot type which the holding type occupies
 	std::string portrait_tag;
 	std::set<building *> buildings;
+	technology_bitset building_technology_bitset; //the technologies required by any of the holding type's buildings
+	mutable std::shared_mutex technology_allowed_buildings_mutex;
+	mutable std::map<technology_bitset, std::set<building *>> technology_allowed_buildings; //the buildings allowed by each set of technologies, restricted to the ones required by the holding type's buildings
 	std::map<law_group *, law *> default_laws;
 	std::unique_ptr<metternich::modifier<holding>> modifier; //the modifier applied to holdings of this type
 };
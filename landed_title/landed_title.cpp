@@ -290,7 +290,9 @@ void landed_title::check_history() const
 
 std::string landed_title::get_name() const
 {
-	return translator::get()->translate(this->get_identifier_with_aliases(), this->get_tag_suffix_list_with_fallbacks());
+	return this->cached_name.get([this]() {
+		return translator::get()->translate(this->get_identifier_with_aliases(), this->get_tag_suffix_list_with_fallbacks());
+	});
 }
 
 std::string landed_title::get_tier_title_name() const
@@ -382,6 +384,20 @@ void landed_title::set_holder(character *character)
 	this->holder_title = nullptr; //set the holder title to null, so that the new holder (null or otherwise) isn't overwritten by a previous holder title
 	this->random_holder = false;
 
+	if (this->get_territory() != nullptr) {
+		//the territory counts as a province for the realm of the county's holder
+		realm_statistics statistics_change;
+		statistics_change.province_count = 1;
+
+		if (old_holder != nullptr) {
+			old_holder->change_de_facto_statistics(-statistics_change);
+		}
+
+		if (character != nullptr) {
+			character->change_de_facto_statistics(statistics_change);
+		}
+	}
+
 	const landed_title *realm = this->get_realm();
 
 	if (this->get_star_system() != nullptr) {
@@ -560,6 +576,7 @@ void landed_title::set_de_jure_liege_title(landed_title *title)
 
 	if (this->get_de_jure_liege_title() != nullptr) {
 		this->get_de_jure_liege_title()->remove_de_jure_vassal_title(this);
+		this->get_de_jure_liege_title()->change_de_jure_statistics(-this->get_de_jure_statistics());
 	}
 
 	if (title != nullptr && static_cast<int>(title->get_tier()) - static_cast<int>(this->get_tier()) != 1) {
@@ -570,6 +587,7 @@ void landed_title::set_de_jure_liege_title(landed_title *title)
 
 	if (title != nullptr) {
 		title->add_de_jure_vassal_title(this);
+		title->change_de_jure_statistics(this->get_de_jure_statistics());
 	}
 
 	emit de_jure_liege_title_changed();
@@ -580,6 +598,42 @@ void landed_title::remove_de_jure_vassal_title(landed_title *title)
 	vector::remove(this->de_jure_vassal_titles, title);
 }
 
+/**
+**	@brief	Change the statistics of the title's de jure territories, propagating the change to its de jure lieges
+**
+**	@param	change	The statistics change
+*/
+void landed_title::change_de_jure_statistics(const realm_statistics &change)
+{
+	for (landed_title *title = this; title != nullptr; title = title->get_de_jure_liege_title()) {
+		title->de_jure_statistics += change;
+	}
+}
+
+/**
+**	@brief	Recalculate the statistics of the title's de jure territories from scratch, including those of its de jure vassal titles
+**
+**	@return	The statistics
+*/
+const realm_statistics &landed_title::calculate_de_jure_statistics()
+{
+	realm_statistics statistics;
+
+	if (this->get_territory() != nullptr) {
+		for (const holding *holding : this->get_territory()->get_holdings()) {
+			statistics += holding->get_realm_statistics();
+		}
+		statistics.province_count = 1;
+	}
+
+	for (landed_title *vassal_title : this->get_de_jure_vassal_titles()) {
+		statistics += vassal_title->calculate_de_jure_statistics();
+	}
+
+	this->de_jure_statistics = statistics;
+	return this->de_jure_statistics;
+}
+
 /**
 **	@brief	Get the title's (de facto) title for a given tier
 **
@@ -2,6 +2,8 @@
 
 #include "database/data_entry.h"
 #include "database/data_type.h"
+#include "landed_title/realm_statistics.h"
+#include "util/cached_translation.h"
 
 #include <QColor>
 
@@ -81,6 +83,15 @@ private:
 public:
 	landed_title(const std::string &identifier) : data_entry(identifier)
 	{
+		connect(this, &identifiable_data_entry_base::name_changed, this, [this]() {
+			this->cached_name.invalidate();
+		}, Qt::ConnectionType::DirectConnection);
+		//the title's name is tagged with its government type, its holder's dynasty, and the culture and religion of its holder, or else of its capital
+		connect(this, &landed_title::holder_changed, this, &identifiable_data_entry_base::name_changed, Qt::ConnectionType::DirectConnection);
+		connect(this, &landed_title::government_type_changed, this, &identifiable_data_entry_base::name_changed, Qt::ConnectionType::DirectConnection);
+		connect(this, &landed_title::capital_province_changed, this, &identifiable_data_entry_base::name_changed, Qt::ConnectionType::DirectConnection);
+		connect(this, &landed_title::capital_world_changed, this, &identifiable_data_entry_base::name_changed, Qt::ConnectionType::DirectConnection);
+		connect(this, &identifiable_data_entry_base::name_changed, this, &landed_title::titled_name_changed);
 		connect(this, &landed_title::government_type_changed, this, &landed_title::titled_name_changed);
 	}
 
@@ -194,6 +205,19 @@ public:
 
 	void remove_de_jure_vassal_title(landed_title *title);
 
+	const realm_statistics &get_de_jure_statistics() const
+	{
+		return this->de_jure_statistics;
+	}
+
+	Q_INVOKABLE QVariantMap get_de_jure_statistics_qvariant_map() const
+	{
+		return this->get_de_jure_statistics().to_qvariant_map();
+	}
+
+	void change_de_jure_statistics(const realm_statistics &change);
+	const realm_statistics &calculate_de_jure_statistics();
+
 	landed_title *get_tier_title(const landed_title_tier tier) const;
 	landed_title *get_tier_de_jure_title(const landed_title_tier tier) const;
 	landed_title *get_county() const;
@@ -341,6 +365,7 @@ private:
 	metternich::star_system *star_system = nullptr; //the title's star system, if it is a non-titular cosmic duchy
 	landed_title *de_jure_liege_title = nullptr;
 	std::vector<landed_title *> de_jure_vassal_titles;
+	realm_statistics de_jure_statistics; //the statistics of the title's de jure territories, including those of its de jure vassal titles
 	metternich::province *capital_province = nullptr;
 	metternich::world *capital_world = nullptr;
 	landed_title *holder_title = nullptr; //title of this title's holder; used only for initialization, and set to null afterwards
@@ -349,6 +374,7 @@ private:
 	std::string flag_tag;
 	std::map<law_group *, law *> laws; //the laws pertaining to the title, mapped to the respective law group
 	bool active_post_amalgamation = false; //whether the title remains active after the amalgamation of its world
+	cached_translation cached_name;
 };
 
 }
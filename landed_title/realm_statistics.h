@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QVariant>
+
+namespace metternich {
+
+//aggregate statistics for a realm or a de jure title, maintained incrementally as their constituent parts change
+struct realm_statistics final
+{
+	realm_statistics operator -() const
+	{
+		realm_statistics result;
+		result.population = -this->population;
+		result.wealth = -this->wealth;
+		result.levies = -this->levies;
+		result.holding_count = -this->holding_count;
+		result.province_count = -this->province_count;
+		return result;
+	}
+
+	realm_statistics &operator +=(const realm_statistics &other)
+	{
+		this->population += other.population;
+		this->wealth += other.wealth;
+		this->levies += other.levies;
+		this->holding_count += other.holding_count;
+		this->province_count += other.province_count;
+		return *this;
+	}
+
+	realm_statistics &operator -=(const realm_statistics &other)
+	{
+		return *this += -other;
+	}
+
+	bool operator ==(const realm_statistics &other) const = default;
+
+	QVariantMap to_qvariant_map() const
+	{
+		QVariantMap map;
+		map["population"] = this->population;
+		map["wealth"] = this->wealth;
+		map["levies"] = this->levies;
+		map["holding_count"] = this->holding_count;
+		map["province_count"] = this->province_count;
+		return map;
+	}
+
+	long long int population = 0;
+	long long int wealth = 0; //the sum of the wealth of characters; not applicable to de jure titles
+	long long int levies = 0;
+	int holding_count = 0;
+	int province_count = 0; //the amount of territories (provinces or worlds) with a county
+};
+
+}
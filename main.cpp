@@ -7,6 +7,8 @@
 #include "economy/trade_node.h"
 #include "game/engine_interface.h"
 #include "game/game.h"
+#include "game/state_hash_log.h"
+#include "history/history.h"
 #include "holding/building.h"
 #include "holding/holding.h"
 #include "holding/holding_slot.h"
@@ -21,19 +23,30 @@
 #include "politics/law.h"
 #include "population/population_type.h"
 #include "population/population_unit.h"
+#include "population/population_unit_view.h"
 #include "religion/religion.h"
 #include "technology/technology.h"
 #include "util/empty_image_provider.h"
 #include "util/exception_util.h"
+#include "util/memory_usage.h"
+#include "util/random.h"
+#include "util/trace.h"
 #include "util/translator.h"
 
 #include "third_party/maskedmousearea/maskedmousearea.h"
 
 #include <QApplication>
+#include <QCoreApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQuickWindow>
 #include <QTranslator>
 
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string_view>
+
 namespace metternich {
 	static void load_data()
 	{
@@ -48,6 +61,144 @@ namespace metternich {
 			QMetaObject::invokeMethod(QApplication::instance(), []{ QApplication::exit(EXIT_FAILURE); }, Qt::QueuedConnection);
 		}
 	}
+
+	struct headless_options final
+	{
+		bool enabled = false;
+		int days = 365;
+		std::filesystem::path trace_filepath;
+		bool memory_report = false;
+		std::filesystem::path load_filepath; //the game snapshot to start from, instead of loading history
+		std::filesystem::path save_filepath; //the file to save a game snapshot to, after the simulated days
+		std::optional<uint64_t> seed; //the seed for the random streams, making the run deterministic
+		std::filesystem::path state_hash_log_filepath;
+		std::filesystem::path compared_state_hash_log_filepaths[2]; //state hash logs to compare, instead of running the simulation
+	};
+
+	static headless_options parse_headless_options(const int argc, char *argv[])
+	{
+		headless_options options;
+
+		for (int i = 1; i < argc; ++i) {
+			const std::string_view argument = argv[i];
+
+			if (argument == "--headless") {
+				options.enabled = true;
+			} else if (argument == "--days" && (i + 1) < argc) {
+				options.days = std::stoi(argv[++i]);
+			} else if (argument == "--trace" && (i + 1) < argc) {
+				options.trace_filepath = argv[++i];
+			} else if (argument == "--memory-report") {
+				options.memory_report = true;
+			} else if (argument == "--load" && (i + 1) < argc) {
+				options.load_filepath = argv[++i];
+			} else if (argument == "--save" && (i + 1) < argc) {
+				options.save_filepath = argv[++i];
+			} else if (argument == "--seed" && (i + 1) < argc) {
+				options.seed = std::stoull(argv[++i]);
+			} else if (argument == "--state-hash-log" && (i + 1) < argc) {
+				options.state_hash_log_filepath = argv[++i];
+			} else if (argument == "--compare-state-hashes" && (i + 2) < argc) {
+				options.compared_state_hash_log_filepaths[0] = argv[++i];
+				options.compared_state_hash_log_filepaths[1] = argv[++i];
+			}
+		}
+
+		return options;
+	}
+
+	static void print_memory_report(const std::string &title)
+	{
+		memory_report report;
+		database::get()->add_memory_usage(report);
+
+		std::cout << title << ":\n";
+		report.print(std::cout);
+		std::cout << "\n";
+	}
+
+	/**
+	**	@brief	Run the simulation without an interface for a given amount of days, as fast as possible
+	**
+	**	@param	options	The headless run options
+	**
+	**	@return	The exit code
+	*/
+	static int run_headless(const headless_options &options)
+	{
+		memory_report::set_transient_data_tracked(options.memory_report);
+
+		if (options.seed.has_value()) {
+			//seed before loading the database, as initialization draws random numbers as well
+			random::seed(options.seed.value());
+		}
+
+		database::get()->load();
+		map::get()->load();
+		database::get()->initialize();
+		map::get()->calculate_cosmic_map_bounding_rect();
+
+		const bool tracing = !options.trace_filepath.empty();
+		if (tracing) {
+#ifndef METTERNICH_TRACING
+			std::cerr << "Tracing was requested, but the instrumentation was not compiled in; define METTERNICH_TRACING to enable it.\n";
+#endif
+			trace::set_enabled(true);
+		}
+
+		if (!options.load_filepath.empty()) {
+			const tick_pacer::clock::time_point load_start_time = tick_pacer::clock::now();
+			game::get()->load(options.load_filepath, true);
+			const std::chrono::milliseconds load_time = std::chrono::duration_cast<std::chrono::milliseconds>(tick_pacer::clock::now() - load_start_time);
+			std::cout << "Loaded game snapshot in " << load_time.count() << " ms.\n";
+		} else {
+			game::get()->start(defines::get()->get_default_timeline(), defines::get()->get_start_date(), true);
+
+			for (const auto &[stage_name, duration] : history::get()->get_load_stage_durations()) {
+				std::cout << "History load stage \"" << stage_name << "\" took " << duration.count() << " ms.\n";
+			}
+		}
+
+		game::get()->set_paused(false);
+
+		if (options.memory_report) {
+			print_memory_report("Memory usage at game start");
+		}
+
+		std::unique_ptr<state_hash_log> state_hash_log;
+		if (!options.state_hash_log_filepath.empty()) {
+			game::get()->set_order_log_enabled(true);
+			state_hash_log = std::make_unique<metternich::state_hash_log>(options.state_hash_log_filepath);
+		}
+
+		const tick_pacer::clock::time_point start_time = tick_pacer::clock::now();
+
+		for (int i = 0; i < options.days; ++i) {
+			game::get()->do_tick();
+
+			if (state_hash_log != nullptr) {
+				state_hash_log->record_tick();
+			}
+		}
+
+		const std::chrono::milliseconds elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(tick_pacer::clock::now() - start_time);
+		std::cout << "Simulated " << options.days << " days in " << elapsed_time.count() << " ms.\n";
+
+		if (tracing) {
+			trace::set_enabled(false);
+			trace::export_chrome_json(options.trace_filepath);
+		}
+
+		if (options.memory_report) {
+			print_memory_report("Memory usage after " + std::to_string(options.days) + " days");
+		}
+
+		if (!options.save_filepath.empty()) {
+			game::get()->save(options.save_filepath);
+		}
+
+		return EXIT_SUCCESS;
+	}
 }
 
 int main(int argc, char *argv[])
@@ -55,6 +206,27 @@ int main(int argc, char *argv[])
 	using namespace metternich;
 
 	try {
+		const headless_options options = parse_headless_options(argc, argv);
+
+		if (!options.compared_state_hash_log_filepaths[0].empty()) {
+			const bool identical = state_hash_log::compare(options.compared_state_hash_log_filepaths[0], options.compared_state_hash_log_filepaths[1], std::cout);
+			return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+
+		if (options.enabled) {
+			QCoreApplication app(argc, argv);
+
+			translator *translator = translator::get();
+			translator->set_locale("english");
+
+			database::get()->process_modules();
+
+			translator->load();
+			app.installTranslator(translator);
+
+			return run_headless(options);
+		}
+
 		QApplication app(argc, argv);
 
 		translator *translator = translator::get();
@@ -83,6 +255,7 @@ int main(int argc, char *argv[])
 		qmlRegisterType<law>();
 		qmlRegisterType<population_type>();
 		qmlRegisterType<population_unit>();
+		qmlRegisterType<population_unit_view>();
 		qmlRegisterType<province>();
 		qmlRegisterType<religion>();
 		qmlRegisterType<technology>();
@@ -98,6 +271,12 @@ int main(int argc, char *argv[])
 			if (!obj && url == objUrl) {
 				QCoreApplication::exit(-1);
 			}
+
+			//the orbits and rotations of worlds are sampled once per rendered frame
+			QQuickWindow *window = qobject_cast<QQuickWindow *>(obj);
+			if (window != nullptr) {
+				QObject::connect(window, &QQuickWindow::frameSwapped, engine_interface::get(), &engine_interface::sample_cosmic_map_kinematics);
+			}
 		}, Qt::QueuedConnection);
 		engine.load(url);
 
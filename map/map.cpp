@@ -10,6 +10,7 @@
 #include "util/filesystem_util.h"
 #include "util/geocoordinate_util.h"
 #include "util/image_util.h"
+#include "util/parallel_util.h"
 #include "util/point_util.h"
 #include "util/vector_util.h"
 
@@ -172,6 +173,13 @@ void map::load()
 
 	map::process_world_geojson_database();
 
+	engine_interface::get()->set_loading_message("Loading Map Rasters...");
+
+	//map or decode the rasters of worlds in parallel, as that doesn't affect any other objects
+	parallel::for_each(world::get_map_worlds(), [](world *world) {
+		world->load_rasters();
+	});
+
 	for (world *world : world::get_map_worlds()) {
 		world->load_terrain_map();
 		world->load_province_map();
@@ -446,6 +454,7 @@ void map::save_geojson_data_to_gsml()
 bool map::check_cache()
 {
 	QCryptographicHash hash(QCryptographicHash::Md5);
+	hash.addData(QByteArray::number(map::cache_version));
 
 	for (const std::filesystem::path &map_path : database::get()->get_map_paths()) {
 		if (!std::filesystem::exists(map_path)) {
@@ -27,6 +27,7 @@ private:
 	static void process_world_geojson_database();
 
 	static constexpr int geocoordinate_precision = 17;
+	static constexpr int cache_version = 2; //increased when the format of the map cache changes, so that existing caches are rebuilt
 	static constexpr int cosmic_map_boundary_offset = 128; //the offset from the celestial body at the cosmic map's boundary for determining its bounding rect
 
 public:
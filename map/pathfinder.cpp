@@ -2,7 +2,9 @@
 
 #include "database/defines.h"
 #include "map/province.h"
+#include "map/province_adjacency.h"
 #include "util/container_util.h"
+#include "util/trace.h"
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/astar_search.hpp>
@@ -17,7 +19,7 @@ class pathfinder::impl
 	using edge = graph::edge_descriptor;
 
 public:
-	impl(const std::set<province *> &provinces);
+	impl(const std::set<province *> &provinces, const province_adjacency &adjacency);
 
 	find_trade_path_result find_trade_path(const province *start_province, const province *goal_province) const;
 
@@ -79,9 +81,9 @@ struct found_goal
 {
 };
 
-pathfinder::pathfinder(const std::set<province *> &provinces)
+pathfinder::pathfinder(const std::set<province *> &provinces, const province_adjacency &adjacency)
 {
-	this->implementation = std::make_unique<impl>(provinces);
+	this->implementation = std::make_unique<impl>(provinces, adjacency);
 }
 
 pathfinder::~pathfinder()
@@ -90,10 +92,13 @@ pathfinder::~pathfinder()
 
 find_trade_path_result pathfinder::find_trade_path(const province *start_province, const province *goal_province) const
 {
+	TRACE_SCOPE("pathfinder::find_trade_path");
+	TRACE_COUNTER(pathfinder_searches, 1);
+
 	return this->implementation->find_trade_path(start_province, goal_province);
 }
 
-pathfinder::impl::impl(const std::set<province *> &provinces)
+pathfinder::impl::impl(const std::set<province *> &provinces, const province_adjacency &adjacency)
 	: provinces(container::to_vector(provinces)), province_graph(provinces.size())
 {
 	for (size_t i = 0; i < this->provinces.size(); ++i) {
@@ -101,11 +106,22 @@ pathfinder::impl::impl(const std::set<province *> &provinces)
 		this->province_to_index[province] = i;
 	}
 
-	for (province *province : this->provinces) {
-		for (metternich::province *border_province : province->get_border_provinces()) {
-			edge e;
-			bool inserted;
-			boost::tie(e, inserted) = boost::add_edge(this->province_to_index[province], this->province_to_index[border_province], this->province_graph);
+	for (const province *province : this->provinces) {
+		const size_t province_index = this->province_to_index[province];
+
+		for (const province_adjacency::edge &adjacency_edge : adjacency.get_edges(province)) {
+			if (adjacency_edge.river_crossing) {
+				continue; //trade paths go through river provinces, rather than across them
+			}
+
+			const size_t border_province_index = this->province_to_index[adjacency_edge.province];
+
+			//the graph is undirected, while the adjacency has each edge in both directions
+			if (border_province_index < province_index) {
+				continue;
+			}
+
+			boost::add_edge(province_index, border_province_index, this->province_graph);
 		}
 	}
 }
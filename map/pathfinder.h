@@ -7,6 +7,7 @@ namespace metternich {
 
 class pathfinder_implementation;
 class province;
+class province_adjacency;
 
 struct find_trade_path_result
 {
@@ -23,7 +24,7 @@ class pathfinder
 	class impl;
 
 public:
-	pathfinder(const std::set<province *> &provinces);
+	pathfinder(const std::set<province *> &provinces, const province_adjacency &adjacency);
 	~pathfinder();
 
 	find_trade_path_result find_trade_path(const province *start_province, const province *goal_province) const;
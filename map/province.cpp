@@ -23,8 +23,10 @@
 #include "religion/religion_group.h"
 #include "script/modifier.h"
 #include "species/wildlife_unit.h"
+#include "technology/technology.h"
 #include "util/container_util.h"
 #include "util/geocoordinate_util.h"
+#include "util/memory_usage.h"
 #include "util/point_util.h"
 #include "util/rect_util.h"
 
@@ -98,16 +100,6 @@ void province::process_gsml_scope(const gsml_data &scope)
 			}
 			this->geopaths.push_back(std::move(geopath));
 		});
-	} else if (tag == "border_provinces") {
-		for (const std::string &border_province_identifier : scope.get_values()) {
-			province *border_province = province::get(border_province_identifier);
-			this->border_provinces.insert(border_province);
-		}
-	} else if (tag == "river_crossings") {
-		for (const std::string &border_province_identifier : scope.get_values()) {
-			province *border_province = province::get(border_province_identifier);
-			this->river_crossings.insert(border_province);
-		}
 	} else if (tag == "path_pos_map") {
 		scope.for_each_child([&](const gsml_data &pos_list_data) {
 			const province *other_province = province::get(pos_list_data.get_tag());
@@ -209,21 +201,40 @@ void province::check_history() const
 	territory::check_history();
 }
 
-gsml_data province::get_cache_data() const
+void province::add_owned_memory_usage(memory_usage &usage, memory_report &report) const
 {
-	gsml_data cache_data(this->get_identifier());
+	territory::add_owned_memory_usage(usage, report);
+
+	usage.add_tree(this->border_provinces);
+	usage.add_tree(this->river_crossings);
+	usage.add_tree(this->trade_routes);
+	usage.add_tree(this->active_trade_routes);
 
-	gsml_data border_provinces("border_provinces");
-	for (const province *province : this->border_provinces) {
-		border_provinces.add_value(province->get_identifier());
+	usage.add_tree(this->path_pos_map);
+	for (const auto &kv_pair : this->path_pos_map) {
+		usage.add_vector(kv_pair.second);
 	}
-	cache_data.add_child(std::move(border_provinces));
 
-	gsml_data river_crossings("river_crossings");
-	for (const province *province : this->river_crossings) {
-		river_crossings.add_value(province->get_identifier());
+	usage.add_vector(this->wildlife_units);
+	for (const qunique_ptr<wildlife_unit> &wildlife_unit : this->wildlife_units) {
+		report.add_instance(wildlife_unit.get(), "wildlife_unit");
 	}
-	cache_data.add_child(std::move(river_crossings));
+
+	usage.add_vector(this->technology_progress);
+	usage.add_vector(this->geopolygons);
+	for (const QGeoPolygon &geopolygon : this->geopolygons) {
+		report.get_usage("geopolygon").add_geopolygon(geopolygon);
+	}
+
+	usage.add_vector(this->geopaths);
+	for (const QGeoPath &geopath : this->geopaths) {
+		report.get_usage("geopath").add_geopath(geopath);
+	}
+}
+
+gsml_data province::get_cache_data() const
+{
+	gsml_data cache_data(this->get_identifier());
 
 	if (!this->path_pos_map.empty()) {
 		gsml_data path_pos_map_data("path_pos_map");
@@ -334,35 +345,33 @@ void province::calculate_trade_node()
 
 std::pair<trade_node *, int> province::get_best_trade_node_from_list(const std::set<metternich::trade_node *> &trade_nodes) const
 {
-	std::vector<metternich::trade_node *> sorted_trade_nodes = container::to_vector(trade_nodes);
-
-	std::sort(sorted_trade_nodes.begin(), sorted_trade_nodes.end(), [this](const metternich::trade_node *a, const metternich::trade_node *b) {
-		return this->get_kilometers_distance_to(a->get_center_of_trade()) < this->get_kilometers_distance_to(b->get_center_of_trade());
-	});
-
 	metternich::trade_node *best_node = nullptr;
 	int best_score = 0; //smaller is better
 	int best_trade_cost = 0;
 
-	for (metternich::trade_node *node : sorted_trade_nodes) {
-		if (node->get_world() != this->get_world()) {
-			continue;
+	//visit the world's provinces in order of distance, so that the search can stop as soon as the minimum trade cost to a center of trade is no better than the best score found so far, as it can only increase for farther centers of trade
+	this->get_world()->get_province_index().for_each_nearest(this->get_center_geocoordinate(), [&](province *center_of_trade, const double meters_distance) {
+		if (!center_of_trade->is_center_of_trade()) {
+			return true;
 		}
 
-		province *center_of_trade = node->get_center_of_trade();
+		metternich::trade_node *node = center_of_trade->get_trade_node();
+		if (!trade_nodes.contains(node)) {
+			return true;
+		}
 
 		//the minimum, best-case trade cost that will be incurred between this province and the center of trade
-		const int distance = this->get_kilometers_distance_to(center_of_trade);
+		const int distance = static_cast<int>(static_cast<long long int>(meters_distance) / 1000);
 		const int minimum_trade_cost = distance * 100 / province::base_distance * defines::get()->get_trade_cost_modifier_per_distance() / 100;
 
 		if (best_node != nullptr && minimum_trade_cost >= best_score) {
-			continue;
+			return false;
 		}
 
 		const pathfinder *pathfinder = this->get_world()->get_pathfinder();
 		const find_trade_path_result result = pathfinder->find_trade_path(this, center_of_trade);
 		if (!result.success) {
-			continue;
+			return true;
 		}
 
 		int score = result.trade_cost; //smaller is better
@@ -399,7 +408,9 @@ std::pair<trade_node *, int> province::get_best_trade_node_from_list(const std::
 			best_score = score;
 			best_trade_cost = result.trade_cost;
 		}
-	}
+
+		return true;
+	});
 
 	return std::make_pair(best_node, best_trade_cost);
 }
@@ -700,6 +711,10 @@ void province::set_terrain(metternich::terrain_type *terrain)
 		}
 	}
 
+	for (province *border_province : this->border_provinces) {
+		border_province->calculate_border_flags();
+	}
+
 	emit terrain_changed();
 }
 
@@ -872,42 +887,33 @@ void province::remove_empty_wildlife_units()
 	}
 }
 
-bool province::borders_water() const
-{
-	for (const province *border_province : this->border_provinces) {
-		if (border_province->is_water()) {
-			return true;
-		}
-	}
-
-	return false;
-}
-
-bool province::borders_river() const
-{
-	for (const province *border_province : this->border_provinces) {
-		if (border_province->is_river()) {
-			return true;
-		}
-	}
-
-	return false;
-}
-
 bool province::has_river() const
 {
 	return this->has_inner_river() || this->borders_river();
 }
 
-bool province::is_coastal() const
+/**
+**	@brief	Calculate whether the province borders ocean, water or river provinces, which is cached as it is checked often, while border provinces and their terrain seldom change after the map is loaded
+*/
+void province::calculate_border_flags()
 {
+	this->coastal = false;
+	this->water_bordering = false;
+	this->river_bordering = false;
+
 	for (const province *border_province : this->border_provinces) {
 		if (border_province->is_ocean()) {
-			return true;
+			this->coastal = true;
 		}
-	}
 
-	return false;
+		if (border_province->is_water()) {
+			this->water_bordering = true;
+		}
+
+		if (border_province->is_river()) {
+			this->river_bordering = true;
+		}
+	}
 }
 
 bool province::is_water() const
@@ -930,6 +936,43 @@ bool province::is_center_of_trade() const
 	return this->get_trade_node() != nullptr && this->get_trade_node()->get_center_of_trade() == this;
 }
 
+int province::get_technology_progress(const technology *technology) const
+{
+	if (technology->get_index() >= this->technology_progress.size()) {
+		return 0;
+	}
+
+	return this->technology_progress[technology->get_index()];
+}
+
+/**
+**	@brief	Change the province's diffusion progress towards acquiring a technology
+**
+**	@param	technology	The technology
+**	@param	change		The change in progress
+**
+**	@return	The new progress
+*/
+int province::change_technology_progress(const technology *technology, const int change)
+{
+	if (this->technology_progress.empty()) {
+		if (change == 0) {
+			return 0;
+		}
+
+		this->technology_progress.resize(metternich::technology::get_index_count(), 0);
+	}
+
+	int &progress = this->technology_progress.at(technology->get_index());
+	progress += change;
+	return progress;
+}
+
+void province::set_technology_progress(std::vector<int> &&technology_progress)
+{
+	this->technology_progress = std::move(technology_progress);
+}
+
 void province::add_active_trade_route(trade_route *route)
 {
 	this->active_trade_routes.insert(route);
@@ -22,6 +22,7 @@
 namespace metternich {
 
 class population_unit;
+class technology;
 class terrain_type;
 class trade_node;
 class trade_route;
@@ -82,6 +83,7 @@ public:
 	virtual void initialize_history() override;
 	virtual void check() const override;
 	virtual void check_history() const override;
+	virtual void add_owned_memory_usage(memory_usage &usage, memory_report &report) const override;
 	virtual gsml_data get_cache_data() const override;
 
 	virtual void do_month() override final;
@@ -186,8 +188,15 @@ public:
 		this->border_provinces.insert(province);
 	}
 
-	bool borders_water() const;
-	bool borders_river() const;
+	bool borders_water() const
+	{
+		return this->water_bordering;
+	}
+
+	bool borders_river() const
+	{
+		return this->river_bordering;
+	}
 
 	bool has_river_crossing_with(province *other_province) const
 	{
@@ -216,7 +225,13 @@ public:
 		this->inner_river = inner_river;
 	}
 
-	bool is_coastal() const;
+	bool is_coastal() const
+	{
+		return this->coastal;
+	}
+
+	void calculate_border_flags();
+
 	bool is_water() const;
 	bool is_ocean() const;
 	bool is_river() const;
@@ -261,6 +276,15 @@ public:
 		return this->trade_routes;
 	}
 
+	const std::vector<int> &get_technology_progress() const
+	{
+		return this->technology_progress;
+	}
+
+	int get_technology_progress(const technology *technology) const;
+	int change_technology_progress(const technology *technology, const int change);
+	void set_technology_progress(std::vector<int> &&technology_progress);
+
 	bool has_any_trade_route() const
 	{
 		return !this->trade_routes.empty();
@@ -453,10 +477,14 @@ private:
 	std::set<trade_route *> active_trade_routes; //the active trade routes going through the province
 	int trade_node_trade_cost = 0;
 	std::vector<qunique_ptr<wildlife_unit>> wildlife_units; //wildlife units set for this province in history
+	std::vector<int> technology_progress; //the progress towards acquiring each technology through diffusion, by technology index; empty if there is no progress
 	std::map<const province *, std::vector<QPointF>> path_pos_map; //lists of the path positions for the paths between this province and its border provinces
 	std::vector<QGeoPolygon> geopolygons;
 	std::vector<QGeoPath> geopaths;
 	bool inner_river = false; //whether the province has a minor river flowing through it
+	bool coastal = false; //whether the province borders an ocean province
+	bool water_bordering = false; //whether the province borders a water province
+	bool river_bordering = false; //whether the province borders a river province
 	bool selected = false;
 	bool always_write_geodata = false;
 	bool write_geojson_value = false;
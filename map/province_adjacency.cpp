@@ -0,0 +1,313 @@
+#include "map/province_adjacency.h"
+
+#include "map/province.h"
+#include "util/binary_stream.h"
+#include "util/indexed_raster.h"
+#include "util/memory_usage.h"
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace metternich {
+
+static bool compare_province_indices(const province *province, const metternich::province *other_province)
+{
+	return province->get_index() < other_province->get_index();
+}
+
+std::span<const province_adjacency::edge> province_adjacency::get_edges(const province *province) const
+{
+	const auto find_iterator = std::lower_bound(this->provinces.begin(), this->provinces.end(), province, compare_province_indices);
+	if (find_iterator == this->provinces.end() || *find_iterator != province) {
+		return {};
+	}
+
+	const size_t province_index = static_cast<size_t>(find_iterator - this->provinces.begin());
+	return std::span<const edge>(this->edges.data() + this->offsets[province_index], this->edges.data() + this->offsets[province_index + 1]);
+}
+
+uint32_t province_adjacency::get_border_length(const province *province, const metternich::province *other_province) const
+{
+	for (const edge &edge : this->get_edges(province)) {
+		if (edge.province == other_province) {
+			return edge.border_length;
+		}
+	}
+
+	return 0;
+}
+
+/**
+**	@brief	Build the graph from a province raster, replacing its previous contents
+**
+**	@param	raster	The province raster, whose elements must have been resolved
+*/
+void province_adjacency::build(const indexed_raster<province> &raster)
+{
+	//count the pixel sides shared by each pair of palette indices, with the lower index first
+	std::unordered_map<uint32_t, uint32_t> border_lengths;
+
+	const auto add_border_pixel = [&raster, &border_lengths](const uint16_t index, const uint16_t other_index) {
+		if (index == other_index || raster.get_element(other_index) == nullptr) {
+			return;
+		}
+
+		const uint32_t key = index < other_index ? (static_cast<uint32_t>(index) << 16 | other_index) : (static_cast<uint32_t>(other_index) << 16 | index);
+		++border_lengths[key];
+	};
+
+	const int width = raster.get_width();
+	const int pixel_count = raster.get_pixel_count();
+
+	for (int i = 0; i < pixel_count; ++i) {
+		const uint16_t index = raster.get_index(i);
+		if (raster.get_element(index) == nullptr) {
+			continue;
+		}
+
+		if ((i % width) != 0) {
+			add_border_pixel(index, raster.get_index(i - 1));
+		}
+
+		if (i >= width) {
+			add_border_pixel(index, raster.get_index(i - width));
+		}
+	}
+
+	std::vector<std::pair<std::pair<province *, province *>, edge>> province_edges;
+	province_edges.reserve(border_lengths.size() * 2);
+
+	for (const auto &[key, border_length] : border_lengths) {
+		province *province = raster.get_element(static_cast<uint16_t>(key >> 16));
+		metternich::province *other_province = raster.get_element(static_cast<uint16_t>(key & 0xFFFF));
+
+		province_edges.push_back({ { province, other_province }, { other_province, border_length, false } });
+		province_edges.push_back({ { other_province, province }, { province, border_length, false } });
+	}
+
+	this->set_edges(std::move(province_edges));
+}
+
+/**
+**	@brief	Add river crossing edges to the graph, between the land provinces bordering the same river province which don't border each other directly
+**
+**	The terrain of provinces must have been set before this is called.
+*/
+void province_adjacency::add_river_crossings()
+{
+	std::vector<std::pair<std::pair<province *, province *>, edge>> province_edges;
+
+	for (size_t i = 0; i < this->provinces.size(); ++i) {
+		for (size_t j = this->offsets[i]; j < this->offsets[i + 1]; ++j) {
+			province_edges.push_back({ { this->provinces[i], this->edges[j].province }, this->edges[j] });
+		}
+	}
+
+	std::set<std::pair<province *, province *>> river_crossings;
+
+	for (size_t i = 0; i < this->provinces.size(); ++i) {
+		if (!this->provinces[i]->is_river()) {
+			continue;
+		}
+
+		for (size_t j = this->offsets[i]; j < this->offsets[i + 1]; ++j) {
+			province *border_province = this->edges[j].province;
+			if (border_province->is_water()) {
+				continue;
+			}
+
+			for (size_t k = this->offsets[i]; k < this->offsets[i + 1]; ++k) {
+				province *other_border_province = this->edges[k].province;
+				if (other_border_province == border_province || other_border_province->is_water()) {
+					continue;
+				}
+
+				if (this->get_border_length(border_province, other_border_province) > 0) {
+					continue; //already borders the other province directly
+				}
+
+				if (river_crossings.insert({ border_province, other_border_province }).second) {
+					province_edges.push_back({ { border_province, other_border_province }, { other_border_province, 0, true } });
+				}
+			}
+		}
+	}
+
+	this->set_edges(std::move(province_edges));
+}
+
+/**
+**	@brief	Load the graph from a file saved to the map cache
+**
+**	@param	filepath	The path of the file
+**
+**	@return	True if the graph was loaded, or false if the file doesn't exist or is outdated
+*/
+bool province_adjacency::load(const std::filesystem::path &filepath)
+{
+	if (!std::filesystem::exists(filepath)) {
+		return false;
+	}
+
+	std::ifstream ifstream(filepath, std::ios::binary);
+	if (!ifstream) {
+		throw std::runtime_error("Failed to open file \"" + filepath.string() + "\".");
+	}
+
+	binary_reader reader(ifstream);
+	if (reader.read<uint32_t>() != province_adjacency::magic || reader.read<uint32_t>() != province_adjacency::version) {
+		return false;
+	}
+
+	std::vector<province *> provinces(reader.read<uint32_t>());
+	for (province *&province : provinces) {
+		province = metternich::province::try_get(reader.read_string());
+		if (province == nullptr) {
+			return false; //the cache refers to a province which no longer exists
+		}
+	}
+
+	const std::vector<uint32_t> offsets = reader.read_vector<uint32_t>();
+	const std::vector<uint32_t> neighbors = reader.read_vector<uint32_t>();
+	const std::vector<uint32_t> border_lengths = reader.read_vector<uint32_t>();
+
+	if (offsets.size() != provinces.size() + 1 || neighbors.size() != border_lengths.size()) {
+		throw std::runtime_error("Invalid province adjacency file \"" + filepath.string() + "\".");
+	}
+
+	std::vector<std::pair<std::pair<province *, province *>, edge>> province_edges;
+	province_edges.reserve(neighbors.size());
+
+	for (size_t i = 0; i < provinces.size(); ++i) {
+		for (size_t j = offsets[i]; j < offsets[i + 1]; ++j) {
+			province *border_province = provinces.at(neighbors.at(j));
+			province_edges.push_back({ { provinces[i], border_province }, { border_province, border_lengths[j], false } });
+		}
+	}
+
+	//the indices of provinces may have changed since the file was saved, so the graph is sorted again
+	this->set_edges(std::move(province_edges));
+
+	return true;
+}
+
+/**
+**	@brief	Save the graph's borders to a file in the map cache, without its river crossings
+**
+**	@param	filepath	The path of the file
+*/
+void province_adjacency::save(const std::filesystem::path &filepath) const
+{
+	std::ofstream ofstream(filepath, std::ios::binary | std::ios::trunc);
+	if (!ofstream) {
+		throw std::runtime_error("Failed to open file \"" + filepath.string() + "\" for writing.");
+	}
+
+	binary_writer writer(ofstream);
+	writer.write<uint32_t>(province_adjacency::magic);
+	writer.write<uint32_t>(province_adjacency::version);
+
+	writer.write<uint32_t>(static_cast<uint32_t>(this->provinces.size()));
+	for (const province *province : this->provinces) {
+		writer.write_string(province->get_identifier());
+	}
+
+	std::vector<uint32_t> offsets;
+	std::vector<uint32_t> neighbors;
+	std::vector<uint32_t> border_lengths;
+	offsets.reserve(this->offsets.size());
+	neighbors.reserve(this->edges.size());
+	border_lengths.reserve(this->edges.size());
+
+	for (size_t i = 0; i < this->provinces.size(); ++i) {
+		offsets.push_back(static_cast<uint32_t>(neighbors.size()));
+
+		for (size_t j = this->offsets[i]; j < this->offsets[i + 1]; ++j) {
+			const edge &edge = this->edges[j];
+			if (edge.river_crossing) {
+				continue;
+			}
+
+			const auto find_iterator = std::lower_bound(this->provinces.begin(), this->provinces.end(), edge.province, compare_province_indices);
+			neighbors.push_back(static_cast<uint32_t>(find_iterator - this->provinces.begin()));
+			border_lengths.push_back(edge.border_length);
+		}
+	}
+
+	offsets.push_back(static_cast<uint32_t>(neighbors.size()));
+
+	writer.write_vector(offsets);
+	writer.write_vector(neighbors);
+	writer.write_vector(border_lengths);
+
+	if (!ofstream) {
+		throw std::runtime_error("Failed to write province adjacency file \"" + filepath.string() + "\".");
+	}
+}
+
+/**
+**	@brief	Set the border provinces and river crossings of the graph's provinces from its edges
+*/
+void province_adjacency::apply() const
+{
+	for (size_t i = 0; i < this->provinces.size(); ++i) {
+		province *province = this->provinces[i];
+
+		for (size_t j = this->offsets[i]; j < this->offsets[i + 1]; ++j) {
+			const edge &edge = this->edges[j];
+
+			if (edge.river_crossing) {
+				province->add_river_crossing(edge.province);
+			} else {
+				province->add_border_province(edge.province);
+			}
+		}
+	}
+}
+
+void province_adjacency::add_memory_usage(memory_usage &usage) const
+{
+	usage.add_vector(this->provinces);
+	usage.add_vector(this->offsets);
+	usage.add_vector(this->edges);
+}
+
+/**
+**	@brief	Set the graph's edges, replacing its previous contents
+**
+**	@param	province_edges	The edges, each with the pair of provinces it goes from and to; each edge must be present in both directions
+*/
+void province_adjacency::set_edges(std::vector<std::pair<std::pair<province *, province *>, edge>> &&province_edges)
+{
+	std::sort(province_edges.begin(), province_edges.end(), [](const auto &a, const auto &b) {
+		if (a.first.first != b.first.first) {
+			return compare_province_indices(a.first.first, b.first.first);
+		}
+
+		return compare_province_indices(a.first.second, b.first.second);
+	});
+
+	this->provinces.clear();
+	this->offsets.clear();
+	this->edges.clear();
+	this->edges.reserve(province_edges.size());
+
+	for (const auto &[province_pair, edge] : province_edges) {
+		if (this->provinces.empty() || this->provinces.back() != province_pair.first) {
+			this->provinces.push_back(province_pair.first);
+			this->offsets.push_back(static_cast<uint32_t>(this->edges.size()));
+		}
+
+		this->edges.push_back(edge);
+	}
+
+	this->offsets.push_back(static_cast<uint32_t>(this->edges.size()));
+
+	province_edges.clear();
+}
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace metternich {
+
+class memory_usage;
+class province;
+
+template <typename T>
+class indexed_raster;
+
+/**
+**	@brief	The adjacency graph of a world's provinces
+**
+**	The graph is stored in a compressed sparse row format: the edges of each province are contiguous, and each edge is stored once per direction. Edges keep the length of the border shared by the provinces, in pixel sides, and whether the provinces are connected by crossing a major river. The borders are built from the province raster when the map cache is created, and saved to the cache, so that they can be loaded directly afterwards. River crossings depend on the terrain of provinces, which isn't covered by the cache, so they are not saved, but added after the terrain of provinces has been calculated every time the map is loaded.
+*/
+class province_adjacency final
+{
+public:
+	static constexpr uint32_t magic = 0x4150544D; //"MTPA"
+	static constexpr uint32_t version = 2;
+
+	struct edge final
+	{
+		metternich::province *province = nullptr;
+		uint32_t border_length = 0; //the amount of pixel sides shared by the provinces, which is 0 if they are connected only by a river crossing
+		bool river_crossing = false;
+	};
+
+	bool empty() const
+	{
+		return this->provinces.empty();
+	}
+
+	const std::vector<province *> &get_provinces() const
+	{
+		return this->provinces;
+	}
+
+	std::span<const edge> get_edges(const province *province) const;
+	uint32_t get_border_length(const province *province, const metternich::province *other_province) const;
+
+	void build(const indexed_raster<province> &raster);
+	void add_river_crossings();
+	bool load(const std::filesystem::path &filepath);
+	void save(const std::filesystem::path &filepath) const;
+	void apply() const;
+	void add_memory_usage(memory_usage &usage) const;
+
+private:
+	void set_edges(std::vector<std::pair<std::pair<province *, province *>, edge>> &&province_edges);
+
+private:
+	std::vector<province *> provinces; //the provinces with any edges, sorted by index
+	std::vector<uint32_t> offsets; //the position of the first edge of each province, followed by the total amount of edges
+	std::vector<edge> edges;
+};
+
+}
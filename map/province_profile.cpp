@@ -69,7 +69,7 @@ province *province_profile::get_province()
 		throw std::runtime_error("No provinces fulfill the condition for province profile \"" + this->get_identifier() + "\".");
 	}
 
-	this->province = vector::get_random(potential_provinces);
+	this->province = vector::get_random(potential_provinces, random_stream::map);
 	return this->province;
 }
 
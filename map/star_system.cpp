@@ -30,11 +30,21 @@ void star_system::calculate_territory_polygons()
 
 	engine_interface::get()->set_loading_message("Calculating Star System Territories...");
 
+	star_system::territory_grid.clear();
+	for (star_system *system : systems) {
+		star_system::territory_grid[star_system::get_territory_grid_cell(system->get_center_pos())].push_back(system);
+	}
+
 	for (star_system *system : systems) {
 		system->calculate_territory_polygon();
 	}
 }
 
+std::pair<int, int> star_system::get_territory_grid_cell(const QPointF &pos)
+{
+	return std::make_pair(static_cast<int>(std::floor(pos.x() / star_system::territory_grid_cell_size)), static_cast<int>(std::floor(pos.y() / star_system::territory_grid_cell_size)));
+}
+
 star_system::star_system(const std::string &identifier) : data_entry(identifier)
 {
 	connect(this, &star_system::culture_changed, this, &identifiable_data_entry_base::name_changed);
@@ -284,132 +294,71 @@ QVariantList star_system::get_territory_polygon_qvariant_list() const
 
 void star_system::calculate_territory_polygon()
 {
-	//create a polygon representing the star system's territory
-
-	std::vector<star_system *> systems = star_system::get_all();
+	//create a polygon representing the star system's territory: the part of the territory circle which is nearer to this system than to any other, i.e. the system's Voronoi cell clipped to the territory radius; since both are convex, it can be built by clipping the circle with the half-plane delimited by the bisector between this system and each of its neighbors
 
-	//sort systems by distance to this one
 	const QPointF center_pos = this->get_center_pos();
-	std::sort(systems.begin(), systems.end(), [&center_pos](const star_system *a, const star_system *b) {
-		const QPointF a_center_pos = a->get_center_pos();
-		const QPointF b_center_pos = b->get_center_pos();
-		const double a_distance = point::distance_to(a_center_pos, center_pos);
-		const double b_distance = point::distance_to(b_center_pos, center_pos);
-		return a_distance < b_distance;
-	});
+	QPolygonF polygon = polygon::from_radius(star_system::territory_radius, 1, center_pos);
 
-	const QRectF &map_rect = map::get()->get_cosmic_map_bounding_rect();
-	const QLineF map_top(map_rect.topLeft(), map_rect.topRight());
-	const QLineF map_bottom(map_rect.bottomLeft(), map_rect.bottomRight());
-	const QLineF map_left(map_rect.topLeft(), map_rect.bottomLeft());
-	const QLineF map_right(map_rect.topRight(), map_rect.bottomRight());
-
-	const double territory_radius = star_system::territory_radius;
-	this->territory_polygon = polygon::from_radius(territory_radius, 1, this->get_center_pos());
+	for (const star_system *system : this->get_territory_neighbors()) {
+		const QPointF other_center_pos = system->get_center_pos();
 
-	for (const star_system *system : systems) {
-		if (system == this) {
+		if (other_center_pos == center_pos) {
+			qWarning() << QString::fromStdString("Star systems \"" + this->get_identifier() + "\" and \"" + system->get_identifier() + "\" have the same position, and so no territory border can be drawn between them.");
 			continue;
 		}
 
-		const QPointF other_center_pos = system->get_center_pos();
+		const QPointF middle_pos = (center_pos + other_center_pos) / 2;
+		polygon = polygon::clip_to_half_plane(polygon, middle_pos, other_center_pos - center_pos);
+	}
 
-		const QPointF middle_pos((center_pos.x() + other_center_pos.x()) / 2, (center_pos.y() + other_center_pos.y()) / 2);
+	//keep the territory polygon within the boundaries of the map
+	const QRectF &map_rect = map::get()->get_cosmic_map_bounding_rect();
+	polygon = polygon::clip_to_half_plane(polygon, map_rect.topLeft(), QPointF(-1, 0));
+	polygon = polygon::clip_to_half_plane(polygon, map_rect.topLeft(), QPointF(0, -1));
+	polygon = polygon::clip_to_half_plane(polygon, map_rect.bottomRight(), QPointF(1, 0));
+	polygon = polygon::clip_to_half_plane(polygon, map_rect.bottomRight(), QPointF(0, 1));
 
-		QLineF line(middle_pos, center_pos);
-		line = line.normalVector();
-		line.setLength(std::max(map_rect.width(), map_rect.height()) * 2);
-		line = QLineF(line.p2(), line.p1());
-		line.setLength(line.length() * 2);
+	if (!polygon.isEmpty()) {
+		polygon.append(polygon.front()); //close the polygon
+	}
 
-		QPolygonF adj_polygon;
+	this->territory_polygon = polygon;
+}
 
-		QPointF intersection_point;
-		bool top_intersection = false;
-		bool bottom_intersection = false;
-		bool left_intersection = false;
-		bool right_intersection = false;
+/**
+**	@brief	Get the star systems near enough to this one for their territories to border each other
+**
+**	@return	The star systems within twice the territory radius of this one
+*/
+std::vector<star_system *> star_system::get_territory_neighbors() const
+{
+	std::vector<star_system *> neighbors;
 
-		if (line.intersects(map_top, &intersection_point) == QLineF::BoundedIntersection) {
-			top_intersection = true;
-			adj_polygon.append(intersection_point);
-		}
-		if (line.intersects(map_bottom, &intersection_point) == QLineF::BoundedIntersection) {
-			bottom_intersection = true;
-			adj_polygon.append(intersection_point);
-		}
-		if (line.intersects(map_left, &intersection_point) == QLineF::BoundedIntersection) {
-			left_intersection = true;
-			adj_polygon.append(intersection_point);
-		}
-		if (line.intersects(map_right, &intersection_point) == QLineF::BoundedIntersection) {
-			right_intersection = true;
-			adj_polygon.append(intersection_point);
-		}
+	const QPointF center_pos = this->get_center_pos();
+	const std::pair<int, int> grid_cell = star_system::get_territory_grid_cell(center_pos);
 
-		if (top_intersection && bottom_intersection) {
-			if (center_pos.x() < other_center_pos.x()) {
-				adj_polygon.append(map_rect.bottomRight());
-				adj_polygon.append(map_rect.topRight());
-			} else {
-				adj_polygon.append(map_rect.bottomLeft());
-				adj_polygon.append(map_rect.topLeft());
-			}
-		} else if (left_intersection && right_intersection) {
-			if (center_pos.y() < other_center_pos.y()) {
-				adj_polygon.append(map_rect.bottomRight());
-				adj_polygon.append(map_rect.bottomLeft());
-			} else {
-				adj_polygon.append(map_rect.topRight());
-				adj_polygon.append(map_rect.topLeft());
-			}
-		} else if (top_intersection && left_intersection) {
-			if (center_pos.x() < other_center_pos.x()) {
-				adj_polygon.append(map_rect.bottomLeft());
-				adj_polygon.append(map_rect.bottomRight());
-				adj_polygon.append(map_rect.topRight());
-			} else {
-				adj_polygon.append(map_rect.topLeft());
-			}
-		} else if (top_intersection && right_intersection) {
-			if (center_pos.x() < other_center_pos.x()) {
-				adj_polygon.append(map_rect.topRight());
-			} else {
-				adj_polygon.append(map_rect.bottomRight());
-				adj_polygon.append(map_rect.bottomLeft());
-				adj_polygon.append(map_rect.topLeft());
+	for (int x = grid_cell.first - 1; x <= grid_cell.first + 1; ++x) {
+		for (int y = grid_cell.second - 1; y <= grid_cell.second + 1; ++y) {
+			const auto find_iterator = star_system::territory_grid.find(std::make_pair(x, y));
+			if (find_iterator == star_system::territory_grid.end()) {
+				continue;
 			}
-		} else if (bottom_intersection && left_intersection) {
-			if (center_pos.x() < other_center_pos.x()) {
-				adj_polygon.append(map_rect.topLeft());
-				adj_polygon.append(map_rect.topRight());
-				adj_polygon.append(map_rect.bottomRight());
-			} else {
-				adj_polygon.append(map_rect.bottomLeft());
-			}
-		} else if (bottom_intersection && right_intersection) {
-			if (center_pos.x() < other_center_pos.x()) {
-				adj_polygon.append(map_rect.bottomRight());
-			} else {
-				adj_polygon.append(map_rect.topRight());
-				adj_polygon.append(map_rect.topLeft());
-				adj_polygon.append(map_rect.bottomLeft());
-			}
-		} else {
-			qWarning() << QString::fromStdString("The territory border line between star systems \"" + this->get_identifier() + "\" and \"" + system->get_identifier() + "\" has an invalid set of intersections with the map boundaries.");
-		}
 
-		adj_polygon.append(adj_polygon.front());  //close the polygon
+			for (star_system *system : find_iterator->second) {
+				if (system == this) {
+					continue;
+				}
 
-		if (this->territory_polygon.intersects(adj_polygon)) {
-			this->territory_polygon = this->territory_polygon.subtracted(adj_polygon);
-		}
+				if (point::distance_to(system->get_center_pos(), center_pos) >= star_system::territory_grid_cell_size) {
+					continue;
+				}
 
-		//keep the territory polygon within the boundaries of the map
-		if (!map_rect.contains(this->territory_polygon.boundingRect())) {
-			this->territory_polygon = this->territory_polygon.intersected(map_rect);
+				neighbors.push_back(system);
+			}
 		}
 	}
+
+	return neighbors;
 }
 
 QVariantList star_system::get_worlds_qvariant_list() const
@@ -5,6 +5,10 @@
 
 #include <QPolygonF>
 
+#include <map>
+#include <utility>
+#include <vector>
+
 namespace metternich {
 
 class character;
@@ -37,9 +41,17 @@ public:
 	static constexpr const char *database_folder = "star_systems";
 	static inline const QColor empty_color = QColor("#f5f5dc");
 	static constexpr int territory_radius = 1280; //the radius for the system's territory
+	static constexpr int territory_grid_cell_size = star_system::territory_radius * 2; //systems farther apart than twice the territory radius cannot border each other
 
 	static void calculate_territory_polygons();
 
+private:
+	static std::pair<int, int> get_territory_grid_cell(const QPointF &pos);
+
+	static inline std::map<std::pair<int, int>, std::vector<star_system *>> territory_grid; //the star systems in each cell of the cosmic map, by their center position
+
+public:
+
 	star_system(const std::string &identifier);
 
 	virtual void initialize() override;
@@ -105,6 +117,7 @@ public:
 	}
 
 	void calculate_territory_polygon();
+	std::vector<star_system *> get_territory_neighbors() const;
 
 	const std::vector<world *> &get_worlds() const
 	{
@@ -1,5 +1,6 @@
 #include "map/territory.h"
 
+#include "character/character.h"
 #include "culture/culture.h"
 #include "culture/culture_group.h"
 #include "culture/culture_supergroup.h"
@@ -23,20 +24,46 @@
 #include "technology/technology_slot.h"
 #include "util/container_util.h"
 #include "util/map_util.h"
+#include "util/memory_usage.h"
 #include "util/translator.h"
 #include "util/vector_util.h"
 
 namespace metternich {
 
+/**
+**	@brief	Update the technology slots of territories whose technologies, or the results of whose technology condition checks, have changed since the last update
+*/
+void territory::update_pending_technology_slots()
+{
+	//updating slots can make technologies unavailable, and thus change technologies, so territories can be queued again while the queue is processed
+	while (!territory::technology_slot_update_queue.empty()) {
+		const std::vector<territory *> territories = std::move(territory::technology_slot_update_queue);
+		territory::technology_slot_update_queue.clear();
+
+		for (territory *territory : territories) {
+			territory->update_technology_slots();
+		}
+	}
+}
+
 territory::territory(const std::string &identifier) : data_entry(identifier)
 {
-	connect(this, &territory::culture_changed, this, &identifiable_data_entry_base::name_changed);
-	connect(this, &territory::religion_changed, this, &identifiable_data_entry_base::name_changed);
+	connect(this, &identifiable_data_entry_base::name_changed, this, [this]() {
+		this->cached_name.invalidate();
+	}, Qt::ConnectionType::DirectConnection);
+	//the territory's name is that of its county, tagged with its culture, religion and county government type; the latter is connected to when the county is set
+	connect(this, &territory::county_changed, this, &identifiable_data_entry_base::name_changed, Qt::ConnectionType::DirectConnection);
+	connect(this, &territory::culture_changed, this, &identifiable_data_entry_base::name_changed, Qt::ConnectionType::DirectConnection);
+	connect(this, &territory::religion_changed, this, &identifiable_data_entry_base::name_changed, Qt::ConnectionType::DirectConnection);
 }
 
 territory::~territory()
 {
 	this->technology_slots.clear();
+
+	if (this->technology_slot_update_needed) {
+		vector::remove(territory::technology_slot_update_queue, this);
+	}
 }
 
 void territory::process_gsml_scope(const gsml_data &scope)
@@ -143,7 +170,7 @@ void territory::process_gsml_dated_scope(const gsml_data &scope, const QDateTime
 void territory::initialize()
 {
 	if (this->get_county() != nullptr) {
-		connect(this->get_county(), &landed_title::government_type_changed, this, &identifiable_data_entry_base::name_changed);
+		connect(this->get_county(), &landed_title::government_type_changed, this, &identifiable_data_entry_base::name_changed, Qt::ConnectionType::DirectConnection);
 		connect(this->get_county(), &landed_title::holder_changed, this, &territory::owner_changed);
 
 		//create a fort holding slot for this territory if none exists
@@ -216,6 +243,8 @@ void territory::initialize_history()
 	}
 
 	data_entry_base::initialize_history();
+
+	this->update_technology_slots();
 }
 
 void territory::check() const
@@ -246,6 +275,33 @@ void territory::check_history() const
 	this->check();
 }
 
+void territory::add_owned_memory_usage(memory_usage &usage, memory_report &report) const
+{
+	data_entry::add_owned_memory_usage(usage, report);
+
+	usage.add_vector(this->holdings);
+	usage.add_vector(this->settlement_holding_slots);
+	usage.add_vector(this->settlement_holdings);
+	usage.add_vector(this->palace_holding_slots);
+	usage.add_tree(this->regions);
+	usage.add_tree(this->population_per_type);
+	usage.add_tree(this->population_per_culture.get_values());
+	usage.add_tree(this->population_per_religion.get_values());
+
+	usage.add_tree(this->technology_slots);
+	for (size_t i = 0; i < this->technology_slots.size(); ++i) {
+		report.get_usage("technology_slot").add_instance<technology_slot>();
+	}
+	usage.add_vector(this->acquired_technologies.get_words());
+	usage.add_vector(this->technologies_with_fulfilled_preconditions.get_words());
+	usage.add_vector(this->technologies_with_fulfilled_conditions.get_words());
+
+	usage.add_vector(this->population_units);
+	for (const qunique_ptr<population_unit> &population_unit : this->population_units) {
+		report.add_instance(population_unit.get(), "population_unit");
+	}
+}
+
 void territory::do_day()
 {
 }
@@ -253,7 +309,8 @@ void territory::do_day()
 void territory::do_month()
 {
 	if (this->get_owner() != nullptr) {
-		this->calculate_population_groups();
+		//the population groups are kept up to date by changes in the territory's holdings, so only the interface needs to be notified
+		emit population_groups_changed();
 	}
 }
 
@@ -262,6 +319,13 @@ void territory::do_year()
 }
 
 std::string territory::get_name() const
+{
+	return this->cached_name.get([this]() {
+		return this->resolve_name();
+	});
+}
+
+std::string territory::resolve_name() const
 {
 	if (this->get_county() != nullptr) {
 		return translator::get()->translate(this->get_county()->get_identifier_with_aliases(), this->get_tag_suffix_list_with_fallbacks());
@@ -495,6 +559,10 @@ void territory::create_holding(holding_slot *holding_slot, holding_type *type)
 	new_holding->moveToThread(QApplication::instance()->thread());
 	holding_slot->set_holding(std::move(new_holding));
 	this->holdings.push_back(holding_slot->get_holding());
+
+	if (this->get_county() != nullptr) {
+		this->get_county()->change_de_jure_statistics(holding_slot->get_holding()->get_realm_statistics());
+	}
 	switch (holding_slot->get_type()) {
 		case holding_slot_type::settlement:
 			this->settlement_holdings.push_back(holding_slot->get_holding());
@@ -525,6 +593,17 @@ void territory::destroy_holding(holding_slot *holding_slot)
 	if (holding_slot->get_type() == holding_slot_type::settlement) {
 		vector::remove(this->settlement_holdings, holding);
 
+		//remove the holding's population from the territory's population groups
+		for (const auto &kv_pair : holding->get_population_per_type()) {
+			this->change_population_group(kv_pair.first, nullptr, nullptr, -kv_pair.second);
+		}
+		for (const auto &kv_pair : holding->get_population_per_culture()) {
+			this->change_population_group(nullptr, kv_pair.first, nullptr, -kv_pair.second);
+		}
+		for (const auto &kv_pair : holding->get_population_per_religion()) {
+			this->change_population_group(nullptr, nullptr, kv_pair.first, -kv_pair.second);
+		}
+
 		if (holding == this->get_capital_holding()) {
 			//if the capital holding is being destroyed, set the next holding as the capital, if any exists, or otherwise set the capital holding to null
 			if (!this->settlement_holdings.empty()) {
@@ -540,6 +619,12 @@ void territory::destroy_holding(holding_slot *holding_slot)
 		emit settlement_holdings_changed();
 	}
 
+	//remove the holding from the statistics of its owner's realm and of its de jure titles, and from its owner's holdings, as it is about to be deleted
+	holding->change_realm_statistics(-holding->get_realm_statistics());
+	if (holding->get_owner() != nullptr) {
+		holding->get_owner()->remove_holding(holding);
+	}
+
 	holding_slot->set_holding(nullptr);
 }
 
@@ -778,56 +863,83 @@ void territory::set_population_growth_modifier(const int population_growth_modif
 	}
 }
 
-void territory::calculate_population_groups()
+/**
+**	@brief	Change the population of a population group in the territory, as a result of a change in one of its settlement holdings
+**
+**	@param	type		The population type; null if the change doesn't apply to population types
+**	@param	culture		The culture; null if the change doesn't apply to cultures
+**	@param	religion	The religion; null if the change doesn't apply to religions
+**	@param	change		The population change
+*/
+void territory::change_population_group(population_type *type, metternich::culture *culture, metternich::religion *religion, const int change)
 {
-	std::unique_lock<std::shared_mutex> lock(this->population_groups_mutex);
-
-	this->population_per_type.clear();
-	this->population_per_culture.clear();
-	this->population_per_religion.clear();
-
-	for (holding *holding : this->get_settlement_holdings()) {
-		for (const auto &kv_pair : holding->get_population_per_type()) {
-			this->population_per_type[kv_pair.first] += kv_pair.second;
+	{
+		std::unique_lock<std::shared_mutex> lock(this->population_groups_mutex);
+
+		if (type != nullptr) {
+			int &type_population = this->population_per_type[type];
+			type_population += change;
+			if (type_population <= 0) {
+				this->population_per_type.erase(type);
+			}
 		}
-		for (const auto &kv_pair : holding->get_population_per_culture()) {
-			this->population_per_culture[kv_pair.first] += kv_pair.second;
+
+		if (culture != nullptr) {
+			this->population_per_culture.change(culture, change);
 		}
-		for (const auto &kv_pair : holding->get_population_per_religion()) {
-			this->population_per_religion[kv_pair.first] += kv_pair.second;
+
+		if (religion != nullptr) {
+			this->population_per_religion.change(religion, change);
 		}
 	}
 
-	emit population_groups_changed();
+	this->calculate_culture_and_religion();
+}
 
-	//update the territory's main culture and religion
+/**
+**	@brief	Recalculate the population groups from the territory's settlement holdings, e.g. after initializing its history
+*/
+void territory::calculate_population_groups()
+{
+	{
+		std::unique_lock<std::shared_mutex> lock(this->population_groups_mutex);
 
-	metternich::culture *plurality_culture = nullptr;
-	int plurality_culture_size = 0;
+		this->population_per_type.clear();
+		this->population_per_culture.clear();
+		this->population_per_religion.clear();
 
-	for (const auto &kv_pair : this->get_population_per_culture()) {
-		metternich::culture *culture = kv_pair.first;
-		const int culture_size = kv_pair.second;
-		if (plurality_culture == nullptr || culture_size > plurality_culture_size) {
-			plurality_culture = culture;
-			plurality_culture_size = culture_size;
+		for (holding *holding : this->get_settlement_holdings()) {
+			for (const auto &kv_pair : holding->get_population_per_type()) {
+				this->population_per_type[kv_pair.first] += kv_pair.second;
+			}
+			for (const auto &kv_pair : holding->get_population_per_culture()) {
+				this->population_per_culture.change(kv_pair.first, kv_pair.second);
+			}
+			for (const auto &kv_pair : holding->get_population_per_religion()) {
+				this->population_per_religion.change(kv_pair.first, kv_pair.second);
+			}
 		}
 	}
 
-	metternich::religion *plurality_religion = nullptr;
-	int plurality_religion_size = 0;
+	emit population_groups_changed();
+
+	this->calculate_culture_and_religion();
+}
 
-	for (const auto &kv_pair : this->get_population_per_religion()) {
-		metternich::religion *religion = kv_pair.first;
-		const int religion_size = kv_pair.second;
-		if (plurality_religion == nullptr || religion_size > plurality_religion_size) {
-			plurality_religion = religion;
-			plurality_religion_size = religion_size;
-		}
+/**
+**	@brief	Update the territory's main culture and religion to its plurality ones; these are kept if the territory has no population
+*/
+void territory::calculate_culture_and_religion()
+{
+	metternich::culture *plurality_culture = this->population_per_culture.get_plurality();
+	if (plurality_culture != nullptr) {
+		this->set_culture(plurality_culture);
 	}
 
-	this->set_culture(plurality_culture);
-	this->set_religion(plurality_religion);
+	metternich::religion *plurality_religion = this->population_per_religion.get_plurality();
+	if (plurality_religion != nullptr) {
+		this->set_religion(plurality_religion);
+	}
 }
 
 QVariantList territory::get_population_per_type_qvariant_list() const
@@ -914,11 +1026,9 @@ technology_set territory::get_technologies() const
 {
 	technology_set technologies;
 
-	for (const auto &kv_pair : this->technology_slots) {
-		if (kv_pair.second->is_acquired()) {
-			technologies.insert(kv_pair.first);
-		}
-	}
+	this->acquired_technologies.for_each([&technologies](const size_t index) {
+		technologies.insert(technology::get_by_index(index));
+	});
 
 	return technologies;
 }
@@ -928,21 +1038,32 @@ QVariantList territory::get_technologies_qvariant_list() const
 	return container::to_qvariant_list(this->get_technologies());
 }
 
-bool territory::has_technology(technology *technology) const
+bool territory::has_technology(const technology *technology) const
 {
-	technology_slot *technology_slot = this->get_technology_slot(technology);
-	return technology_slot != nullptr && technology_slot->is_acquired();
+	return this->acquired_technologies.contains(technology->get_index());
+}
+
+//whether the territory can acquire a technology it doesn't have, i.e. whether the technology is available and acquirable for it, according to its technology bitsets
+bool territory::can_acquire_technology(const technology *technology) const
+{
+	const size_t index = technology->get_index();
+
+	if (this->acquired_technologies.contains(index)) {
+		return false;
+	}
+
+	return this->technologies_with_fulfilled_preconditions.contains(index) && this->technologies_with_fulfilled_conditions.contains(index) && this->acquired_technologies.contains_all(technology->get_required_technology_bitset());
 }
 
 void territory::add_technology(technology *technology)
 {
 	if (history::get()->is_loading()) {
 		//if is loading history, automatically add all prerequisites when adding a technology
-		for (metternich::technology *required_technology : technology->get_required_technologies()) {
-			if (!this->has_technology(required_technology)) {
-				this->add_technology(required_technology);
+		technology->get_all_required_technology_bitset().for_each([this](const size_t index) {
+			if (!this->acquired_technologies.contains(index)) {
+				this->get_technology_slot(metternich::technology::get_by_index(index))->set_acquired(true);
 			}
-		}
+		});
 	}
 
 	technology_slot *technology_slot = this->get_technology_slot(technology);
@@ -955,9 +1076,58 @@ void territory::remove_technology(technology *technology)
 	technology_slot->set_acquired(false);
 }
 
+/**
+**	@brief	Set whether the territory has a technology, to be called by the technology's slot when it is acquired or lost
+**
+**	@param	technology	The technology
+**	@param	acquired	Whether the technology has been acquired
+*/
+void territory::set_technology_acquired(const technology *technology, const bool acquired)
+{
+	this->acquired_technologies.set(technology->get_index(), acquired);
+
+	//other technologies may have become acquirable or not
+	if (!technology->get_allowed_technologies().empty()) {
+		this->set_technology_slot_update_needed();
+	}
+}
+
+void territory::set_technology_preconditions_fulfilled(const technology *technology, const bool fulfilled)
+{
+	if (this->technologies_with_fulfilled_preconditions.contains(technology->get_index()) == fulfilled) {
+		return;
+	}
+
+	this->technologies_with_fulfilled_preconditions.set(technology->get_index(), fulfilled);
+	this->set_technology_slot_update_needed();
+}
+
+void territory::set_technology_conditions_fulfilled(const technology *technology, const bool fulfilled)
+{
+	if (this->technologies_with_fulfilled_conditions.contains(technology->get_index()) == fulfilled) {
+		return;
+	}
+
+	this->technologies_with_fulfilled_conditions.set(technology->get_index(), fulfilled);
+	this->set_technology_slot_update_needed();
+}
+
 void territory::create_technology_slots()
 {
+	this->acquired_technologies = technology_bitset(technology::get_index_count());
+	this->technologies_with_fulfilled_preconditions = technology_bitset(technology::get_index_count());
+	this->technologies_with_fulfilled_conditions = technology_bitset(technology::get_index_count());
+
 	for (technology *technology : technology::get_all()) {
+		//technologies without scripted preconditions or conditions have no condition checks, and always fulfill them
+		if (technology->get_preconditions() == nullptr) {
+			this->technologies_with_fulfilled_preconditions.insert(technology->get_index());
+		}
+
+		if (technology->get_conditions() == nullptr) {
+			this->technologies_with_fulfilled_conditions.insert(technology->get_index());
+		}
+
 		auto new_technology_slot = make_qunique<technology_slot>(technology, this);
 		new_technology_slot->moveToThread(QApplication::instance()->thread());
 
@@ -970,6 +1140,39 @@ void territory::create_technology_slots()
 	}
 }
 
+/**
+**	@brief	Update the availability and acquirability of all of the territory's technology slots
+**
+**	A technology is available if its scripted preconditions are fulfilled, and acquirable if it is available, its scripted conditions are fulfilled, and the territory has all of its required technologies, which is checked with bitset operations.
+*/
+void territory::update_technology_slots()
+{
+	if (this->technology_slot_update_needed) {
+		this->technology_slot_update_needed = false;
+		vector::remove(territory::technology_slot_update_queue, this);
+	}
+
+	for (const auto &[technology, technology_slot] : this->technology_slots) {
+		const size_t index = technology->get_index();
+		const bool available = this->technologies_with_fulfilled_preconditions.contains(index);
+		technology_slot->set_available(available);
+
+		const bool acquirable = available && this->technologies_with_fulfilled_conditions.contains(index) && this->acquired_technologies.contains_all(technology->get_required_technology_bitset());
+		technology_slot->set_acquirable(acquirable);
+	}
+}
+
+void territory::set_technology_slot_update_needed()
+{
+	//the slots are updated for the first time when history is initialized
+	if (this->technology_slot_update_needed || !this->is_history_initialized()) {
+		return;
+	}
+
+	this->technology_slot_update_needed = true;
+	territory::technology_slot_update_queue.push_back(this);
+}
+
 bool territory::is_selectable() const
 {
 	return this->get_county() != nullptr;
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "database/data_entry.h"
+#include "technology/technology_bitset.h"
 #include "technology/technology_map.h"
 #include "technology/technology_set.h"
+#include "util/cached_translation.h"
+#include "util/plurality_map.h"
 #include "util/qunique_ptr.h"
 
 namespace metternich {
@@ -50,6 +53,12 @@ class territory : public data_entry
 	Q_PROPERTY(QVariantList technologies READ get_technologies_qvariant_list NOTIFY technologies_changed)
 	Q_PROPERTY(bool selectable READ is_selectable CONSTANT)
 
+public:
+	static void update_pending_technology_slots();
+
+private:
+	static inline std::vector<territory *> technology_slot_update_queue; //territories whose technology slots need to be updated, in the order their technologies changed
+
 public:
 	territory(const std::string &identifier);
 	virtual ~territory() override;
@@ -61,13 +70,18 @@ public:
 	virtual void initialize_history() override;
 	virtual void check() const override;
 	virtual void check_history() const override;
+	virtual void add_owned_memory_usage(memory_usage &usage, memory_report &report) const override;
 
 	virtual void do_day();
 	virtual void do_month();
 	void do_year();
 
-	virtual std::string get_name() const override;
+	virtual std::string get_name() const override final;
+
+protected:
+	virtual std::string resolve_name() const; //resolve the name without using the cached one
 
+public:
 	std::vector<std::vector<std::string>> get_tag_suffix_list_with_fallbacks() const;
 
 	landed_title *get_county() const
@@ -258,20 +272,22 @@ public:
 		this->set_population_growth_modifier(this->get_population_growth_modifier() + change);
 	}
 
+	void change_population_group(population_type *type, metternich::culture *culture, metternich::religion *religion, const int change);
 	void calculate_population_groups();
+	void calculate_culture_and_religion();
 
 	Q_INVOKABLE QVariantList get_population_per_type_qvariant_list() const;
 
 	const std::map<metternich::culture *, int> &get_population_per_culture() const
 	{
-		return this->population_per_culture;
+		return this->population_per_culture.get_values();
 	}
 
 	Q_INVOKABLE QVariantList get_population_per_culture_qvariant_list() const;
 
 	const std::map<metternich::religion *, int> &get_population_per_religion() const
 	{
-		return this->population_per_religion;
+		return this->population_per_religion.get_values();
 	}
 
 	Q_INVOKABLE QVariantList get_population_per_religion_qvariant_list() const;
@@ -279,10 +295,21 @@ public:
 	QVariantList get_technology_slots_qvariant_list() const;
 	technology_set get_technologies() const;
 	QVariantList get_technologies_qvariant_list() const;
-	bool has_technology(technology *technology) const;
+
+	const technology_bitset &get_technology_bitset() const
+	{
+		return this->acquired_technologies;
+	}
+
+	bool has_technology(const technology *technology) const;
+	bool can_acquire_technology(const technology *technology) const;
 	Q_INVOKABLE void add_technology(technology *technology);
 	Q_INVOKABLE void remove_technology(technology *technology);
+	void set_technology_acquired(const technology *technology, const bool acquired);
+	void set_technology_preconditions_fulfilled(const technology *technology, const bool fulfilled);
+	void set_technology_conditions_fulfilled(const technology *technology, const bool fulfilled);
 	void create_technology_slots();
+	void update_technology_slots();
 
 	bool is_selectable() const;
 
@@ -304,6 +331,8 @@ private:
 		return find_iterator->second.get();
 	}
 
+	void set_technology_slot_update_needed();
+
 signals:
 	void county_changed();
 	void duchy_changed();
@@ -340,15 +369,20 @@ private:
 	holding_slot *capital_holding_slot = nullptr;
 	std::set<region *> regions; //the regions to which this territory belongs
 	technology_map<qunique_ptr<technology_slot>> technology_slots; //the technology slots for each technology
+	technology_bitset acquired_technologies;
+	technology_bitset technologies_with_fulfilled_preconditions; //technologies whose scripted preconditions are fulfilled, i.e. which are available
+	technology_bitset technologies_with_fulfilled_conditions; //technologies whose scripted conditions are fulfilled, not counting their required technologies
+	bool technology_slot_update_needed = false;
 	int population = 0; //the sum of the population of all of the territory's settlement holdings
 	int population_capacity_additive_modifier = 0; //the population capacity additive modifier which the territory provides to its holdings
 	int population_capacity_modifier = 0; //the population capacity modifier which the territory provides to its holdings
 	int population_growth_modifier = 0; //the population growth modifier which the territory provides to its holdings
 	std::map<population_type *, int> population_per_type; //the population for each population type
-	std::map<metternich::culture *, int> population_per_culture; //the population for each culture
-	std::map<metternich::religion *, int> population_per_religion; //the population for each religion
+	plurality_map<metternich::culture> population_per_culture; //the population for each culture
+	plurality_map<metternich::religion> population_per_religion; //the population for each religion
 	mutable std::shared_mutex population_groups_mutex;
 	std::vector<qunique_ptr<population_unit>> population_units; //population units set for this province in history, used during initialization to generate population units in the province's settlements
+	cached_translation cached_name;
 };
 
 }
@@ -13,9 +13,13 @@
 #include "map/star_system.h"
 #include "map/terrain_type.h"
 #include "map/world_type.h"
+#include "technology/technology_diffusion.h"
 #include "util/container_util.h"
 #include "util/geocoordinate_util.h"
 #include "util/image_util.h"
+#include "util/indexed_raster.h"
+#include "util/mapped_raster.h"
+#include "util/memory_usage.h"
 #include "util/point_util.h"
 #include "util/random.h"
 #include "util/translator.h"
@@ -23,6 +27,42 @@
 
 namespace metternich {
 
+/**
+**	@brief	Load an indexed raster from a world's map cache
+**
+**	@param	cache_path	The path of the world's map cache
+**	@param	name		The name of the raster
+**
+**	@return	The raster, which is null if the cache has no such raster
+**
+**	The raster file is memory-mapped if present; otherwise, the PNG image of the raster is decoded and converted if present, and saved as a raster file so that later loads can map it.
+*/
+template <typename T>
+static indexed_raster<T> load_cached_raster(const std::filesystem::path &cache_path, const std::string &name)
+{
+	const std::filesystem::path raster_path = cache_path / (name + ".raster");
+
+	if (mapped_raster::is_current(raster_path)) {
+		return indexed_raster<T>(raster_path);
+	}
+
+	const std::filesystem::path image_path = cache_path / (name + ".png");
+
+	if (!std::filesystem::exists(image_path)) {
+		return indexed_raster<T>();
+	}
+
+	const QImage image(QString::fromStdString(image_path.string()));
+
+	if (image.isNull()) {
+		throw std::runtime_error("Failed to load map image \"" + image_path.string() + "\".");
+	}
+
+	indexed_raster<T> raster(image);
+	raster.save(raster_path);
+	return raster;
+}
+
 std::set<std::string> world::get_database_dependencies()
 {
 	return {
@@ -41,15 +81,18 @@ world::~world()
 
 void world::initialize()
 {
-	if (this->terrain_image.size() != this->province_image.size()) {
-		throw std::runtime_error("The terrain image of world \"" + this->get_identifier() + "\" has a different size (" + std::to_string(this->terrain_image.width()) + "x" + std::to_string(this->terrain_image.height()) + ") than its province image (" + std::to_string(this->province_image.width()) + "x" + std::to_string(this->province_image.height()) + ").");
+	if (this->terrain_raster.get_size() != this->province_raster.get_size()) {
+		throw std::runtime_error("The terrain image of world \"" + this->get_identifier() + "\" has a different size (" + std::to_string(this->terrain_raster.get_width()) + "x" + std::to_string(this->terrain_raster.get_height()) + ") than its province image (" + std::to_string(this->province_raster.get_width()) + "x" + std::to_string(this->province_raster.get_height()) + ").");
 	}
 
-	//clear the terrain and province images, as there is no need to keep them in memory
-	this->terrain_image = QImage();
-	this->province_image = QImage();
+	//clear the terrain raster, as there is no need to keep it in memory; the province raster is kept for province hit-testing
+	this->terrain_raster = indexed_raster<terrain_type>();
 
-	this->pathfinder = std::make_unique<metternich::pathfinder>(this->provinces);
+	this->pathfinder = std::make_unique<metternich::pathfinder>(this->provinces, this->province_adjacency);
+	if (!this->provinces.empty()) {
+		this->technology_diffusion = std::make_unique<metternich::technology_diffusion>(this);
+	}
+	this->build_spatial_indices();
 
 	if (this->get_star_system() == nullptr) {
 		const world *orbit_center = this->get_orbit_center();
@@ -63,11 +106,12 @@ void world::initialize()
 		}
 	}
 
+	random_generator generator = random::get_generator(random_stream::map, "world", this->get_index());
 	if (this->get_orbit_center() != nullptr) {
-		this->set_orbit_angle(random::generate_degree_angle());
+		this->set_orbit_angle(generator.generate_degree_angle());
 	}
 	this->calculate_cosmic_size();
-	this->set_rotation(random::generate_degree_angle());
+	this->set_rotation(generator.generate_degree_angle());
 
 	for (world *satellite : this->satellites) {
 		if (!satellite->is_initialized()) {
@@ -108,33 +152,63 @@ void world::initialize()
 
 	std::sort(this->satellites.begin(), this->satellites.end(), satellite_sort_func);
 
-	connect(this, &world::owner_changed, this, &identifiable_data_entry_base::name_changed); //if the owner changes, whether the world uses its own tag list suffix or that of its system can change
+	connect(this, &world::owner_changed, this, &identifiable_data_entry_base::name_changed, Qt::ConnectionType::DirectConnection); //if the owner changes, whether the world uses its own tag list suffix or that of its system can change
 
 	if (this->get_star_system() != nullptr) {
-		connect(this->get_star_system(), &star_system::name_changed, this, &identifiable_data_entry_base::name_changed); //if the tag suffix list of the star system changes, the world's can, too
+		connect(this->get_star_system(), &star_system::name_changed, this, &identifiable_data_entry_base::name_changed, Qt::ConnectionType::DirectConnection); //if the tag suffix list of the star system changes, the world's can, too
 	}
 
 	territory::initialize();
 }
 
-void world::do_day()
+void world::add_owned_memory_usage(memory_usage &usage, memory_report &report) const
 {
-	if constexpr (world::revolution_enabled) {
-		//move the world along its orbit
-		if (this->get_orbit_center() != nullptr) {
-			this->increment_orbit_angle();
+	territory::add_owned_memory_usage(usage, report);
+
+	usage.add_vector(this->satellites);
+	usage.add_tree(this->provinces);
+	usage.add_tree(this->trade_nodes);
+	usage.add_tree(this->active_trade_nodes);
+	usage.add_tree(this->trade_routes);
+	usage.add_allocation(this->terrain_raster.get_owned_memory_size());
+	usage.add_allocation(this->province_raster.get_owned_memory_size());
+
+	this->province_adjacency.add_memory_usage(usage);
+	if (this->technology_diffusion != nullptr) {
+		this->technology_diffusion->add_memory_usage(usage);
+	}
+	this->province_index.add_memory_usage(usage);
+	this->holding_slot_index.add_memory_usage(usage);
+
+	usage.add_tree(this->terrain_geopolygons);
+	for (const auto &kv_pair : this->terrain_geopolygons) {
+		usage.add_vector(kv_pair.second);
+
+		for (const QGeoPolygon &geopolygon : kv_pair.second) {
+			report.get_usage("geopolygon").add_geopolygon(geopolygon);
 		}
 	}
 
-	//rotate the world on its axis
-	if (!this->is_star()) { //stars don't need to rotate, as it makes no difference for them graphically
-		this->rotate();
+	usage.add_tree(this->terrain_geopaths);
+	for (const auto &kv_pair : this->terrain_geopaths) {
+		usage.add_vector(kv_pair.second);
+
+		for (const QGeoPath &geopath : kv_pair.second) {
+			report.get_usage("geopath").add_geopath(geopath);
+		}
 	}
+}
 
-	territory::do_day();
+void world::do_month()
+{
+	territory::do_month();
+
+	if (this->technology_diffusion != nullptr) {
+		this->technology_diffusion->do_month();
+	}
 }
 
-std::string world::get_name() const
+std::string world::resolve_name() const
 {
 	std::vector<std::vector<std::string>> tag_list_with_fallbacks;
 	if (this->get_owner() != nullptr) {
@@ -185,14 +259,57 @@ const std::filesystem::path &world::get_texture_path() const
 	return database::get()->get_tagged_texture_path(this->get_type()->get_texture_tag(), {{this->get_identifier()}});
 }
 
+/**
+**	@brief	Sample the day at which the orbits and rotations of worlds are evaluated
+**
+**	Orbit positions, rotations and cosmic map positions are calculated from the sampled day when read, so worlds are not notified of it changing.
+**
+**	@param	date	The date to sample
+**
+**	@return	True if the sampled day changed, or false otherwise
+*/
+bool world::sample_kinematics(const QDateTime &date)
+{
+	const long long int day = date.isValid() ? date.date().toJulianDay() : 0;
+
+	if (day == world::kinematics_day.load(std::memory_order_relaxed)) {
+		return false;
+	}
+
+	world::kinematics_day.store(day, std::memory_order_relaxed);
+	return true;
+}
+
+//set the orbit angle at the current kinematics day
 void world::set_orbit_angle(const double angle)
 {
-	if (angle == this->orbit_angle) {
+	const double epoch_angle = angle - this->get_orbit_angle_per_day() * world::kinematics_day.load(std::memory_order_relaxed);
+
+	if (epoch_angle == this->epoch_orbit_angle) {
+		return;
+	}
+
+	this->epoch_orbit_angle = epoch_angle;
+	emit orbit_position_changed();
+	this->notify_cosmic_map_pos_changed();
+}
+
+QPointF world::get_orbit_position() const
+{
+	return point::get_degree_angle_direction(this->get_orbit_angle());
+}
+
+//set the rotation at the current kinematics day
+void world::set_rotation(const double rotation)
+{
+	const double epoch_rotation = rotation - this->get_rotation_per_day() * world::kinematics_day.load(std::memory_order_relaxed);
+
+	if (epoch_rotation == this->epoch_rotation) {
 		return;
 	}
 
-	this->orbit_angle = angle;
-	this->set_orbit_position(point::get_degree_angle_direction(this->orbit_angle));
+	this->epoch_rotation = epoch_rotation;
+	emit rotation_changed();
 }
 
 void world::remove_satellite(world *satellite)
@@ -224,12 +341,11 @@ void world::set_map(const bool map)
 	}
 }
 
-void world::calculate_cosmic_map_pos()
+QPointF world::get_cosmic_map_pos() const
 {
 	if (this->get_astrocoordinate().isValid()) {
 		if (this->get_astrocoordinate() == QGeoCoordinate(0, 0)) {
-			this->set_cosmic_map_pos(QPointF(0, 0));
-			return;
+			return QPointF(0, 0);
 		}
 
 		QPointF direction_pos = geocoordinate::to_circle_edge_point(this->get_astrocoordinate());
@@ -242,17 +358,16 @@ void world::calculate_cosmic_map_pos()
 		const QPointF pos(x, y);
 
 		if (this->get_orbit_center() == nullptr || point::distance_to(pos, this->get_orbit_center()->get_cosmic_map_pos()) >= ((this->get_cosmic_size() / 2) + world::min_orbit_distance)) {
-			this->set_cosmic_map_pos(pos);
-			return;
+			return pos;
 		}
 	}
 
 	if (this->get_orbit_center() != nullptr) {
-		this->set_cosmic_map_pos(this->get_orbit_center()->get_cosmic_map_pos() + QPointF(this->get_orbit_position().x() * this->get_distance_from_orbit_center(), this->get_orbit_position().y() * this->get_distance_from_orbit_center()));
-		return;
+		//the position of orbiting worlds depends on the sampled kinematics day, and so is calculated when read
+		return this->get_orbit_center()->get_cosmic_map_pos() + QPointF(this->get_orbit_position().x() * this->get_distance_from_orbit_center(), this->get_orbit_position().y() * this->get_distance_from_orbit_center());
 	}
 
-	this->set_cosmic_map_pos(QPointF(0, 0));
+	return QPointF(0, 0);
 }
 
 void world::calculate_cosmic_size()
@@ -334,13 +449,27 @@ QGeoCoordinate world::get_pixel_pos_coordinate(const QPoint &pixel_pos) const
 
 terrain_type *world::get_coordinate_terrain(const QGeoCoordinate &coordinate) const
 {
-	if (this->terrain_image.isNull()) {
-		throw std::runtime_error("Cannot get coordinate terrain after clearing the terrain image from memory.");
+	if (this->terrain_raster.is_null()) {
+		throw std::runtime_error("Cannot get coordinate terrain after clearing the terrain raster from memory.");
+	}
+
+	return this->terrain_raster.get_pixel_element(this->get_coordinate_pos(coordinate));
+}
+
+/**
+**	@brief	Get the province which contains a geocoordinate
+**
+**	@param	coordinate	The geocoordinate
+**
+**	@return	The province containing the geocoordinate, or null if none does
+*/
+province *world::get_coordinate_province(const QGeoCoordinate &coordinate) const
+{
+	if (this->province_raster.is_null()) {
+		return nullptr;
 	}
 
-	QPoint pos = this->get_coordinate_pos(coordinate);
-	QRgb rgb = this->terrain_image.pixel(pos);
-	return terrain_type::get_by_rgb(rgb);
+	return this->province_raster.get_pixel_element(this->get_coordinate_pos(coordinate));
 }
 
 std::vector<QVariantList> world::parse_geojson_folder(const std::string_view &folder) const
@@ -437,108 +566,77 @@ void world::process_terrain_gsml_scope(const terrain_type *terrain, const gsml_d
 	}
 }
 
-void world::load_province_map()
+/**
+**	@brief	Load the world's terrain and province rasters from the map cache
+**
+**	This does not touch any other object, and so it can be called for different worlds concurrently.
+*/
+void world::load_rasters()
 {
-	const std::filesystem::path province_image_path = this->get_cache_path() / "provinces.png";
+	this->terrain_raster = load_cached_raster<terrain_type>(this->get_cache_path(), "terrain");
+	this->terrain_raster.resolve_elements(false);
+	this->province_raster = load_cached_raster<province>(this->get_cache_path(), "provinces");
+	this->province_raster.resolve_elements(false);
+}
 
-	if (!std::filesystem::exists(province_image_path)) {
+void world::load_province_map()
+{
+	if (this->province_raster.is_null()) {
 		return;
 	}
 
-	engine_interface::get()->set_loading_message("Loading " + this->get_loading_message_name() + " Provinces... (0%)");
-
-	this->province_image = QImage(QString::fromStdString(province_image_path.string()));
-
-	if (this->province_image.isNull()) {
-		throw std::runtime_error("Failed to load province map image.");
+	if (this->terrain_raster.is_null()) {
+		throw std::runtime_error("World \"" + this->get_identifier() + "\" has a province map, but no terrain map.");
 	}
 
-	const int pixel_count = this->province_image.width() * this->province_image.height();
+	engine_interface::get()->set_loading_message("Loading " + this->get_loading_message_name() + " Provinces... (0%)");
 
-	std::map<province *, std::map<terrain_type *, int>> province_terrain_counts;
+	const int width = this->province_raster.get_width();
+	const int pixel_count = this->province_raster.get_pixel_count();
 
-	const QRgb *rgb_data = reinterpret_cast<const QRgb *>(this->province_image.constBits());
-	const QRgb *terrain_rgb_data = reinterpret_cast<const QRgb *>(this->terrain_image.constBits());
+	//whether each province, by palette index, has any pixels, and whether any of them has river terrain
+	std::vector<bool> province_has_pixels(this->province_raster.get_palette_size(), false);
+	std::vector<bool> province_inner_rivers(this->province_raster.get_palette_size(), false);
 
-	province *previous_pixel_province = nullptr; //used to see which provinces border which horizontally
 	for (int i = 0; i < pixel_count; ++i) {
-		const bool line_start = ((i % this->province_image.width()) == 0);
-		if (line_start) {
-			//new line, set the previous pixel province to null
-			previous_pixel_province = nullptr;
-
+		if ((i % width) == 0) {
 			//update the progress in the loading message
 			const long long int progress_percent = static_cast<long long int>(i) * 100 / pixel_count;
 			engine_interface::get()->set_loading_message("Loading " + this->get_loading_message_name() + " Provinces... (" + QString::number(progress_percent) + "%)");
 		}
 
-		const QRgb &pixel_rgb = rgb_data[i];
+		const uint16_t province_index = this->province_raster.get_index(i);
 
-		province *pixel_province = province::get_by_rgb(pixel_rgb, false);
+		const province *pixel_province = this->province_raster.get_element(province_index);
 		if (pixel_province != nullptr) {
-			if (previous_pixel_province != pixel_province && previous_pixel_province != nullptr) {
-				pixel_province->add_border_province(previous_pixel_province);
-				previous_pixel_province->add_border_province(pixel_province);
+			const uint16_t terrain_index = this->terrain_raster.get_index(i);
+			const terrain_type *pixel_terrain = this->terrain_raster.get_element(terrain_index);
+			if (pixel_terrain == nullptr && terrain_index != indexed_raster<terrain_type>::empty_index) {
+				throw std::runtime_error("No terrain found for RGB value: " + std::to_string(this->terrain_raster.get_palette()[terrain_index]) + ".");
 			}
 
-			if (i > this->province_image.width()) { //second line or below
-				//the pixel just above this one
-				const int adjacent_pixel_index = i - this->province_image.width();
-				const QRgb &previous_vertical_pixel_rgb = rgb_data[adjacent_pixel_index];
-				province *previous_vertical_pixel_province = province::get_by_rgb(previous_vertical_pixel_rgb, false);
-				if (previous_vertical_pixel_province != pixel_province && previous_vertical_pixel_province != nullptr) {
-					pixel_province->add_border_province(previous_vertical_pixel_province);
-					previous_vertical_pixel_province->add_border_province(pixel_province);
-				}
-			}
+			province_has_pixels[province_index] = true;
 
-			const QRgb &terrain_pixel_rgb = terrain_rgb_data[i];
-			terrain_type *pixel_terrain = terrain_type::get_by_rgb(terrain_pixel_rgb);
-			std::map<terrain_type *, int> &province_terrain_count = province_terrain_counts[pixel_province];
-			province_terrain_count[pixel_terrain]++;
+			if (pixel_terrain != nullptr && pixel_terrain->is_river()) {
+				province_inner_rivers[province_index] = true;
+			}
 		}
-
-		previous_pixel_province = pixel_province;
 	}
 
-	for (const auto &province_terrain_count : province_terrain_counts) {
-		province *province = province_terrain_count.first;
-
-		bool inner_river = false;
-		for (const auto &kv_pair : province_terrain_count.second) {
-			terrain_type *terrain = kv_pair.first;
-
-			if (terrain != nullptr && terrain->is_river() && !inner_river) {
-				inner_river = true;
-			}
+	for (size_t i = 0; i < province_has_pixels.size(); ++i) {
+		if (!province_has_pixels[i]) {
+			continue;
 		}
 
-		province->set_inner_river(inner_river);
+		this->province_raster.get_element(static_cast<uint16_t>(i))->set_inner_river(province_inner_rivers[i]);
 	}
 
-	for (province *world_province : this->get_provinces()) {
-		//add river crossings
-		if (world_province->is_river()) {
-			//add all of this province's border provinces to each other
-			for (province *border_province : world_province->get_border_provinces()) {
-				if (border_province->is_water()) {
-					continue;
-				}
-
-				for (province *other_border_province : world_province->get_border_provinces()) {
-					if (other_border_province->is_water()) {
-						continue;
-					}
-
-					if (border_province->borders_province(other_border_province)) {
-						continue; //already borders the other province directly
-					}
-
-					border_province->add_river_crossing(other_border_province);
-					other_border_province->add_river_crossing(border_province);
-				}
-			}
-		}
+	//the province borders are built from the province raster only when creating the map cache, and loaded from it afterwards
+	const std::filesystem::path adjacency_path = this->get_cache_path() / "provinces.adjacency";
+	if (!this->province_adjacency.load(adjacency_path)) {
+		engine_interface::get()->set_loading_message("Calculating " + this->get_loading_message_name() + " Province Borders...");
+		this->province_adjacency.build(this->province_raster);
+		this->province_adjacency.save(adjacency_path);
 	}
 
 	for (province *province : this->get_provinces()) {
@@ -549,24 +647,25 @@ void world::load_province_map()
 			province->calculate_terrain();
 		}
 	}
+
+	//river crossings depend on which provinces are rivers, so they are added on every load, once the terrain of provinces is known
+	this->province_adjacency.add_river_crossings();
+	this->province_adjacency.apply();
+
+	for (province *province : this->get_provinces()) {
+		province->calculate_border_flags();
+	}
 }
 
 void world::load_terrain_map()
 {
-	const std::filesystem::path terrain_image_path = this->get_cache_path() / "terrain.png";
-
-	if (!std::filesystem::exists(terrain_image_path)) {
+	if (this->terrain_raster.is_null()) {
 		return;
 	}
 
 	engine_interface::get()->set_loading_message("Loading " + this->get_loading_message_name() + " Terrain...");
-	this->terrain_image = QImage(QString::fromStdString(terrain_image_path.string()));
 
-	if (this->terrain_image.isNull()) {
-		throw std::runtime_error("Failed to load terrain map image.");
-	}
-
-	this->map_size = this->terrain_image.size(); //set the world's pixel size to that of its terrain map
+	this->map_size = this->terrain_raster.get_size(); //set the world's pixel size to that of its terrain map
 }
 
 void world::write_geodata_to_image()
@@ -611,12 +710,14 @@ void world::write_geodata_to_image()
 		QImage province_image(province_image_path.string().c_str());
 		this->write_province_geodata_to_image(province_image, terrain_image);
 		province_image.save(QString::fromStdString((this->get_cache_path() / "provinces.png").string()));
+		indexed_raster<province>(province_image).save(this->get_cache_path() / "provinces.raster");
 		break;
 	}
 
 	if (!terrain_image.isNull()) {
 		//the terrain image has to be saved after the province image has been written, because provinces can also write to it
 		terrain_image.save(QString::fromStdString((this->get_cache_path() / "terrain.png").string()));
+		indexed_raster<terrain_type>(terrain_image).save(this->get_cache_path() / "terrain.raster");
 	}
 }
 
@@ -780,6 +881,35 @@ void world::add_province(province *province)
 	province->set_world(this);
 }
 
+/**
+**	@brief	Build the spatial indices of the world's provinces and holding slots
+*/
+void world::build_spatial_indices()
+{
+	std::vector<std::pair<province *, QGeoCoordinate>> province_coordinates;
+	std::vector<std::pair<holding_slot *, QGeoCoordinate>> holding_slot_coordinates;
+
+	const auto add_holding_slots = [&holding_slot_coordinates](const territory *territory) {
+		for (holding_slot *holding_slot : territory->get_settlement_holding_slots()) {
+			holding_slot_coordinates.emplace_back(holding_slot, holding_slot->get_geocoordinate());
+		}
+
+		for (holding_slot *holding_slot : territory->get_palace_holding_slots()) {
+			holding_slot_coordinates.emplace_back(holding_slot, holding_slot->get_geocoordinate());
+		}
+	};
+
+	add_holding_slots(this);
+
+	for (province *province : this->get_provinces()) {
+		province_coordinates.emplace_back(province, province->get_center_geocoordinate());
+		add_holding_slots(province);
+	}
+
+	this->province_index.build(province_coordinates);
+	this->holding_slot_index.build(holding_slot_coordinates);
+}
+
 void world::amalgamate()
 {
 	std::map<landed_title *, int> realm_counts;
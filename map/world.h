@@ -1,11 +1,17 @@
 #pragma once
 
 #include "database/data_type.h"
+#include "map/province_adjacency.h"
 #include "map/territory.h"
+#include "util/geocoordinate_index.h"
+#include "util/indexed_raster.h"
 
+#include <QDateTime>
 #include <QGeoCoordinate>
 #include <QPointF>
 
+#include <atomic>
+#include <cmath>
 #include <filesystem>
 #include <set>
 #include <string_view>
@@ -16,6 +22,7 @@ class landed_title;
 class pathfinder;
 class province;
 class star_system;
+class technology_diffusion;
 class terrain_type;
 class trade_node;
 class trade_route;
@@ -73,6 +80,7 @@ public:
 	static constexpr int astrodistance_multiplier = 1024;
 	static constexpr int million_km_per_au = 150;
 	static constexpr bool revolution_enabled = false;
+	static constexpr double rotation_per_day = 1.; //in degrees
 
 	static std::set<std::string> get_database_dependencies();
 
@@ -92,8 +100,23 @@ public:
 		world->set_astrocoordinate(geocircle.center());
 	}
 
+	static bool sample_kinematics(const QDateTime &date);
+
+	static long long int get_kinematics_day()
+	{
+		return world::kinematics_day.load(std::memory_order_relaxed);
+	}
+
 private:
+	//get an angle which changes at a constant rate, at the sampled kinematics day
+	static double get_kinematic_angle(const double epoch_angle, const double angle_per_day)
+	{
+		const double angle = std::fmod(epoch_angle + angle_per_day * world::kinematics_day.load(std::memory_order_relaxed), 360.);
+		return angle < 0 ? angle + 360. : angle;
+	}
+
 	static inline std::vector<world *> map_worlds;
+	static inline std::atomic<long long int> kinematics_day = 0; //the day, as a Julian day number, at which the orbits and rotations of worlds are evaluated; it is sampled by the interface once per rendered frame, and worlds aren't notified of it changing, rather the interface is notified once for all of them
 
 public:
 	world(const std::string &identifier);
@@ -116,10 +139,14 @@ public:
 		territory::check();
 	}
 
-	void do_day() override;
+	virtual void add_owned_memory_usage(memory_usage &usage, memory_report &report) const override;
 
-	virtual std::string get_name() const override;
+	virtual void do_month() override;
 
+protected:
+	virtual std::string resolve_name() const override;
+
+public:
 	virtual void set_county(landed_title *county) override;
 
 	world_type *get_type() const
@@ -163,7 +190,7 @@ public:
 		}
 
 		this->astrocoordinate = astrocoordinate;
-		this->calculate_cosmic_map_pos();
+		this->notify_cosmic_map_pos_changed();
 	}
 
 	int get_astrodistance() const
@@ -179,7 +206,7 @@ public:
 
 		this->astrodistance = astrodistance;
 		emit astrodistance_changed();
-		this->calculate_cosmic_map_pos();
+		this->notify_cosmic_map_pos_changed();
 	}
 
 	int get_astrodistance_pc() const
@@ -198,34 +225,23 @@ public:
 		this->set_astrodistance(static_cast<int>(astrodistance));
 	}
 
-	void set_orbit_angle(const double angle);
-
-	void increment_orbit_angle()
+	double get_orbit_angle_per_day() const
 	{
-		const double increment = 1. * world::min_orbit_distance / this->get_distance_from_orbit_center();
-		double angle = this->orbit_angle + increment;
-		if (angle >= 360.) {
-			angle -= 360.;
+		if (!world::revolution_enabled || this->get_orbit_center() == nullptr || this->get_distance_from_orbit_center() == 0) {
+			return 0.;
 		}
-		this->set_orbit_angle(angle);
-	}
 
-	const QPointF &get_orbit_position() const
-	{
-		return this->orbit_position;
+		return 1. * world::min_orbit_distance / this->get_distance_from_orbit_center();
 	}
 
-	void set_orbit_position(const QPointF &position)
+	double get_orbit_angle() const
 	{
-		if (position == this->get_orbit_position()) {
-			return;
-		}
-
-		this->orbit_position = position;
-		emit orbit_position_changed();
-		this->calculate_cosmic_map_pos();
+		return world::get_kinematic_angle(this->epoch_orbit_angle, this->get_orbit_angle_per_day());
 	}
 
+	void set_orbit_angle(const double angle);
+	QPointF get_orbit_position() const;
+
 	world *get_orbit_center() const
 	{
 		return this->orbit_center;
@@ -249,7 +265,7 @@ public:
 
 		emit orbit_center_changed();
 
-		this->calculate_cosmic_map_pos();
+		this->notify_cosmic_map_pos_changed();
 	}
 
 	bool is_any_orbit_center_of(const world *other_world) const
@@ -285,7 +301,7 @@ public:
 
 		this->distance_from_orbit_center = distance;
 		emit distance_from_orbit_center_changed();
-		this->calculate_cosmic_map_pos();
+		this->notify_cosmic_map_pos_changed();
 	}
 
 	double get_distance_from_orbit_center_au() const
@@ -379,53 +395,34 @@ public:
 		return this->get_radius() * 2;
 	}
 
-	double get_rotation() const
-	{
-		return this->rotation;
-	}
-
-	void set_rotation(const double rotation)
+	double get_rotation_per_day() const
 	{
-		if (rotation == this->get_rotation()) {
-			return;
+		if (this->is_star()) {
+			return 0.; //stars don't need to rotate, as it makes no difference for them graphically
 		}
 
-		this->rotation = rotation;
-		emit rotation_changed();
+		return world::rotation_per_day;
 	}
 
-	void rotate()
+	double get_rotation() const
 	{
-		//rotate the world on its own axis
-		const double increment = 1.;
-		double angle = this->get_rotation() + increment;
-		if (angle >= 360.) {
-			angle -= 360.;
-		}
-		this->set_rotation(angle);
+		return world::get_kinematic_angle(this->epoch_rotation, this->get_rotation_per_day());
 	}
 
-	const QPointF &get_cosmic_map_pos() const
-	{
-		return this->cosmic_map_pos;
-	}
+	void set_rotation(const double rotation);
 
-	void set_cosmic_map_pos(const QPointF &pos)
-	{
-		if (pos == this->get_cosmic_map_pos()) {
-			return;
-		}
+	QPointF get_cosmic_map_pos() const;
 
-		this->cosmic_map_pos = pos;
+	//notify the interface of the cosmic map position of the world and of its satellites having changed
+	void notify_cosmic_map_pos_changed()
+	{
 		emit cosmic_map_pos_changed();
 
 		for (world *satellite : this->satellites) {
-			satellite->calculate_cosmic_map_pos();
+			satellite->notify_cosmic_map_pos_changed();
 		}
 	}
 
-	void calculate_cosmic_map_pos();
-
 	double get_cosmic_size() const
 	{
 		return this->cosmic_size;
@@ -438,7 +435,7 @@ public:
 		}
 
 		this->cosmic_size = cosmic_size;
-		this->calculate_cosmic_map_pos();
+		this->notify_cosmic_map_pos_changed();
 	}
 
 	double get_cosmic_size_with_satellites() const
@@ -477,6 +474,29 @@ public:
 
 	QVariantList get_provinces_qvariant_list() const;
 
+	const geocoordinate_index<province> &get_province_index() const
+	{
+		return this->province_index;
+	}
+
+	std::vector<province *> get_nearest_provinces(const QGeoCoordinate &coordinate, const size_t count) const
+	{
+		return this->province_index.get_nearest(coordinate, count);
+	}
+
+	std::vector<province *> get_provinces_within_radius(const QGeoCoordinate &coordinate, const double radius) const
+	{
+		return this->province_index.get_within_radius(coordinate, radius);
+	}
+
+	Q_INVOKABLE metternich::province *get_coordinate_province(const QGeoCoordinate &coordinate) const;
+
+	std::vector<holding_slot *> get_nearest_holding_slots(const QGeoCoordinate &coordinate, const size_t count) const
+	{
+		return this->holding_slot_index.get_nearest(coordinate, count);
+	}
+
+
 	void add_trade_node(trade_node *node)
 	{
 		this->trade_nodes.insert(node);
@@ -547,6 +567,11 @@ public:
 	QGeoCoordinate get_pixel_pos_coordinate(const QPoint &pos) const;
 	terrain_type *get_coordinate_terrain(const QGeoCoordinate &coordinate) const;
 
+	const metternich::province_adjacency &get_province_adjacency() const
+	{
+		return this->province_adjacency;
+	}
+
 	const pathfinder *get_pathfinder() const
 	{
 		return this->pathfinder.get();
@@ -597,6 +622,7 @@ public:
 	void process_terrain_gsml_data(const terrain_type *terrain, const gsml_data &data);
 	void process_terrain_gsml_scope(const terrain_type *terrain, const gsml_data &scope);
 
+	void load_rasters();
 	void load_province_map();
 	void load_terrain_map();
 
@@ -624,6 +650,7 @@ public:
 
 private:
 	void add_province(province *province);
+	void build_spatial_indices();
 
 signals:
 	void type_changed();
@@ -640,11 +667,9 @@ private:
 	star_system *star_system = nullptr;
 	QGeoCoordinate astrocoordinate;
 	int astrodistance = 0;
-	double orbit_angle = 0; //in degrees
-	QPointF orbit_position;
+	double epoch_orbit_angle = 0; //the orbit angle at the kinematics epoch (Julian day 0), in degrees; the orbit angle at any other day is calculated from it
 	world *orbit_center = nullptr; //if none is given, then the center of the star system is assumed
-	double rotation = 0.; //the rotation of the world on its own axis
-	QPointF cosmic_map_pos;
+	double epoch_rotation = 0.; //the rotation of the world on its own axis at the kinematics epoch, in degrees
 	double distance_from_orbit_center = 0; //in millions of kilometers
 	bool map = false; //whether the world has a map
 	bool map_active = false; //whether the world's map is active
@@ -657,11 +682,15 @@ private:
 	std::set<trade_route *> trade_routes; //the trade routes in the world
 	QSize map_size = QSize(0, 0); //the size of the world's map, in pixels
 	double cosmic_size = 0; //the size of the world for the cosmic map
-	QImage terrain_image;
-	QImage province_image;
+	indexed_raster<terrain_type> terrain_raster;
+	indexed_raster<province> province_raster; //kept after initialization, for province hit-testing
 	std::map<const terrain_type *, std::vector<QGeoPolygon>> terrain_geopolygons;
 	std::map<const terrain_type *, std::vector<QGeoPath>> terrain_geopaths;
+	metternich::province_adjacency province_adjacency;
 	std::unique_ptr<pathfinder> pathfinder;
+	std::unique_ptr<technology_diffusion> technology_diffusion;
+	geocoordinate_index<province> province_index; //the provinces by their center geocoordinate
+	geocoordinate_index<holding_slot> holding_slot_index; //the settlement and palace holding slots of the world and its provinces
 };
 
 }
@@ -9,9 +9,12 @@ namespace std {
 #include "maskedmousearea/maskedmousearea.h"
 
 #include <QApplication>
+#include <QByteArray>
 #include <QColor>
+#include <QCoreApplication>
 #include <QCryptographicHash>
 #include <QDateTime>
+#include <QFile>
 #include <QGeoCircle>
 #include <QGeoCoordinate>
 #include <QGeoPath>
@@ -24,10 +27,12 @@ namespace std {
 #include <QMetaProperty>
 #include <QObject>
 #include <QPoint>
+#include <QPointer>
 #include <QPolygonF>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
 #include <QQuickImageProvider>
+#include <QQuickWindow>
 #include <QRect>
 #include <QSize>
 #include <QStandardPaths>
@@ -42,25 +47,43 @@ namespace std {
 #include <QVector>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <iomanip>
 #include <iostream>
+#include <istream>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <optional>
+#include <ostream>
 #include <queue>
 #include <random>
 #include <set>
 #include <shared_mutex>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace metternich {
+
+/**
+**	@brief	An index of the aggregate size and unit count of population units per location, by a key of their characteristics
+**
+**	Locations are given dense indices when added, so that the locations of an area (e.g. a region) can be resolved once into an array of indices, and then be iterated without further lookups.
+*/
+template <typename location_type, typename key_type, typename key_hash = std::hash<key_type>>
+class population_generation_index final
+{
+public:
+	struct aggregate final
+	{
+		int size = 0;
+		int unit_count = 0;
+	};
+
+	/**
+	**	@brief	Add a location to the index, if it hasn't been added already
+	**
+	**	@param	location	The location
+	**
+	**	@return	The location's index, and whether it was newly added
+	*/
+	std::pair<size_t, bool> add_location(location_type *location)
+	{
+		const auto result = this->location_indices.try_emplace(location, this->locations.size());
+
+		if (result.second) {
+			this->locations.push_back(location);
+			this->aggregates_per_location.emplace_back();
+		}
+
+		return std::make_pair(result.first->second, result.second);
+	}
+
+	location_type *get_location(const size_t location_index) const
+	{
+		return this->locations[location_index];
+	}
+
+	void change(const size_t location_index, const key_type &key, const int size_change, const int unit_count_change)
+	{
+		aggregate &aggregate = this->aggregates_per_location[location_index][key];
+		aggregate.size += size_change;
+		aggregate.unit_count += unit_count_change;
+	}
+
+	int get_size(const size_t location_index, const key_type &key) const
+	{
+		const auto &aggregates = this->aggregates_per_location[location_index];
+		const auto find_iterator = aggregates.find(key);
+		if (find_iterator != aggregates.end()) {
+			return find_iterator->second.size;
+		}
+
+		return 0;
+	}
+
+	bool has_units(const size_t location_index, const key_type &key) const
+	{
+		const auto &aggregates = this->aggregates_per_location[location_index];
+		const auto find_iterator = aggregates.find(key);
+		return find_iterator != aggregates.end() && find_iterator->second.unit_count > 0;
+	}
+
+private:
+	std::vector<location_type *> locations;
+	std::unordered_map<const location_type *, size_t> location_indices;
+	std::vector<std::unordered_map<key_type, aggregate, key_hash>> aggregates_per_location;
+};
+
+}
@@ -0,0 +1,398 @@
+#include "population/population_generator.h"
+
+#include "holding/holding.h"
+#include "holding/holding_slot.h"
+#include "map/province.h"
+#include "map/region.h"
+#include "map/world.h"
+#include "population/population_unit.h"
+
+namespace metternich {
+
+size_t population_generator::key_hash::operator()(const key &key) const
+{
+	size_t hash = std::hash<const void *>()(key.type);
+	for (const void *pointer : { static_cast<const void *>(key.culture), static_cast<const void *>(key.religion), static_cast<const void *>(key.phenotype) }) {
+		hash ^= std::hash<const void *>()(pointer) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	}
+	return hash;
+}
+
+population_generator::key population_generator::get_population_unit_key(const population_unit *population_unit)
+{
+	return key{population_unit->get_type(), population_unit->get_culture(), population_unit->get_religion(), population_unit->get_phenotype()};
+}
+
+/**
+**	@brief	Create population units, based on population history for regions, territories and settlement holdings
+*/
+void population_generator::generate()
+{
+	std::vector<population_unit *> base_population_units;
+
+	//add population units with discount existing enabled to the vector of population units used for generation (holding-level population units with that enabled are not used for generation per se, but generated population units may still be discounted from their size), as well as any population units in territories or regions
+	for (province *province : province::get_all()) {
+		for (holding *holding : province->get_settlement_holdings()) {
+			for (const qunique_ptr<population_unit> &population_unit : holding->get_population_units()) {
+				if (population_unit->discounts_existing()) {
+					base_population_units.push_back(population_unit.get());
+				}
+			}
+		}
+
+		for (const qunique_ptr<population_unit> &population_unit : province->get_population_units()) {
+			base_population_units.push_back(population_unit.get());
+		}
+	}
+
+	for (world *world : world::get_all()) {
+		for (holding *holding : world->get_settlement_holdings()) {
+			for (const qunique_ptr<population_unit> &population_unit : holding->get_population_units()) {
+				if (population_unit->discounts_existing()) {
+					base_population_units.push_back(population_unit.get());
+				}
+			}
+		}
+
+		for (const qunique_ptr<population_unit> &population_unit : world->get_population_units()) {
+			base_population_units.push_back(population_unit.get());
+		}
+	}
+
+	for (region *region : region::get_all()) {
+		for (const qunique_ptr<population_unit> &population_unit : region->get_population_units()) {
+			base_population_units.push_back(population_unit.get());
+		}
+	}
+
+	//resolve the sorting criteria beforehand, so that the comparisons don't need to go through the population units' holdings, territories and regions
+	struct sort_entry final
+	{
+		population_unit *population_unit = nullptr;
+		size_t discount_type_count = 0;
+		bool has_holding = false;
+		bool has_territory = false;
+		const metternich::region *region = nullptr;
+		size_t region_territory_count = 0;
+		bool has_culture = false;
+		bool has_religion = false;
+		bool has_phenotype = false;
+		int size = 0;
+	};
+
+	std::vector<sort_entry> sort_entries;
+	sort_entries.reserve(base_population_units.size());
+	for (population_unit *population_unit : base_population_units) {
+		sort_entry entry;
+		entry.population_unit = population_unit;
+		entry.discount_type_count = population_unit->get_discount_types().size();
+		entry.has_holding = population_unit->get_holding() != nullptr;
+		entry.has_territory = population_unit->get_territory() != nullptr;
+		entry.region = population_unit->get_region();
+		entry.region_territory_count = entry.region != nullptr ? entry.region->get_territories().size() : 0;
+		entry.has_culture = population_unit->get_culture() != nullptr;
+		entry.has_religion = population_unit->get_religion() != nullptr;
+		entry.has_phenotype = population_unit->get_phenotype() != nullptr;
+		entry.size = population_unit->get_size();
+		sort_entries.push_back(entry);
+	}
+
+	//sort regions so that ones with less territories are applied first
+	std::sort(sort_entries.begin(), sort_entries.end(), [](const sort_entry &a, const sort_entry &b) {
+		//give priority to population units which discount less types
+		if (a.discount_type_count != b.discount_type_count) {
+			return a.discount_type_count < b.discount_type_count;
+		}
+
+		//give priority to population units located in holdings, then to territories, then to smaller regions
+		if (a.has_holding != b.has_holding) {
+			return a.has_holding;
+		} else if (a.has_territory != b.has_territory) {
+			return a.has_territory;
+		} else if (a.region != b.region) {
+			return a.region_territory_count < b.region_territory_count;
+		}
+
+		//give priority to population units with a culture
+		if (a.has_culture != b.has_culture) {
+			return a.has_culture;
+		}
+
+		//give priority to population units with a religion
+		if (a.has_religion != b.has_religion) {
+			return a.has_religion;
+		}
+
+		//give priority to population units with a phenotype
+		if (a.has_phenotype != b.has_phenotype) {
+			return a.has_phenotype;
+		}
+
+		return a.size < b.size;
+	});
+
+	for (const sort_entry &entry : sort_entries) {
+		population_unit *population_unit = entry.population_unit;
+
+		//subtract the size of other population units for population units that have discount_existing enabled
+		if (population_unit->discounts_existing()) {
+			this->subtract_existing_sizes(population_unit);
+		}
+
+		//distribute territory and region population units to the settlement holdings located in them
+		if (population_unit->get_holding() == nullptr) {
+			if (population_unit->get_territory() != nullptr) {
+				this->distribute(population_unit, this->get_territory_holding_indices(population_unit->get_territory()));
+			} else if (population_unit->get_region() != nullptr) {
+				this->distribute(population_unit, this->get_region_holding_indices(population_unit->get_region()));
+			}
+		}
+	}
+
+	for (population_unit *population_unit : base_population_units) {
+		if (population_unit->discounts_existing()) {
+			population_unit->set_discount_existing(false);
+		}
+	}
+}
+
+/**
+**	@brief	Get the index of a holding, indexing its population units if that hasn't been done yet
+**
+**	@param	holding	The holding
+**
+**	@return	The holding's index
+*/
+size_t population_generator::get_holding_index(holding *holding)
+{
+	const auto [holding_index, added] = this->index.add_location(holding);
+
+	if (added) {
+		this->population_units_per_holding.emplace_back();
+
+		for (const qunique_ptr<population_unit> &population_unit : holding->get_population_units()) {
+			this->index_population_unit(holding_index, population_unit.get(), population_unit->get_size(), 1);
+
+			//if more than one population unit has the same characteristics, the first one is the one which has its size changed by the holding
+			this->population_units_per_holding[holding_index].try_emplace(population_generator::get_population_unit_key(population_unit.get()), population_unit.get());
+		}
+	}
+
+	return holding_index;
+}
+
+/**
+**	@brief	Apply a change to the indexed size of a population unit
+**
+**	@param	holding_index		The index of the population unit's holding
+**	@param	population_unit		The population unit
+**	@param	size_change			The size change
+**	@param	unit_count_change	The change to the population unit count, i.e. 1 if the population unit is being added to the index, or 0 otherwise
+*/
+void population_generator::index_population_unit(const size_t holding_index, const population_unit *population_unit, const int size_change, const int unit_count_change)
+{
+	const key unit_key = population_generator::get_population_unit_key(population_unit);
+
+	//index the population unit under its exact characteristics, as well as under each combination of wildcards for them; a characteristic which is already null is not combined with its wildcard, so that the population unit isn't counted twice for the same key
+	for (int wildcard_mask = 0; wildcard_mask < 8; ++wildcard_mask) {
+		if (((wildcard_mask & 1) && unit_key.culture == nullptr) || ((wildcard_mask & 2) && unit_key.religion == nullptr) || ((wildcard_mask & 4) && unit_key.phenotype == nullptr)) {
+			continue;
+		}
+
+		key wildcard_key = unit_key;
+		if (wildcard_mask & 1) {
+			wildcard_key.culture = nullptr;
+		}
+		if (wildcard_mask & 2) {
+			wildcard_key.religion = nullptr;
+		}
+		if (wildcard_mask & 4) {
+			wildcard_key.phenotype = nullptr;
+		}
+
+		this->index.change(holding_index, wildcard_key, size_change, unit_count_change);
+	}
+}
+
+const std::vector<size_t> &population_generator::get_territory_holding_indices(const territory *territory)
+{
+	auto find_iterator = this->territory_holding_indices.find(territory);
+	if (find_iterator == this->territory_holding_indices.end()) {
+		find_iterator = this->territory_holding_indices.emplace(territory, this->get_distribution_holding_indices(territory->get_settlement_holdings())).first;
+	}
+
+	return find_iterator->second;
+}
+
+const std::vector<size_t> &population_generator::get_region_holding_indices(const region *region)
+{
+	auto find_iterator = this->region_holding_indices.find(region);
+	if (find_iterator == this->region_holding_indices.end()) {
+		find_iterator = this->region_holding_indices.emplace(region, this->get_distribution_holding_indices(region->get_holdings())).first;
+	}
+
+	return find_iterator->second;
+}
+
+/**
+**	@brief	Get the indices of the holdings to which population can be distributed
+**
+**	@param	holdings	The holdings
+**
+**	@return	The holding indices
+*/
+std::vector<size_t> population_generator::get_distribution_holding_indices(const std::vector<holding *> &holdings)
+{
+	std::vector<size_t> holding_indices;
+
+	for (holding *holding : holdings) {
+		if (!holding->get_slot()->is_population_distribution_allowed()) {
+			continue; //if cannot distribute population to a given holding, then don't subtract its population from the size either
+		}
+
+		holding_indices.push_back(this->get_holding_index(holding));
+	}
+
+	return holding_indices;
+}
+
+/**
+**	@brief	Subtract the sizes of applicable existing population units from that of a population unit
+**
+**	@param	population_unit	The population unit
+*/
+void population_generator::subtract_existing_sizes(population_unit *population_unit)
+{
+	//the population unit's null culture, religion or phenotype act as wildcards
+	key query_key = population_generator::get_population_unit_key(population_unit);
+
+	const auto get_existing_size = [&](const size_t holding_index) {
+		int existing_size = 0;
+
+		for (const population_type *discount_type : population_unit->get_discount_types()) {
+			query_key.type = discount_type;
+			existing_size += this->index.get_size(holding_index, query_key);
+		}
+
+		return existing_size;
+	};
+
+	if (population_unit->get_holding() != nullptr) {
+		const size_t holding_index = this->get_holding_index(population_unit->get_holding());
+		int existing_size = get_existing_size(holding_index);
+
+		if (population_unit->get_discount_types().contains(population_unit->get_type())) {
+			existing_size -= population_unit->get_size(); //the population unit itself is indexed in its holding, and matches its own characteristics
+		}
+
+		const int old_size = population_unit->get_size();
+		population_unit->change_size(-existing_size);
+		this->index_population_unit(holding_index, population_unit, population_unit->get_size() - old_size, 0);
+		return;
+	}
+
+	const std::vector<size_t> *holding_indices = nullptr;
+	if (population_unit->get_territory() != nullptr) {
+		holding_indices = &this->get_territory_holding_indices(population_unit->get_territory());
+	} else if (population_unit->get_region() != nullptr) {
+		holding_indices = &this->get_region_holding_indices(population_unit->get_region());
+	} else {
+		return;
+	}
+
+	int existing_size = 0;
+	for (const size_t holding_index : *holding_indices) {
+		existing_size += get_existing_size(holding_index);
+	}
+
+	population_unit->change_size(-existing_size);
+}
+
+/**
+**	@brief	Get the type with which a population unit would be distributed to a holding
+**
+**	@param	population_unit	The population unit
+**	@param	holding_index	The holding's index
+**
+**	@return	The population type for the holding, or null if the population unit cannot be distributed to it
+*/
+population_type *population_generator::get_distribution_type(const population_unit *population_unit, const size_t holding_index) const
+{
+	const holding *holding = this->index.get_location(holding_index);
+
+	population_type *type = population_unit->get_type();
+	if (!holding->can_have_population_type(type)) {
+		type = holding->get_equivalent_population_type(type);
+		if (type == nullptr) {
+			return nullptr;
+		}
+	}
+
+	if (population_unit->discounts_existing()) {
+		//the population unit can only be distributed to the given holding if there is no population unit there with the same type, culture, religion and phenotype as this one, if discount existing is enabled
+		key query_key = population_generator::get_population_unit_key(population_unit);
+
+		if (query_key.culture == nullptr) {
+			query_key.culture = holding->get_culture();
+			if (query_key.culture == nullptr) {
+				query_key.culture = holding->get_territory()->get_culture();
+			}
+		}
+
+		if (this->index.has_units(holding_index, query_key)) {
+			return nullptr;
+		}
+	}
+
+	return type;
+}
+
+/**
+**	@brief	Distribute a population unit to a number of holdings, in equal proportions
+**
+**	@param	population_unit	The population unit
+**	@param	holding_indices	The indices of the holdings
+*/
+void population_generator::distribute(const population_unit *population_unit, const std::vector<size_t> &holding_indices)
+{
+	//gather the holdings to which the population will be applied in a single pass, since applying it to a holding doesn't affect whether it can be applied to another
+	std::vector<std::pair<size_t, population_type *>> distribution_targets;
+
+	for (const size_t holding_index : holding_indices) {
+		population_type *type = this->get_distribution_type(population_unit, holding_index);
+		if (type != nullptr) {
+			distribution_targets.emplace_back(holding_index, type);
+		}
+	}
+
+	if (distribution_targets.empty()) {
+		return;
+	}
+
+	//now, apply the remaining population to all settlement holdings without population set for them, in equal proportions
+	const int size_per_holding = population_unit->get_size() / static_cast<int>(distribution_targets.size());
+
+	if (size_per_holding <= 0) {
+		return;
+	}
+
+	for (const auto &[holding_index, type] : distribution_targets) {
+		const key unit_key{type, population_unit->get_culture(), population_unit->get_religion(), population_unit->get_phenotype()};
+		std::unordered_map<key, metternich::population_unit *, key_hash> &holding_population_units = this->population_units_per_holding[holding_index];
+
+		const auto find_iterator = holding_population_units.find(unit_key);
+		if (find_iterator != holding_population_units.end()) {
+			metternich::population_unit *existing_population_unit = find_iterator->second;
+			const int old_size = existing_population_unit->get_size();
+			existing_population_unit->change_size(size_per_holding);
+			this->index_population_unit(holding_index, existing_population_unit, existing_population_unit->get_size() - old_size, 0);
+		} else {
+			holding *holding = this->index.get_location(holding_index);
+			metternich::population_unit *new_population_unit = holding->create_population_unit(type, population_unit->get_culture(), population_unit->get_religion(), population_unit->get_phenotype(), size_per_holding);
+			holding_population_units.try_emplace(population_generator::get_population_unit_key(new_population_unit), new_population_unit);
+			this->index_population_unit(holding_index, new_population_unit, new_population_unit->get_size(), 1);
+		}
+	}
+}
+
+}
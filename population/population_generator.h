@@ -0,0 +1,65 @@
+#pragma once
+
+#include "population/population_generation_index.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace metternich {
+
+class culture;
+class holding;
+class phenotype;
+class population_type;
+class population_unit;
+class region;
+class religion;
+class territory;
+
+/**
+**	@brief	The generator of population units in settlement holdings, from the population units set in history for holdings, territories and regions
+**
+**	The population units of holdings are indexed by their characteristics, and the holdings of each territory and region are resolved once, so that discounting existing population units and distributing generated ones don't require scanning the population units of each holding for each generating population unit.
+*/
+class population_generator final
+{
+private:
+	//the characteristics of population units, with null culture, religion or phenotype values also being used as wildcards
+	struct key final
+	{
+		const population_type *type = nullptr;
+		const metternich::culture *culture = nullptr;
+		const metternich::religion *religion = nullptr;
+		const metternich::phenotype *phenotype = nullptr;
+
+		bool operator==(const key &other) const = default;
+	};
+
+	struct key_hash final
+	{
+		size_t operator()(const key &key) const;
+	};
+
+	static key get_population_unit_key(const population_unit *population_unit);
+
+public:
+	void generate();
+
+private:
+	size_t get_holding_index(holding *holding);
+	void index_population_unit(const size_t holding_index, const population_unit *population_unit, const int size_change, const int unit_count_change);
+	const std::vector<size_t> &get_territory_holding_indices(const territory *territory);
+	const std::vector<size_t> &get_region_holding_indices(const region *region);
+	std::vector<size_t> get_distribution_holding_indices(const std::vector<holding *> &holdings);
+	void subtract_existing_sizes(population_unit *population_unit);
+	population_type *get_distribution_type(const population_unit *population_unit, const size_t holding_index) const;
+	void distribute(const population_unit *population_unit, const std::vector<size_t> &holding_indices);
+
+private:
+	population_generation_index<holding, key, key_hash> index;
+	std::vector<std::unordered_map<key, population_unit *, key_hash>> population_units_per_holding; //the population units of each indexed holding, by their exact characteristics
+	std::unordered_map<const territory *, std::vector<size_t>> territory_holding_indices; //the indices of the holdings to which population can be distributed, per territory
+	std::unordered_map<const region *, std::vector<size_t>> region_holding_indices;
+};
+
+}
@@ -19,6 +19,7 @@
 #include "script/context.h"
 #include "species/phenotype.h"
 #include "util/container_util.h"
+#include "util/memory_usage.h"
 #include "util/random.h"
 
 #include <QApplication>
@@ -58,7 +59,7 @@ void population_unit::process_history_database()
 		});
 	}
 
-	population_unit::gsml_history_data_to_process.clear();
+	population_unit::clear_gsml_history_data();
 }
 
 void population_unit::initialize_history()
@@ -75,6 +76,14 @@ void population_unit::initialize_history()
 	data_entry_base::initialize_history();
 }
 
+void population_unit::add_owned_memory_usage(memory_usage &usage, memory_report &report) const
+{
+	population_unit_base::add_owned_memory_usage(usage, report);
+
+	usage.add_tree(this->discount_types);
+	usage.add_tree(this->employments);
+}
+
 void population_unit::do_month()
 {
 	if (this->get_size() == 0) {
@@ -130,7 +139,8 @@ void population_unit::do_cultural_derivation()
 		size /= 10000;
 		size = std::max(size, 10); //so that for smaller sizes it won't change too slowly
 		if (size > 0) {
-			size = random::generate(size * 2); //multiply by two so that on average the given size will be chosen
+			random_generator generator = this->get_random_generator("cultural_derivation", culture->get_index());
+			size = generator.generate(size * 2); //multiply by two so that on average the given size will be chosen
 		}
 		size = std::max(size, 2); //2 instead of 1 so that it is always greater than pop. growth
 		size = std::min(size, base_size);
@@ -140,6 +150,19 @@ void population_unit::do_cultural_derivation()
 	}
 }
 
+/**
+**	@brief	Get a random generator keyed by this population unit's holding, its demographic characteristics and the current tick
+**
+**	@param	purpose	The purpose of the generated numbers
+**	@param	key		An additional key for the purpose, e.g. the index of a target culture
+**
+**	@return	The random generator
+*/
+random_generator population_unit::get_random_generator(const std::string_view &purpose, const size_t key) const
+{
+	return random::get_generator(random_stream::population, purpose, key, this->get_holding()->get_slot()->get_index(), this->get_type()->get_index(), this->get_culture()->get_index(), this->get_religion()->get_index(), this->get_phenotype()->get_index(), game::get()->get_total_ticks());
+}
+
 std::vector<std::vector<std::string>> population_unit::get_tag_suffix_list_with_fallbacks() const
 {
 	std::vector<std::vector<std::string>> tag_list_with_fallbacks;
@@ -157,12 +180,32 @@ std::vector<std::vector<std::string>> population_unit::get_tag_suffix_list_with_
 	return tag_list_with_fallbacks;
 }
 
+void population_unit::set_type(population_type *type)
+{
+	if (type == this->get_type()) {
+		return;
+	}
+
+	if (this->get_holding() != nullptr) {
+		this->get_holding()->change_population_group(this->get_type(), nullptr, nullptr, -this->get_size());
+		this->get_holding()->change_population_group(type, nullptr, nullptr, this->get_size());
+	}
+
+	this->type = type;
+	emit type_changed();
+}
+
 void population_unit::set_culture(metternich::culture *culture)
 {
 	if (culture == this->get_culture()) {
 		return;
 	}
 
+	if (this->get_holding() != nullptr) {
+		this->get_holding()->change_population_group(nullptr, this->get_culture(), nullptr, -this->get_size());
+		this->get_holding()->change_population_group(nullptr, culture, nullptr, this->get_size());
+	}
+
 	this->culture = culture;
 	emit culture_changed();
 
@@ -172,6 +215,20 @@ void population_unit::set_culture(metternich::culture *culture)
 	}
 }
 
+void population_unit::set_religion(metternich::religion *religion)
+{
+	if (religion == this->get_religion()) {
+		return;
+	}
+
+	if (this->get_holding() != nullptr) {
+		this->get_holding()->change_population_group(nullptr, nullptr, this->get_religion(), -this->get_size());
+		this->get_holding()->change_population_group(nullptr, nullptr, religion, this->get_size());
+	}
+
+	this->religion = religion;
+	emit religion_changed();
+}
 
 void population_unit::mix_with(population_unit *other_population_unit)
 {
@@ -187,7 +244,8 @@ void population_unit::mix_with(population_unit *other_population_unit)
 	size *= mixing_factor;
 	size /= 10000;
 	if (size > 0) {
-		size = random::generate(size * 2);
+		random_generator generator = this->get_random_generator("mixing", other_population_unit->get_phenotype()->get_index());
+		size = generator.generate(size * 2);
 	}
 	size = std::max(size, 2); //2 instead of 1 so that it is always greater than pop. growth
 	size = std::min(size, base_size);
@@ -238,8 +296,9 @@ void population_unit::set_size(const int size)
 	}
 
 	if (this->get_holding() != nullptr) {
-		//change the population count for the population unit's holding
+		//change the population count and groups for the population unit's holding
 		this->get_holding()->change_population(size_change);
+		this->get_holding()->change_population_group(this->get_type(), this->get_culture(), this->get_religion(), size_change);
 	}
 }
 
@@ -252,7 +311,7 @@ void population_unit::set_holding(metternich::holding *holding)
 	const terrain_type *old_terrain = this->get_terrain();
 
 	if (this->get_holding() != nullptr) {
-		disconnect(this->get_holding(), &holding::terrain_changed, this, &population_unit::terrain_changed);
+		this->get_holding()->change_population_group(this->get_type(), this->get_culture(), this->get_religion(), -this->get_size());
 	}
 
 	this->holding = holding;
@@ -266,7 +325,7 @@ void population_unit::set_holding(metternich::holding *holding)
 	const terrain_type *new_terrain = this->get_terrain();
 
 	if (holding != nullptr) {
-		connect(holding, &holding::terrain_changed, this, &population_unit::terrain_changed);
+		holding->change_population_group(this->get_type(), this->get_culture(), this->get_religion(), this->get_size());
 	}
 
 	if (new_terrain != old_terrain) {
@@ -311,156 +370,6 @@ QVariantList population_unit::get_discount_types_qvariant_list() const
 	return container::to_qvariant_list(this->get_discount_types());
 }
 
-/**
-**	@brief	Subtract the sizes of applicable existing population units from that of this one
-*/
-void population_unit::subtract_existing_sizes()
-{
-	if (this->get_holding() != nullptr) {
-		this->subtract_existing_sizes_in_holding(this->get_holding());
-	} else if (this->get_territory() != nullptr) {
-		this->subtract_existing_sizes_in_holdings(this->get_territory()->get_settlement_holdings());
-	} else if (this->get_region() != nullptr) {
-		this->subtract_existing_sizes_in_holdings(this->get_region()->get_holdings());
-	}
-}
-
-/**
-**	@brief	Subtract the sizes of applicable existing population units in the holding from that of this one
-**
-**	@param	holding	The holding
-*/
-void population_unit::subtract_existing_sizes_in_holding(const metternich::holding *holding)
-{
-	for (const qunique_ptr<population_unit> &population_unit : holding->get_population_units()) {
-		if (population_unit.get() == this) {
-			continue;
-		}
-
-		if (this->get_discount_types().find(population_unit->get_type()) == this->get_discount_types().end()) {
-			continue;
-		}
-
-		if (this->get_culture() != nullptr && population_unit->get_culture() != this->get_culture()) {
-			continue;
-		}
-
-		if (this->get_religion() != nullptr && population_unit->get_religion() != this->get_religion()) {
-			continue;
-		}
-
-		if (this->get_phenotype() != nullptr && population_unit->get_phenotype() != this->get_phenotype()) {
-			continue;
-		}
-
-		this->change_size(-population_unit->get_size());
-	}
-}
-
-/**
-**	@brief	Subtract the sizes of applicable existing population units in the holdings from that of this one
-**
-**	@param	holdings	The holdings
-*/
-void population_unit::subtract_existing_sizes_in_holdings(const std::vector<metternich::holding *> &holdings)
-{
-	for (const metternich::holding *holding : holdings) {
-		if (!holding->get_slot()->is_population_distribution_allowed()) {
-			continue; //if cannot distribute population to a given holding, then don't subtract its population from the size either
-		}
-
-		this->subtract_existing_sizes_in_holding(holding);
-	}
-}
-
-bool population_unit::can_distribute_to_holding(const metternich::holding *holding) const
-{
-	if (!holding->get_slot()->is_population_distribution_allowed()) {
-		return false;
-	}
-
-	if (!holding->can_have_population_type(this->get_type())) {
-		const population_type *valid_equivalent_type = holding->get_equivalent_population_type(this->get_type());
-		if (valid_equivalent_type == nullptr) {
-			return false;
-		}
-	}
-
-	if (this->discounts_existing()) {
-		//the population unit can only be distributed to the given holding if there is no population unit there with the same type, culture, religion and phenotype as this one, if discount existing is enabled
-		for (const qunique_ptr<population_unit> &population_unit : holding->get_population_units()) {
-			if (population_unit->get_type() != this->get_type()) {
-				continue;
-			}
-
-			if (this->get_culture() != nullptr && population_unit->get_culture() != this->get_culture()) {
-				continue;
-			} else if (this->get_culture() == nullptr) {
-				const metternich::culture *holding_culture = holding->get_culture();
-				if (holding_culture == nullptr) {
-					holding_culture = holding->get_territory()->get_culture();
-				}
-
-				if (holding_culture != nullptr && population_unit->get_culture() != holding_culture) {
-					continue;
-				}
-			}
-
-			if (this->get_religion() != nullptr && population_unit->get_religion() != this->get_religion()) {
-				continue;
-			}
-
-			if (this->get_phenotype() != nullptr && population_unit->get_phenotype() != this->get_phenotype()) {
-				continue;
-			}
-
-			return false;
-		}
-	}
-
-	return true;
-}
-
-/**
-**	@brief	Distribute the population unit to a number of holdings, in equal proportions
-**
-**	@param	holdings	The holdings
-*/
-void population_unit::distribute_to_holdings(const std::vector<metternich::holding *> &holdings)
-{
-	//set population for settlement holdings without population data
-	int holding_count = 0; //count of settlement holdings for which the population will be applied
-
-	for (const metternich::holding *holding : holdings) {
-		if (this->can_distribute_to_holding(holding)) {
-			holding_count++;
-		}
-	}
-
-	if (holding_count == 0) {
-		return;
-	}
-
-	//now, apply the remaining population to all settlement holdings without population set for them, in equal proportions
-	const int size_per_holding = this->get_size() / holding_count;
-
-	if (size_per_holding <= 0) {
-		return;
-	}
-
-	for (metternich::holding *holding : holdings) {
-		if (!this->can_distribute_to_holding(holding)) {
-			continue;
-		}
-
-		population_type *type = this->get_type();
-		if (!holding->can_have_population_type(type)) {
-			type = holding->get_equivalent_population_type(type);
-		}
-		holding->change_population_size(type, this->get_culture(), this->get_religion(), this->get_phenotype(), size_per_holding);
-	}
-}
-
 void population_unit::seek_employment()
 {
 	for (employment *employment : this->get_holding()->get_employments()) {
@@ -2,8 +2,10 @@
 
 #include "population/population_unit_base.h"
 #include "database/simple_data_type.h"
+#include "util/object_pool.h"
 
 #include <set>
+#include <string_view>
 
 namespace metternich {
 
@@ -13,10 +15,11 @@ class holding;
 class phenotype;
 class population_type;
 class province;
+class random_generator;
 class religion;
 class terrain_type;
 
-class population_unit final : public population_unit_base, public simple_data_type<population_unit>
+class population_unit final : public population_unit_base, public simple_data_type<population_unit>, public pooled_object<population_unit>
 {
 	Q_OBJECT
 
@@ -36,12 +39,9 @@ public:
 
 	static void process_history_database();
 
+	//population units have no connections of their own for the interface, which views them through pooled proxies instead
 	population_unit(population_type *type) : type(type)
 	{
-		connect(this, &population_unit::type_changed, this, &population_unit_base::icon_path_changed);
-		connect(this, &population_unit::culture_changed, this, &population_unit_base::icon_path_changed);
-		connect(this, &population_unit::religion_changed, this, &population_unit_base::icon_path_changed);
-		connect(this, &population_unit::phenotype_changed, this, &population_unit_base::icon_path_changed);
 	}
 
 	virtual ~population_unit() override
@@ -49,6 +49,7 @@ public:
 	}
 
 	virtual void initialize_history() override;
+	virtual void add_owned_memory_usage(memory_usage &usage, memory_report &report) const override;
 
 	virtual void check_history() const override
 	{
@@ -76,15 +77,7 @@ public:
 		return this->type;
 	}
 
-	void set_type(population_type *type)
-	{
-		if (type == this->get_type()) {
-			return;
-		}
-
-		this->type = type;
-		emit type_changed();
-	}
+	void set_type(population_type *type);
 
 	metternich::culture *get_culture() const
 	{
@@ -98,15 +91,7 @@ public:
 		return this->religion;
 	}
 
-	void set_religion(religion *religion)
-	{
-		if (religion == this->get_religion()) {
-			return;
-		}
-
-		this->religion = religion;
-		emit religion_changed();
-	}
+	void set_religion(religion *religion);
 
 	metternich::phenotype *get_phenotype() const
 	{
@@ -124,6 +109,7 @@ public:
 	}
 
 	void mix_with(population_unit *other_population_unit);
+	random_generator get_random_generator(const std::string_view &purpose, const size_t key) const;
 
 	virtual void set_size(const int size) override;
 
@@ -172,12 +158,6 @@ public:
 		emit discount_types_changed();
 	}
 
-	void subtract_existing_sizes();
-	void subtract_existing_sizes_in_holding(const holding *holding);
-	void subtract_existing_sizes_in_holdings(const std::vector<holding *> &holdings);
-	bool can_distribute_to_holding(const holding *holding) const;
-	void distribute_to_holdings(const std::vector<holding *> &holdings);
-
 	int get_unemployed_size() const
 	{
 		return this->unemployed_size;
@@ -0,0 +1,122 @@
+#include "population/population_unit_view.h"
+
+#include "population/population_unit.h"
+
+namespace metternich {
+
+/**
+**	@brief	Bind the proxy to a population unit
+**
+**	@param	population_unit	The population unit, or null to unbind the proxy
+*/
+void population_unit_view::set_population_unit(metternich::population_unit *population_unit)
+{
+	if (population_unit == this->get_population_unit()) {
+		return;
+	}
+
+	if (this->get_population_unit() != nullptr) {
+		disconnect(this->get_population_unit(), nullptr, this, nullptr);
+	}
+
+	this->population_unit = population_unit;
+
+	if (population_unit != nullptr) {
+		connect(population_unit, &metternich::population_unit::type_changed, this, &population_unit_view::type_changed);
+		connect(population_unit, &metternich::population_unit::culture_changed, this, &population_unit_view::culture_changed);
+		connect(population_unit, &metternich::population_unit::religion_changed, this, &population_unit_view::religion_changed);
+		connect(population_unit, &metternich::population_unit::phenotype_changed, this, &population_unit_view::phenotype_changed);
+		connect(population_unit, &population_unit_base::size_changed, this, &population_unit_view::size_changed);
+		connect(population_unit, &metternich::population_unit::unemployed_size_changed, this, &population_unit_view::unemployed_size_changed);
+		connect(population_unit, &metternich::population_unit::wealth_changed, this, &population_unit_view::wealth_changed);
+
+		//the icon path depends on the population unit's type, culture, religion and phenotype
+		connect(population_unit, &metternich::population_unit::type_changed, this, &population_unit_view::icon_path_changed);
+		connect(population_unit, &metternich::population_unit::culture_changed, this, &population_unit_view::icon_path_changed);
+		connect(population_unit, &metternich::population_unit::religion_changed, this, &population_unit_view::icon_path_changed);
+		connect(population_unit, &metternich::population_unit::phenotype_changed, this, &population_unit_view::icon_path_changed);
+	}
+
+	emit type_changed();
+	emit culture_changed();
+	emit religion_changed();
+	emit phenotype_changed();
+	emit size_changed();
+	emit unemployed_size_changed();
+	emit wealth_changed();
+	emit icon_path_changed();
+}
+
+population_type *population_unit_view::get_type() const
+{
+	if (this->get_population_unit() == nullptr) {
+		return nullptr;
+	}
+
+	return this->get_population_unit()->get_type();
+}
+
+culture *population_unit_view::get_culture() const
+{
+	if (this->get_population_unit() == nullptr) {
+		return nullptr;
+	}
+
+	return this->get_population_unit()->get_culture();
+}
+
+religion *population_unit_view::get_religion() const
+{
+	if (this->get_population_unit() == nullptr) {
+		return nullptr;
+	}
+
+	return this->get_population_unit()->get_religion();
+}
+
+phenotype *population_unit_view::get_phenotype() const
+{
+	if (this->get_population_unit() == nullptr) {
+		return nullptr;
+	}
+
+	return this->get_population_unit()->get_phenotype();
+}
+
+int population_unit_view::get_size() const
+{
+	if (this->get_population_unit() == nullptr) {
+		return 0;
+	}
+
+	return this->get_population_unit()->get_size();
+}
+
+int population_unit_view::get_unemployed_size() const
+{
+	if (this->get_population_unit() == nullptr) {
+		return 0;
+	}
+
+	return this->get_population_unit()->get_unemployed_size();
+}
+
+int population_unit_view::get_wealth() const
+{
+	if (this->get_population_unit() == nullptr) {
+		return 0;
+	}
+
+	return this->get_population_unit()->get_wealth();
+}
+
+QString population_unit_view::get_icon_path_qstring() const
+{
+	if (this->get_population_unit() == nullptr) {
+		return QString();
+	}
+
+	return this->get_population_unit()->get_icon_path_qstring();
+}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+namespace metternich {
+
+class culture;
+class phenotype;
+class population_type;
+class population_unit;
+class religion;
+
+/**
+**	@brief	The proxy through which the interface views a population unit
+**
+**	Population units are created, mixed and removed constantly, while the interface only shows those of the selected holding. The interface is given pooled proxies bound to those population units instead of the population units themselves, so that population units don't need any connections for the interface's sake, e.g. for their icon path.
+*/
+class population_unit_view final : public QObject
+{
+	Q_OBJECT
+
+	Q_PROPERTY(metternich::population_type* type READ get_type NOTIFY type_changed)
+	Q_PROPERTY(metternich::culture* culture READ get_culture NOTIFY culture_changed)
+	Q_PROPERTY(metternich::religion* religion READ get_religion NOTIFY religion_changed)
+	Q_PROPERTY(metternich::phenotype* phenotype READ get_phenotype NOTIFY phenotype_changed)
+	Q_PROPERTY(int size READ get_size NOTIFY size_changed)
+	Q_PROPERTY(int unemployed_size READ get_unemployed_size NOTIFY unemployed_size_changed)
+	Q_PROPERTY(int wealth READ get_wealth NOTIFY wealth_changed)
+	Q_PROPERTY(QString icon_path READ get_icon_path_qstring NOTIFY icon_path_changed)
+
+public:
+	metternich::population_unit *get_population_unit() const
+	{
+		return this->population_unit;
+	}
+
+	void set_population_unit(metternich::population_unit *population_unit);
+
+	//unbind the proxy from its population unit, when it is returned to its pool
+	void reset()
+	{
+		this->set_population_unit(nullptr);
+	}
+
+	population_type *get_type() const;
+	culture *get_culture() const;
+	religion *get_religion() const;
+	phenotype *get_phenotype() const;
+	int get_size() const;
+	int get_unemployed_size() const;
+	int get_wealth() const;
+	QString get_icon_path_qstring() const;
+
+signals:
+	void type_changed();
+	void culture_changed();
+	void religion_changed();
+	void phenotype_changed();
+	void size_changed();
+	void unemployed_size_changed();
+	void wealth_changed();
+	void icon_path_changed();
+
+private:
+	QPointer<metternich::population_unit> population_unit; //cleared if the population unit is destroyed while the proxy is bound to it
+};
+
+}
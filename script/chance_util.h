@@ -13,7 +13,7 @@ template <typename T>
 class chance_factor;
 
 template <typename T, typename U, typename V>
-inline T calculate_chance_list_result(const std::map<T, const chance_factor<U> *> &chance_map, V *scope)
+inline T calculate_chance_list_result(const std::map<T, const chance_factor<U> *> &chance_map, V *scope, random_generator *generator = nullptr)
 {
 	std::map<T, std::pair<int, int>> chance_ranges;
 
@@ -32,7 +32,7 @@ inline T calculate_chance_list_result(const std::map<T, const chance_factor<U> *
 		}
 	}
 
-	const int random_number = random::generate(total_chance_factor);
+	const int random_number = generator != nullptr ? generator->generate(total_chance_factor) : random::generate(total_chance_factor, random_stream::script);
 	for (const auto &kv_pair : chance_ranges) {
 		const T &value = kv_pair.first;
 		const std::pair<int, int> range = kv_pair.second;
@@ -32,6 +32,7 @@
 #include "script/condition/not_condition.h"
 #include "script/condition/or_condition.h"
 #include "script/condition/prowess_condition.h"
+#include "script/condition/realm_size_condition.h"
 #include "script/condition/region_condition.h"
 #include "script/condition/terrain_condition.h"
 #include "script/condition/tier_de_jure_title_condition.h"
@@ -39,6 +40,7 @@
 #include "script/condition/world_condition.h"
 #include "util/parse_util.h"
 #include "util/string_util.h"
+#include "util/trace.h"
 
 namespace metternich {
 
@@ -60,6 +62,8 @@ std::unique_ptr<condition<T>> condition<T>::from_gsml_property(const gsml_proper
 			return std::make_unique<has_trait_condition<T>>(property.get_value(), property.get_operator());
 		} else if (condition_identifier == "prowess") {
 			return std::make_unique<prowess_condition<T>>(std::stoi(property.get_value()), property.get_operator());
+		} else if (condition_identifier == "realm_size") {
+			return std::make_unique<realm_size_condition<T>>(std::stoi(property.get_value()), property.get_operator());
 		} else if (condition_identifier == "wealth") {
 			return std::make_unique<wealth_condition<T>>(property.get_value(), property.get_operator());
 		}
@@ -175,6 +179,8 @@ void condition<T>::process_gsml_scope(const gsml_data &scope)
 template <typename T>
 bool condition<T>::check(const T *scope, const read_only_context &ctx) const
 {
+	TRACE_COUNTER(conditions_evaluated, 1);
+
 	switch (this->get_operator()) {
 		case gsml_operator::assignment:
 			return this->check_assignment(scope, ctx);
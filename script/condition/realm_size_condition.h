@@ -0,0 +1,87 @@
+#pragma once
+
+#include "script/condition/condition.h"
+#include "script/condition/condition_check_base.h"
+
+namespace metternich {
+
+template <typename T>
+class realm_size_condition final : public condition<T>
+{
+public:
+	realm_size_condition(const int realm_size, const gsml_operator effect_operator)
+		: condition<T>(effect_operator), realm_size(realm_size)
+	{
+	}
+
+	virtual const std::string &get_identifier() const override
+	{
+		static const std::string identifier = "realm_size";
+		return identifier;
+	}
+
+	virtual bool check_assignment(const T *scope) const override
+	{
+		return this->check_greater_than_or_equality(scope);
+	}
+
+	virtual bool check_equality(const T *scope) const override
+	{
+		return scope->get_de_facto_statistics().province_count == this->realm_size;
+	}
+
+	virtual bool check_less_than(const T *scope) const override
+	{
+		return scope->get_de_facto_statistics().province_count < this->realm_size;
+	}
+
+	virtual bool check_greater_than(const T *scope) const override
+	{
+		return scope->get_de_facto_statistics().province_count > this->realm_size;
+	}
+
+	virtual void bind_condition_check(condition_check_base &check, const T *scope) const override
+	{
+		scope->connect(scope, &T::de_facto_statistics_changed, scope, [&check](){ check.set_result_recalculation_needed(); }, Qt::ConnectionType::DirectConnection);
+	}
+
+	virtual std::string get_assignment_string() const override
+	{
+		return this->get_greater_than_or_equality_string();
+	}
+
+	virtual std::string get_equality_string() const override
+	{
+		return "Realm size is equal to " + std::to_string(this->realm_size);
+	}
+
+	virtual std::string get_inequality_string() const override
+	{
+		return "Realm size is not equal to " + std::to_string(this->realm_size);
+	}
+
+	virtual std::string get_less_than_string() const override
+	{
+		return "Realm size is less than " + std::to_string(this->realm_size);
+	}
+
+	virtual std::string get_less_than_or_equality_string() const override
+	{
+		return "Realm size is less than or equal to " + std::to_string(this->realm_size);
+	}
+
+	virtual std::string get_greater_than_string() const override
+	{
+		return "Realm size is greater than " + std::to_string(this->realm_size);
+	}
+
+	virtual std::string get_greater_than_or_equality_string() const override
+	{
+		return "Realm size is greater than or equal to " + std::to_string(this->realm_size);
+	}
+
+private:
+	int realm_size = 0; //the amount of provinces in the realm
+};
+
+}
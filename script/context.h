@@ -1,5 +1,8 @@
 #pragma once
 
+#include "util/random.h"
+
+#include <optional>
 #include <type_traits>
 
 namespace metternich {
@@ -18,6 +21,25 @@ struct context_base
 
 struct context final : context_base<false>
 {
+public:
+	random_generator *get_random_generator() const
+	{
+		return this->generator.has_value() ? &this->generator.value() : nullptr;
+	}
+
+	//generate a random number from the keyed generator, if any, or otherwise from the script stream
+	template <typename T = int>
+	T generate_random(const T modulo) const
+	{
+		if (this->generator.has_value()) {
+			return this->generator->generate(modulo);
+		}
+
+		return random::generate(modulo, random_stream::script);
+	}
+
+	//the keyed generator for the script's random numbers, set e.g. when events are triggered for a scope in a given tick; it is copied together with the context, so that deferred effects (e.g. those of event options chosen by the player) continue its sequence deterministically
+	mutable std::optional<random_generator> generator;
 };
 
 struct read_only_context final : context_base<true>
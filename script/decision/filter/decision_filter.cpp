@@ -1,5 +1,7 @@
 #include "script/decision/filter/decision_filter.h"
 
+#include "character/character.h"
+#include "game/game.h"
 #include "script/context.h"
 #include "script/decision/scoped_decision.h"
 #include "util/random.h"
@@ -9,6 +11,8 @@ namespace metternich {
 template <typename T>
 void decision_filter<T>::do_ai_decisions(const std::vector<T *> &scopes, character *source_character) const
 {
+	random_generator generator = random::get_generator(random_stream::script, "ai_decisions", source_character->get_index(), game::get()->get_total_ticks());
+
 	for (const auto *decision : this->decisions) {
 		if (!decision->check_source_conditions(source_character)) {
 			continue;
@@ -19,7 +23,7 @@ void decision_filter<T>::do_ai_decisions(const std::vector<T *> &scopes, charact
 				continue;
 			}
 
-			if (random::generate(100) >= decision->calculate_ai_chance(scope, source_character)) {
+			if (generator.generate(100) >= decision->calculate_ai_chance(scope, source_character)) {
 				continue;
 			}
 
@@ -3,6 +3,7 @@
 #include "character/character.h"
 #include "game/game.h"
 #include "holding/holding.h"
+#include "holding/holding_slot.h"
 
 namespace metternich {
 
@@ -30,7 +31,7 @@ Q_INVOKABLE void holding_decision::do_effects(const QVariant &holding_variant, c
 	QObject *source_object = qvariant_cast<QObject *>(source_variant);
 	character *source = static_cast<metternich::character *>(source_object);
 
-	game::get()->post_order([this, holding, source]() {
+	game::get()->post_order("holding_decision " + this->get_identifier() + " " + holding->get_slot()->get_identifier() + " " + source->get_identifier(), [this, holding, source]() {
 		//check again as the UI may have been in an old state, and allowed clicking on a now-invalid decision
 		if (scoped_decision::check_conditions(holding, source)) {
 			scoped_decision::do_effects(holding, source);
@@ -5,9 +5,9 @@
 #include "database/gsml_data.h"
 #include "database/gsml_property.h"
 #include "game/engine_interface.h"
+#include "script/context.h"
 #include "script/effect/effect.h"
 #include "script/effect/effect_list.h"
-#include "util/random.h"
 #include "util/string_util.h"
 
 namespace metternich {
@@ -61,7 +61,7 @@ public:
 		bool success = true;
 		int enemy_amount = this->enemy_amount;
 		while (enemy_amount > 0) {
-			success = this->do_combat(scope);
+			success = this->do_combat(scope, ctx);
 			if (!success) {
 				break;
 			}
@@ -122,7 +122,7 @@ private:
 		return this->enemy_prowess;
 	}
 
-	bool do_combat(const T *scope) const
+	bool do_combat(const T *scope, const context &ctx) const
 	{
 		if (!scope->is_alive()) {
 			return false; //the character has already been killed in a previous combat
@@ -132,7 +132,7 @@ private:
 		int temp_enemy_prowess = this->get_enemy_prowess();
 
 		while (temp_prowess > 0 && temp_enemy_prowess > 0) {
-			const int roll_result = this->do_combat_roll(temp_prowess, temp_enemy_prowess);
+			const int roll_result = this->do_combat_roll(temp_prowess, temp_enemy_prowess, ctx);
 			if (roll_result < 0) {
 				temp_prowess += roll_result;
 			} else {
@@ -144,9 +144,9 @@ private:
 		return temp_prowess > 0;
 	}
 
-	int do_combat_roll(const int temp_prowess, const int temp_enemy_prowess) const
+	int do_combat_roll(const int temp_prowess, const int temp_enemy_prowess, const context &ctx) const
 	{
-		return random::generate(temp_prowess) - random::generate(temp_enemy_prowess);
+		return ctx.generate_random(temp_prowess) - ctx.generate_random(temp_enemy_prowess);
 	}
 
 private:
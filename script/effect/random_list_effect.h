@@ -4,9 +4,8 @@
 #include "database/gsml_data.h"
 #include "script/effect/effect.h"
 #include "script/effect/effect_list.h"
+#include "script/context.h"
 #include "script/factor_modifier.h"
-#include "util/random.h"
-#include "util/vector_random_util.h"
 
 #include <memory>
 #include <vector>
@@ -97,7 +96,7 @@ public:
 		const std::vector<const random_list_entry<T> *> weighted_entries = this->get_weighted_entries(scope, ctx);
 
 		if (!weighted_entries.empty()) {
-			const random_list_entry<T> *chosen_entry = vector::get_random(weighted_entries);
+			const random_list_entry<T> *chosen_entry = weighted_entries[ctx.generate_random(weighted_entries.size())];
 			chosen_entry->do_effects(scope, ctx);
 		}
 	}
@@ -27,7 +27,7 @@ QVariantList event_instance::get_options() const
 
 void event_option_instance::do_effects() const
 {
-	game::get()->post_order(this->option_effects);
+	game::get()->post_order("event_option " + this->name.toStdString(), this->option_effects);
 }
 
 }
@@ -1,7 +1,10 @@
 #include "script/event/event_trigger.h"
 
+#include "game/game.h"
 #include "script/context.h"
 #include "script/event/scoped_event_base.h"
+#include "util/random.h"
+#include "util/trace.h"
 #include "util/vector_random_util.h"
 
 namespace metternich {
@@ -9,9 +12,20 @@ namespace metternich {
 template <typename T>
 void event_trigger<T>::do_events(T *scope, const context &ctx) const
 {
+	TRACE_SCOPE("event_trigger::do_events");
+
+	if (!ctx.generator.has_value()) {
+		//key the random numbers drawn by the events on the trigger, the scope and the tick, so that triggers for different scopes don't depend on each other's draws
+		context keyed_ctx = ctx;
+		keyed_ctx.generator = random::get_generator(random_stream::script, this->get_identifier(), scope->get_index(), game::get()->get_total_ticks());
+		this->do_events(scope, keyed_ctx);
+		return;
+	}
+
 	for (const auto *event : this->events) {
 		if (event->check_conditions(scope, ctx)) {
 			event->do_event(scope, ctx);
+			TRACE_COUNTER(events_fired, 1);
 		}
 	}
 
@@ -23,7 +37,8 @@ void event_trigger<T>::do_events(T *scope, const context &ctx) const
 		}
 	}
 	if (!random_events.empty()) {
-		vector::get_random(random_events)->do_event(scope, ctx);
+		vector::get_random(random_events, *ctx.generator)->do_event(scope, ctx);
+		TRACE_COUNTER(events_fired, 1);
 	}
 }
 
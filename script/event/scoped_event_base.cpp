@@ -166,7 +166,7 @@ void scoped_event_base<T>::pick_option(T *scope, const context &ctx) const
 		option_ai_chances[option.get()] = option->get_ai_chance_factor();
 	}
 
-	const event_option<T> *option = calculate_chance_list_result(option_ai_chances, scope);
+	const event_option<T> *option = calculate_chance_list_result(option_ai_chances, scope, ctx.get_random_generator());
 	option->do_effects(scope, ctx);
 }
 
@@ -0,0 +1,171 @@
+#include "species/wildlife_generator.h"
+
+#include "map/province.h"
+#include "map/region.h"
+#include "species/wildlife_unit.h"
+
+#include <QApplication>
+
+namespace metternich {
+
+void wildlife_generator::generate()
+{
+	std::vector<wildlife_unit *> base_wildlife_units;
+
+	//add wildlife units with discount existing enabled to the vector of wildlife units used for generation (province-level population units with that enabled are not used for generation per se, but generated wildlife units may still be discounted from their size), as well as any wildlife units in regions
+	for (province *province : province::get_all()) {
+		for (const qunique_ptr<wildlife_unit> &wildlife_unit : province->get_wildlife_units()) {
+			if (wildlife_unit->discounts_existing()) {
+				base_wildlife_units.push_back(wildlife_unit.get());
+			}
+		}
+	}
+
+	for (region *region : region::get_all()) {
+		for (const qunique_ptr<wildlife_unit> &wildlife_unit : region->get_wildlife_units()) {
+			base_wildlife_units.push_back(wildlife_unit.get());
+		}
+	}
+
+	//sort regions so that ones with less provinces are applied first
+	std::sort(base_wildlife_units.begin(), base_wildlife_units.end(), [](wildlife_unit *a, wildlife_unit *b) {
+		//give priority to population units located in provinces, then to smaller regions
+		if ((a->get_province() != nullptr) != (b->get_province() != nullptr)) {
+			return a->get_province() != nullptr;
+		} else if (a->get_region() != b->get_region()) {
+			return a->get_region()->get_provinces().size() < b->get_region()->get_provinces().size();
+		}
+
+		return a->get_size() < b->get_size();
+	});
+
+	for (wildlife_unit *wildlife_unit : base_wildlife_units) {
+		//subtract the size of other wildlife units for wildlife units that have discount_existing enabled
+		if (wildlife_unit->discounts_existing()) {
+			this->subtract_existing_sizes(wildlife_unit);
+		}
+
+		//distribute region wildlife units to the provinces located in them
+		if (wildlife_unit->get_province() == nullptr) {
+			if (wildlife_unit->get_region() != nullptr) {
+				this->distribute(wildlife_unit, this->get_region_province_indices(wildlife_unit->get_region()));
+			}
+		}
+	}
+
+	for (wildlife_unit *wildlife_unit : base_wildlife_units) {
+		if (wildlife_unit->discounts_existing()) {
+			wildlife_unit->set_discount_existing(false);
+		}
+	}
+}
+
+/**
+**	@brief	Get the index of a province, indexing its wildlife units if that hasn't been done yet
+**
+**	@param	province	The province
+**
+**	@return	The province's index
+*/
+size_t wildlife_generator::get_province_index(province *province)
+{
+	const auto [province_index, added] = this->index.add_location(province);
+
+	if (added) {
+		for (const qunique_ptr<wildlife_unit> &wildlife_unit : province->get_wildlife_units()) {
+			this->index.change(province_index, wildlife_unit->get_species(), wildlife_unit->get_size(), 1);
+		}
+	}
+
+	return province_index;
+}
+
+const std::vector<size_t> &wildlife_generator::get_region_province_indices(const region *region)
+{
+	auto find_iterator = this->region_province_indices.find(region);
+
+	if (find_iterator == this->region_province_indices.end()) {
+		std::vector<size_t> province_indices;
+		for (province *province : region->get_provinces()) {
+			province_indices.push_back(this->get_province_index(province));
+		}
+
+		find_iterator = this->region_province_indices.emplace(region, std::move(province_indices)).first;
+	}
+
+	return find_iterator->second;
+}
+
+/**
+**	@brief	Subtract the sizes of existing wildlife units of the same species from that of a wildlife unit
+**
+**	@param	wildlife_unit	The wildlife unit
+*/
+void wildlife_generator::subtract_existing_sizes(wildlife_unit *wildlife_unit)
+{
+	const species *species = wildlife_unit->get_species();
+
+	if (wildlife_unit->get_province() != nullptr) {
+		const size_t province_index = this->get_province_index(wildlife_unit->get_province());
+
+		//the wildlife unit itself is indexed in its province
+		const int existing_size = this->index.get_size(province_index, species) - wildlife_unit->get_size();
+
+		const int old_size = wildlife_unit->get_size();
+		wildlife_unit->change_size(-existing_size);
+		this->index.change(province_index, species, wildlife_unit->get_size() - old_size, 0);
+	} else if (wildlife_unit->get_region() != nullptr) {
+		int existing_size = 0;
+		for (const size_t province_index : this->get_region_province_indices(wildlife_unit->get_region())) {
+			existing_size += this->index.get_size(province_index, species);
+		}
+
+		wildlife_unit->change_size(-existing_size);
+	}
+}
+
+/**
+**	@brief	Distribute a wildlife unit to a number of provinces, in equal proportions
+**
+**	@param	wildlife_unit		The wildlife unit
+**	@param	province_indices	The indices of the provinces
+*/
+void wildlife_generator::distribute(const wildlife_unit *wildlife_unit, const std::vector<size_t> &province_indices)
+{
+	//gather the provinces to which the population will be applied in a single pass, since applying it to a province doesn't affect whether it can be applied to another
+	std::vector<size_t> distribution_province_indices;
+
+	for (const size_t province_index : province_indices) {
+		//the wildlife unit can only be distributed to the given province if there is no wildlife unit there with the same species as this one, if discount existing is enabled
+		if (wildlife_unit->discounts_existing() && this->index.has_units(province_index, wildlife_unit->get_species())) {
+			continue;
+		}
+
+		distribution_province_indices.push_back(province_index);
+	}
+
+	if (distribution_province_indices.empty()) {
+		return;
+	}
+
+	//now, apply the remaining population to all provinces without population of that species set for them, in equal proportions
+	const int size_per_province = wildlife_unit->get_size() / static_cast<int>(distribution_province_indices.size());
+
+	if (size_per_province <= 0) {
+		return;
+	}
+
+	for (const size_t province_index : distribution_province_indices) {
+		province *province = this->index.get_location(province_index);
+
+		auto new_wildlife_unit = make_qunique<metternich::wildlife_unit>(wildlife_unit->get_species());
+		new_wildlife_unit->moveToThread(QApplication::instance()->thread());
+		new_wildlife_unit->set_province(province);
+		new_wildlife_unit->set_size(size_per_province);
+		province->add_wildlife_unit(std::move(new_wildlife_unit));
+
+		this->index.change(province_index, wildlife_unit->get_species(), size_per_province, 1);
+	}
+}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "population/population_generation_index.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace metternich {
+
+class province;
+class region;
+class species;
+class wildlife_unit;
+
+/**
+**	@brief	The generator of wildlife units in provinces, from the wildlife units set in history for provinces and regions
+**
+**	The wildlife units of provinces are indexed by species, and the provinces of each region are resolved once, so that discounting existing wildlife units and distributing generated ones don't require scanning the wildlife units of each province for each generating wildlife unit.
+*/
+class wildlife_generator final
+{
+public:
+	void generate();
+
+private:
+	size_t get_province_index(province *province);
+	const std::vector<size_t> &get_region_province_indices(const region *region);
+	void subtract_existing_sizes(wildlife_unit *wildlife_unit);
+	void distribute(const wildlife_unit *wildlife_unit, const std::vector<size_t> &province_indices);
+
+private:
+	population_generation_index<province, const species *> index;
+	std::unordered_map<const region *, std::vector<size_t>> region_province_indices;
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include "database/simple_data_type.h"
 #include "population/population_unit_base.h"
+#include "util/object_pool.h"
 
 #include <QObject>
 
@@ -11,7 +12,7 @@ namespace metternich {
 
 class species;
 
-class wildlife_unit final : public population_unit_base, public simple_data_type<wildlife_unit>
+class wildlife_unit final : public population_unit_base, public simple_data_type<wildlife_unit>, public pooled_object<wildlife_unit>
 {
 	Q_OBJECT
 
@@ -38,12 +39,6 @@ public:
 
 	int get_biomass() const;
 
-	void subtract_existing_sizes();
-	void subtract_existing_sizes_in_province(const metternich::province *province);
-	void subtract_existing_sizes_in_provinces(const std::set<metternich::province *> &provinces);
-	bool can_distribute_to_province(const metternich::province *province) const;
-	void distribute_to_provinces(const std::set<metternich::province *> &provinces);
-
 	virtual const std::filesystem::path &get_icon_path() const override;
 
 signals:
@@ -2,8 +2,6 @@
 
 #include "holding/building.h"
 #include "script/condition/and_condition.h"
-#include "script/condition/has_technology_condition.h"
-#include "script/condition/hidden_condition.h"
 #include "script/modifier.h"
 #include "technology/technology_area.h"
 #include "technology/technology_set.h"
@@ -52,22 +50,25 @@ void technology::process_gsml_scope(const gsml_data &scope)
 
 void technology::initialize()
 {
-	if (!this->get_required_technologies().empty()) {
-		if (this->conditions == nullptr) {
-			this->conditions = std::make_unique<and_condition<territory>>();
-		}
+	//the requirements of technologies are checked with bitsets by territories, rather than by condition checks
+	this->required_technology_bitset = technology_bitset(technology::get_index_count());
+	this->all_required_technology_bitset = technology_bitset(technology::get_index_count());
 
-		auto hidden_condition = std::make_unique<metternich::hidden_condition<territory>>();
-		for (technology *required_technology : this->get_required_technologies()) {
-			auto condition = std::make_unique<has_technology_condition<territory>>(required_technology);
-			hidden_condition->add_condition(std::move(condition));
+	for (technology *required_technology : this->get_required_technologies()) {
+		if (!required_technology->is_initialized()) {
+			required_technology->initialize();
 		}
-		this->conditions->add_condition(std::move(hidden_condition));
+
+		this->required_technology_bitset.insert(required_technology->get_index());
+		this->all_required_technology_bitset.insert(required_technology->get_index());
+		this->all_required_technology_bitset |= required_technology->get_all_required_technology_bitset();
 	}
 
 	std::sort(this->allowed_buildings.begin(), this->allowed_buildings.end(), [](const building *a, const building *b) {
 		return a->get_identifier() < b->get_identifier();
 	});
+
+	data_entry_base::initialize();
 }
 
 void technology::check() const
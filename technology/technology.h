@@ -2,6 +2,7 @@
 
 #include "database/data_entry.h"
 #include "database/data_type.h"
+#include "technology/technology_bitset.h"
 
 namespace metternich {
 
@@ -94,6 +95,16 @@ public:
 
 	QVariantList get_required_technologies_qvariant_list() const;
 
+	const technology_bitset &get_required_technology_bitset() const
+	{
+		return this->required_technology_bitset;
+	}
+
+	const technology_bitset &get_all_required_technology_bitset() const
+	{
+		return this->all_required_technology_bitset;
+	}
+
 	bool requires_technology(technology *technology) const
 	{
 		if (this->required_technologies.contains(technology)) {
@@ -117,6 +128,11 @@ public:
 
 	Q_INVOKABLE void remove_required_technology(technology *technology);
 
+	const std::vector<technology *> &get_allowed_technologies() const
+	{
+		return this->allowed_technologies;
+	}
+
 	const std::vector<const building *> &get_allowed_buildings() const
 	{
 		return this->allowed_buildings;
@@ -165,6 +181,8 @@ private:
 	technology_area *area = nullptr;
 	std::string icon_tag;
 	std::set<technology *> required_technologies;
+	technology_bitset required_technology_bitset; //the required technologies, as a bitset
+	technology_bitset all_required_technology_bitset; //the required technologies and their own requirements, recursively
 	std::vector<technology *> allowed_technologies; //technologies allowed by this one
 	std::vector<const building *> allowed_buildings; //buildings allowed by this technology
 	std::unique_ptr<condition<territory>> preconditions;
@@ -15,6 +15,7 @@ class technology_area final : public data_entry, public data_type<technology_are
 	Q_PROPERTY(metternich::technology_category category MEMBER category READ get_category)
 	Q_PROPERTY(QString category_name READ get_category_name_qstring CONSTANT)
 	Q_PROPERTY(QVariantList technologies READ get_technologies_qvariant_list CONSTANT)
+	Q_PROPERTY(int diffusion_modifier MEMBER diffusion_modifier READ get_diffusion_modifier)
 
 public:
 	static constexpr const char *class_identifier = "technology_area";
@@ -49,9 +50,15 @@ public:
 
 	int get_min_level() const;
 
+	int get_diffusion_modifier() const
+	{
+		return this->diffusion_modifier;
+	}
+
 private:
 	technology_category category;
 	std::vector<technology *> technologies;
+	int diffusion_modifier = 100; //the modifier for the diffusion of the area's technologies between provinces
 };
 
 }
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace metternich {
+
+/**
+**	@brief	A set of technologies, stored as a bitset over the technologies' dense indices
+**
+**	Set operations work a word at a time, so that checking whether a territory has all the prerequisites of a technology is a handful of AND operations. The bitset grows as needed when technologies are inserted, and missing words are treated as empty.
+*/
+class technology_bitset final
+{
+public:
+	using word = uint64_t;
+
+	static constexpr size_t word_bits = sizeof(word) * 8;
+
+	technology_bitset()
+	{
+	}
+
+	explicit technology_bitset(const size_t technology_count) : words((technology_count + word_bits - 1) / word_bits, 0)
+	{
+	}
+
+	bool operator ==(const technology_bitset &other) const
+	{
+		const size_t word_count = std::max(this->words.size(), other.words.size());
+		for (size_t i = 0; i < word_count; ++i) {
+			if (this->get_word(i) != other.get_word(i)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	//an ordering consistent with equality, so that bitsets can be used as map keys
+	bool operator <(const technology_bitset &other) const
+	{
+		const size_t word_count = std::max(this->words.size(), other.words.size());
+		for (size_t i = 0; i < word_count; ++i) {
+			if (this->get_word(i) != other.get_word(i)) {
+				return this->get_word(i) < other.get_word(i);
+			}
+		}
+
+		return false;
+	}
+
+	technology_bitset &operator |=(const technology_bitset &other)
+	{
+		if (other.words.size() > this->words.size()) {
+			this->words.resize(other.words.size(), 0);
+		}
+
+		for (size_t i = 0; i < other.words.size(); ++i) {
+			this->words[i] |= other.words[i];
+		}
+
+		return *this;
+	}
+
+	technology_bitset &operator &=(const technology_bitset &other)
+	{
+		for (size_t i = 0; i < this->words.size(); ++i) {
+			this->words[i] &= other.get_word(i);
+		}
+
+		return *this;
+	}
+
+	bool empty() const
+	{
+		for (const word word : this->words) {
+			if (word != 0) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	size_t count() const
+	{
+		size_t count = 0;
+		for (const word word : this->words) {
+			count += static_cast<size_t>(std::popcount(word));
+		}
+		return count;
+	}
+
+	bool contains(const size_t index) const
+	{
+		return (this->get_word(index / word_bits) >> (index % word_bits)) & 1;
+	}
+
+	//whether this set contains all the technologies in the other one
+	bool contains_all(const technology_bitset &other) const
+	{
+		for (size_t i = 0; i < other.words.size(); ++i) {
+			if ((other.words[i] & ~this->get_word(i)) != 0) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void insert(const size_t index)
+	{
+		const size_t word_index = index / word_bits;
+		if (word_index >= this->words.size()) {
+			this->words.resize(word_index + 1, 0);
+		}
+
+		this->words[word_index] |= word(1) << (index % word_bits);
+	}
+
+	void erase(const size_t index)
+	{
+		const size_t word_index = index / word_bits;
+		if (word_index >= this->words.size()) {
+			return;
+		}
+
+		this->words[word_index] &= ~(word(1) << (index % word_bits));
+	}
+
+	void set(const size_t index, const bool value)
+	{
+		if (value) {
+			this->insert(index);
+		} else {
+			this->erase(index);
+		}
+	}
+
+	void clear()
+	{
+		this->words.clear();
+	}
+
+	//call a function for the index of each technology in the set, in increasing order
+	template <typename function_type>
+	void for_each(const function_type &function) const
+	{
+		for (size_t i = 0; i < this->words.size(); ++i) {
+			word remaining_word = this->words[i];
+			while (remaining_word != 0) {
+				function(i * word_bits + static_cast<size_t>(std::countr_zero(remaining_word)));
+				remaining_word &= remaining_word - 1;
+			}
+		}
+	}
+
+	const std::vector<word> &get_words() const
+	{
+		return this->words;
+	}
+
+private:
+	word get_word(const size_t word_index) const
+	{
+		if (word_index >= this->words.size()) {
+			return 0;
+		}
+
+		return this->words[word_index];
+	}
+
+private:
+	std::vector<word> words;
+};
+
+}
@@ -0,0 +1,233 @@
+#include "technology/technology_diffusion.h"
+
+#include "database/defines.h"
+#include "economy/trade_route.h"
+#include "map/province.h"
+#include "map/province_adjacency.h"
+#include "map/world.h"
+#include "technology/technology.h"
+#include "technology/technology_area.h"
+#include "util/memory_usage.h"
+#include "util/trace.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace metternich {
+
+static constexpr uint32_t no_row = std::numeric_limits<uint32_t>::max();
+
+technology_diffusion::technology_diffusion(const metternich::world *world) : world(world)
+{
+	//the adjacency graph of the world doesn't change after it has been loaded, so the matrix only needs to be rebuilt when the counties, trade nodes or active trade routes of provinces change; the connections are direct, as they are changed in the game loop thread
+	const auto set_matrix_outdated = [this]() {
+		this->matrix_outdated = true;
+	};
+
+	for (const province *province : world->get_provinces()) {
+		QObject::connect(province, &territory::county_changed, world, set_matrix_outdated, Qt::ConnectionType::DirectConnection);
+		QObject::connect(province, &metternich::province::trade_node_changed, world, set_matrix_outdated, Qt::ConnectionType::DirectConnection);
+		QObject::connect(province, &metternich::province::active_trade_routes_changed, world, set_matrix_outdated, Qt::ConnectionType::DirectConnection);
+	}
+}
+
+/**
+**	@brief	Spread technologies between the world's provinces
+*/
+void technology_diffusion::do_month()
+{
+	TRACE_SCOPE("technology_diffusion::do_month");
+
+	const int diffusion_rate = defines::get()->get_technology_diffusion_rate();
+	if (diffusion_rate == 0) {
+		return;
+	}
+
+	if (this->matrix_outdated) {
+		this->build_matrix();
+		this->matrix_outdated = false;
+	}
+
+	const int threshold = defines::get()->get_technology_diffusion_threshold();
+
+	std::vector<std::pair<province *, technology *>> acquisitions;
+
+	if (this->exposures.size() != technology::get_index_count()) {
+		this->exposures.assign(technology::get_index_count(), 0);
+	}
+
+	for (size_t i = 0; i < this->provinces.size(); ++i) {
+		province *province = this->provinces[i];
+		const long long int population = province->get_population();
+
+		this->exposed_technology_indices.clear();
+
+		for (size_t j = this->row_offsets[i]; j < this->row_offsets[i + 1]; ++j) {
+			const metternich::province *other_province = this->provinces[this->columns[j]];
+
+			//more populous provinces have a greater influence on less populous ones, and vice-versa
+			const long long int other_population = other_province->get_population();
+			if (other_population == 0) {
+				continue;
+			}
+
+			const long long int weight = this->weights[j] * 2 * other_population / (population + other_population);
+			if (weight <= 0) {
+				continue;
+			}
+
+			other_province->get_technology_bitset().for_each([this, weight](const size_t technology_index) {
+				long long int &exposure = this->exposures[technology_index];
+				if (exposure == 0) {
+					this->exposed_technology_indices.push_back(technology_index);
+				}
+
+				exposure += weight;
+			});
+		}
+
+		//technologies are processed in index order, so that the result doesn't depend on the order of the row's entries
+		std::sort(this->exposed_technology_indices.begin(), this->exposed_technology_indices.end());
+
+		for (const size_t technology_index : this->exposed_technology_indices) {
+			const long long int exposure = this->exposures[technology_index];
+			this->exposures[technology_index] = 0;
+
+			technology *technology = metternich::technology::get_by_index(technology_index);
+			if (!province->can_acquire_technology(technology)) {
+				continue;
+			}
+
+			const long long int progress = exposure * diffusion_rate / 1000 * technology->get_area()->get_diffusion_modifier() / 100;
+			if (province->change_technology_progress(technology, static_cast<int>(std::min<long long int>(progress, threshold))) >= threshold) {
+				acquisitions.emplace_back(province, technology);
+			}
+		}
+	}
+
+	//technologies are acquired only after the exposures of all provinces have been calculated, so that the result doesn't depend on the order of the provinces
+	for (const auto &[province, technology] : acquisitions) {
+		province->change_technology_progress(technology, -province->get_technology_progress(technology));
+		province->add_technology(technology);
+	}
+}
+
+void technology_diffusion::add_memory_usage(memory_usage &usage) const
+{
+	usage.add_vector(this->provinces);
+	usage.add_vector(this->row_offsets);
+	usage.add_vector(this->columns);
+	usage.add_vector(this->weights);
+	usage.add_vector(this->rows_by_province_index);
+	usage.add_vector(this->exposures);
+	usage.add_vector(this->exposed_technology_indices);
+}
+
+void technology_diffusion::build_matrix()
+{
+	this->provinces.clear();
+	this->row_offsets.clear();
+	this->columns.clear();
+	this->weights.clear();
+
+	for (province *province : this->world->get_provinces()) {
+		if (province->get_county() != nullptr && province->is_land()) {
+			this->provinces.push_back(province);
+		}
+	}
+
+	std::sort(this->provinces.begin(), this->provinces.end(), [](const province *a, const province *b) {
+		return a->get_index() < b->get_index();
+	});
+
+	this->rows_by_province_index.assign(province::get_index_count(), no_row);
+	for (size_t i = 0; i < this->provinces.size(); ++i) {
+		this->rows_by_province_index[this->provinces[i]->get_index()] = static_cast<uint32_t>(i);
+	}
+
+	const province_adjacency &adjacency = this->world->get_province_adjacency();
+	const long long int trade_route_weight = defines::get()->get_technology_diffusion_trade_route_weight();
+	const long long int trade_node_modifier = defines::get()->get_technology_diffusion_trade_node_modifier();
+
+	std::vector<std::pair<uint32_t, long long int>> row_entries;
+
+	for (const province *province : this->provinces) {
+		this->row_offsets.push_back(static_cast<uint32_t>(this->columns.size()));
+		row_entries.clear();
+
+		//the weight of bordering provinces is their share of the province's border, including the borders with water; river crossings count as an average border
+		long long int total_border_length = 0;
+		int border_count = 0;
+		for (const province_adjacency::edge &edge : adjacency.get_edges(province)) {
+			if (edge.border_length > 0) {
+				total_border_length += edge.border_length;
+				++border_count;
+			}
+		}
+
+		if (total_border_length > 0) {
+			const long long int river_crossing_length = total_border_length / border_count;
+
+			for (const province_adjacency::edge &edge : adjacency.get_edges(province)) {
+				const uint32_t row = this->rows_by_province_index[edge.province->get_index()];
+				if (row == no_row) {
+					continue;
+				}
+
+				const long long int border_length = edge.river_crossing ? river_crossing_length : edge.border_length;
+				row_entries.emplace_back(row, border_length * 1000 / total_border_length);
+			}
+		}
+
+		//active trade routes connect their endpoints
+		if (trade_route_weight != 0) {
+			for (const trade_route *route : province->get_trade_routes()) {
+				if (!route->is_active() || !route->is_endpoint(province)) {
+					continue;
+				}
+
+				for (const metternich::province *endpoint : route->get_path_endpoints()) {
+					if (endpoint == province) {
+						continue;
+					}
+
+					const uint32_t row = this->rows_by_province_index[endpoint->get_index()];
+					if (row != no_row) {
+						row_entries.emplace_back(row, trade_route_weight);
+					}
+				}
+			}
+		}
+
+		std::sort(row_entries.begin(), row_entries.end());
+
+		for (size_t i = 0; i < row_entries.size(); ++i) {
+			const uint32_t row = row_entries[i].first;
+			long long int weight = row_entries[i].second;
+
+			//merge the entries for the same province, e.g. if it is both a neighbor and connected by a trade route
+			while (i + 1 < row_entries.size() && row_entries[i + 1].first == row) {
+				++i;
+				weight += row_entries[i].second;
+			}
+
+			const metternich::province *other_province = this->provinces[row];
+
+			if (province->get_trade_node() != nullptr && province->get_trade_node() == other_province->get_trade_node()) {
+				weight = weight * (100 + trade_node_modifier) / 100;
+			}
+
+			if (weight <= 0) {
+				continue;
+			}
+
+			this->columns.push_back(row);
+			this->weights.push_back(weight);
+		}
+	}
+
+	this->row_offsets.push_back(static_cast<uint32_t>(this->columns.size()));
+}
+
+}
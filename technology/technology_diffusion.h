@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace metternich {
+
+class memory_usage;
+class province;
+class world;
+
+/**
+**	@brief	The monthly diffusion of technologies between the provinces of a world
+**
+**	The provinces' influence on each other is kept as a sparse matrix in compressed sparse row format, with a row per land province with a county, built from the world's province adjacency graph and from its active trade routes. Weights depend on the length of shared borders, on trade node membership and on the relative population of the provinces. The matrix is cached, and rebuilt only when the counties, trade nodes or active trade routes of provinces change; population changes constantly, so it is applied to the weights when the matrix is multiplied instead. Each month the matrix is multiplied by the technology bitsets of the provinces, which gives the exposure of each province to each technology; the exposure, scaled by the technology area's diffusion modifier, accumulates as the province's progress towards the technology, and the technology is acquired once the progress reaches the threshold.
+*/
+class technology_diffusion final
+{
+public:
+	explicit technology_diffusion(const metternich::world *world);
+
+	void do_month();
+	void add_memory_usage(memory_usage &usage) const;
+
+private:
+	void build_matrix();
+
+private:
+	const metternich::world *world = nullptr;
+	std::vector<province *> provinces; //the rows and columns of the matrix, sorted by index
+	std::vector<uint32_t> row_offsets; //the position of the first entry of each row, followed by the total amount of entries
+	std::vector<uint32_t> columns;
+	std::vector<long long int> weights; //permille, before being scaled by the relative population of the provinces
+	bool matrix_outdated = true;
+	std::vector<uint32_t> rows_by_province_index; //the row of each province, by province index, kept to avoid reallocating it whenever the matrix is rebuilt
+	std::vector<long long int> exposures; //the exposure of the current row to each technology, by technology index; kept to avoid reallocating it for every row, and reset to zero after each row
+	std::vector<size_t> exposed_technology_indices; //the indices of the technologies with a non-zero exposure for the current row
+};
+
+}
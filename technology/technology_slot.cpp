@@ -46,12 +46,7 @@ void technology_slot::set_available(const bool available)
 	this->available = available;
 	emit available_changed();
 
-	if (available) {
-		//the building slot has become available, check whether the building is actually buildable
-		if (this->condition_check != nullptr) {
-			this->condition_check->calculate_result();
-		}
-	} else {
+	if (!available) {
 		this->set_acquirable(false);
 		this->set_acquired(false);
 	}
@@ -64,6 +59,7 @@ void technology_slot::set_acquired(const bool acquired)
 	}
 
 	this->acquired = acquired;
+	this->get_territory()->set_technology_acquired(this->get_technology(), acquired);
 	emit acquired_changed();
 
 	if (acquired) {
@@ -91,9 +87,14 @@ void technology_slot::set_acquired(const bool acquired)
 
 void technology_slot::create_condition_checks()
 {
-	//create the condition checks only when initializing history, so that their result won't be calculated until history is ready
-	this->precondition_check = std::make_unique<metternich::condition_check<metternich::territory>>(this->get_technology()->get_preconditions(), this->get_territory(), [this](bool result){ this->set_available(result); });
-	this->condition_check = std::make_unique<metternich::condition_check<metternich::territory>>(this->get_technology()->get_conditions(), this->get_territory(), [this](bool result){ this->set_acquirable(result); });
+	//create the condition checks only when initializing history, so that their result won't be calculated until history is ready; the results are stored in the territory's bitsets, and the slot's availability and acquirability are then updated by the territory together with those of its other slots
+	if (this->get_technology()->get_preconditions() != nullptr) {
+		this->precondition_check = std::make_unique<metternich::condition_check<metternich::territory>>(this->get_technology()->get_preconditions(), this->get_territory(), [this](bool result){ this->get_territory()->set_technology_preconditions_fulfilled(this->get_technology(), result); });
+	}
+
+	if (this->get_technology()->get_conditions() != nullptr) {
+		this->condition_check = std::make_unique<metternich::condition_check<metternich::territory>>(this->get_technology()->get_conditions(), this->get_territory(), [this](bool result){ this->get_territory()->set_technology_conditions_fulfilled(this->get_technology(), result); });
+	}
 }
 
 QString technology_slot::get_required_technologies_string() const
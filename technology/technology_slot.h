@@ -60,7 +60,7 @@ public:
 
 	void set_acquirable(const bool acquirable)
 	{
-		if (acquirable == this->is_acquirable() || !this->is_available()) {
+		if (acquirable == this->is_acquirable() || (acquirable && !this->is_available())) {
 			return;
 		}
 
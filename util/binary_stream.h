@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace metternich {
+
+/**
+**	@brief	A writer of binary data to an output stream, in native byte order
+**
+**	Data is organized in sections, each starting with a tag and the section's length; the length is patched in once the section is finished, so that data can be written incrementally without buffering whole sections, and readers can skip sections they don't know.
+*/
+class binary_writer final
+{
+public:
+	explicit binary_writer(std::ostream &stream) : stream(stream)
+	{
+	}
+
+	template <typename T>
+	void write(const T value)
+	{
+		static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+		this->stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+	}
+
+	void write_string(const std::string_view &str)
+	{
+		this->write<uint32_t>(static_cast<uint32_t>(str.size()));
+		this->stream.write(str.data(), static_cast<std::streamsize>(str.size()));
+	}
+
+	template <typename T>
+	void write_vector(const std::vector<T> &vector)
+	{
+		static_assert(std::is_arithmetic_v<T>);
+		this->write<uint32_t>(static_cast<uint32_t>(vector.size()));
+		this->stream.write(reinterpret_cast<const char *>(vector.data()), static_cast<std::streamsize>(vector.size() * sizeof(T)));
+	}
+
+	void begin_section(const uint32_t tag)
+	{
+		if (this->section_start_pos != -1) {
+			throw std::runtime_error("Tried to begin a binary section while another one is still being written.");
+		}
+
+		this->write<uint32_t>(tag);
+		this->write<uint64_t>(0); //placeholder for the length
+		this->section_start_pos = this->stream.tellp();
+	}
+
+	void end_section()
+	{
+		if (this->section_start_pos == -1) {
+			throw std::runtime_error("Tried to end a binary section while none is being written.");
+		}
+
+		const std::streampos end_pos = this->stream.tellp();
+		const uint64_t length = static_cast<uint64_t>(end_pos - this->section_start_pos);
+		this->stream.seekp(this->section_start_pos - static_cast<std::streamoff>(sizeof(uint64_t)));
+		this->write<uint64_t>(length);
+		this->stream.seekp(end_pos);
+		this->section_start_pos = -1;
+
+		if (!this->stream) {
+			throw std::runtime_error("Failed to write binary data.");
+		}
+	}
+
+private:
+	std::ostream &stream;
+	std::streampos section_start_pos = -1;
+};
+
+/**
+**	@brief	A reader of binary data written by a binary writer, from a buffer holding the whole data
+*/
+class binary_reader final
+{
+public:
+	struct section_header final
+	{
+		uint32_t tag = 0;
+		uint64_t length = 0;
+	};
+
+	explicit binary_reader(std::istream &stream)
+		: buffer(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>())
+	{
+	}
+
+	bool is_at_end() const
+	{
+		return this->pos >= this->buffer.size();
+	}
+
+	template <typename T>
+	T read()
+	{
+		static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+		this->check_available(sizeof(T));
+
+		T value;
+		std::memcpy(&value, this->buffer.data() + this->pos, sizeof(T));
+		this->pos += sizeof(T);
+		return value;
+	}
+
+	std::string_view read_string()
+	{
+		const uint32_t size = this->read<uint32_t>();
+		this->check_available(size);
+
+		const std::string_view str(this->buffer.data() + this->pos, size);
+		this->pos += size;
+		return str;
+	}
+
+	template <typename T>
+	std::vector<T> read_vector()
+	{
+		static_assert(std::is_arithmetic_v<T>);
+		const uint32_t size = this->read<uint32_t>();
+		this->check_available(static_cast<size_t>(size) * sizeof(T));
+
+		std::vector<T> vector(size);
+		std::memcpy(vector.data(), this->buffer.data() + this->pos, size * sizeof(T));
+		this->pos += size * sizeof(T);
+		return vector;
+	}
+
+	section_header read_section_header()
+	{
+		section_header header;
+		header.tag = this->read<uint32_t>();
+		header.length = this->read<uint64_t>();
+		this->check_available(header.length);
+		return header;
+	}
+
+	void skip(const uint64_t length)
+	{
+		this->check_available(length);
+		this->pos += length;
+	}
+
+	size_t get_pos() const
+	{
+		return this->pos;
+	}
+
+private:
+	void check_available(const uint64_t length) const
+	{
+		if (length > this->buffer.size() - this->pos) {
+			throw std::runtime_error("Unexpected end of binary data.");
+		}
+	}
+
+private:
+	std::vector<char> buffer;
+	size_t pos = 0;
+};
+
+}
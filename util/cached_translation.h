@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace metternich {
+
+/**
+**	@brief	A memoized translation owned by an entity, e.g. its name
+**
+**	The translation is resolved when first requested, and kept until the entity invalidates it. Entities invalidate it from their name changed signal, to which the change signals of whatever the translation depends on are forwarded, with direct connections throughout: the invalidation then happens in the thread which made the change, before the interface is notified of it through a queued connection and requests the translation again. Keeping the cache in the entity bounds the memory used by it by the amount of entities, regardless of how many combinations of tags occur over a game. All cached translations are invalidated at once when the translations are reloaded.
+*/
+class cached_translation final
+{
+public:
+	//invalidate all cached translations, e.g. because the translations have been reloaded
+	static void invalidate_all()
+	{
+		cached_translation::global_generation.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/**
+	**	@brief	Get the translation, resolving it if it isn't cached
+	**
+	**	@param	function	The function which resolves the translation
+	**
+	**	@return	The translation
+	*/
+	template <typename function_type>
+	std::string get(const function_type &function) const
+	{
+		uint64_t generation = 0;
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+
+			if (this->valid && this->global_generation_at_resolution == cached_translation::global_generation.load(std::memory_order_relaxed)) {
+				return this->translation;
+			}
+
+			generation = this->generation;
+		}
+
+		const uint64_t global_generation = cached_translation::global_generation.load(std::memory_order_relaxed);
+		std::string translation = function();
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		//if the translation was invalidated while it was being resolved, it isn't cached, as it might have been resolved from outdated data
+		if (generation == this->generation) {
+			this->translation = translation;
+			this->global_generation_at_resolution = global_generation;
+			this->valid = true;
+		}
+
+		return translation;
+	}
+
+	void invalidate()
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->valid = false;
+		this->translation.clear();
+		this->generation++;
+	}
+
+private:
+	static inline std::atomic<uint64_t> global_generation = 0;
+
+	mutable std::mutex mutex; //the translation can be requested by the interface thread while the game loop thread invalidates it
+	mutable std::string translation;
+	mutable bool valid = false;
+	uint64_t generation = 0; //incremented on every invalidation
+	mutable uint64_t global_generation_at_resolution = 0;
+};
+
+}
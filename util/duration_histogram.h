@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+
+namespace metternich {
+
+/**
+**	@brief	A histogram of durations with power-of-two nanosecond buckets
+**
+**	Recording is lock-free and cheap enough to be done on hot paths, and the histogram can be read from other threads while it is being recorded to.
+*/
+class duration_histogram final
+{
+public:
+	static constexpr size_t bucket_count = 64;
+
+	void record(const std::chrono::nanoseconds duration)
+	{
+		const uint64_t ns = duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+		const size_t bucket_index = static_cast<size_t>(std::bit_width(ns)); //bucket n holds durations in the [2^(n - 1), 2^n) range
+
+		this->buckets[std::min(bucket_index, bucket_count - 1)].fetch_add(1, std::memory_order_relaxed);
+		this->count.fetch_add(1, std::memory_order_relaxed);
+		this->total_ns.fetch_add(ns, std::memory_order_relaxed);
+
+		uint64_t max_ns = this->max_ns.load(std::memory_order_relaxed);
+		while (ns > max_ns && !this->max_ns.compare_exchange_weak(max_ns, ns, std::memory_order_relaxed)) {
+		}
+	}
+
+	uint64_t get_count() const
+	{
+		return this->count.load(std::memory_order_relaxed);
+	}
+
+	std::chrono::nanoseconds get_mean() const
+	{
+		const uint64_t count = this->get_count();
+		if (count == 0) {
+			return std::chrono::nanoseconds(0);
+		}
+
+		return std::chrono::nanoseconds(this->total_ns.load(std::memory_order_relaxed) / count);
+	}
+
+	std::chrono::nanoseconds get_max() const
+	{
+		return std::chrono::nanoseconds(this->max_ns.load(std::memory_order_relaxed));
+	}
+
+	/**
+	**	@brief	Get an estimate for a percentile of the recorded durations
+	**
+	**	@param	percentile	The percentile, in the [0, 100] range
+	**
+	**	@return	The upper bound of the bucket containing the percentile, capped at the maximum recorded duration
+	*/
+	std::chrono::nanoseconds get_percentile(const double percentile) const
+	{
+		const uint64_t count = this->get_count();
+		if (count == 0) {
+			return std::chrono::nanoseconds(0);
+		}
+
+		const uint64_t target_count = std::max<uint64_t>(1, static_cast<uint64_t>(static_cast<double>(count) * percentile / 100.));
+		uint64_t accumulated_count = 0;
+
+		for (size_t i = 0; i < bucket_count; ++i) {
+			accumulated_count += this->buckets[i].load(std::memory_order_relaxed);
+
+			if (accumulated_count >= target_count) {
+				const uint64_t bucket_upper_bound = i == 0 ? 0 : ((i >= 63) ? UINT64_MAX : (uint64_t(1) << i) - 1);
+				return std::chrono::nanoseconds(static_cast<int64_t>(std::min(bucket_upper_bound, this->max_ns.load(std::memory_order_relaxed))));
+			}
+		}
+
+		return this->get_max();
+	}
+
+	void reset()
+	{
+		for (std::atomic<uint64_t> &bucket : this->buckets) {
+			bucket.store(0, std::memory_order_relaxed);
+		}
+
+		this->count.store(0, std::memory_order_relaxed);
+		this->total_ns.store(0, std::memory_order_relaxed);
+		this->max_ns.store(0, std::memory_order_relaxed);
+	}
+
+private:
+	std::array<std::atomic<uint64_t>, bucket_count> buckets {};
+	std::atomic<uint64_t> count = 0;
+	std::atomic<uint64_t> total_ns = 0;
+	std::atomic<uint64_t> max_ns = 0;
+};
+
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace metternich {
+
+/**
+**	@brief	An open addressing hash map with string view keys, stored in a single flat array
+**
+**	The map does not own its keys, so the strings they refer to must outlive it; interned strings are a natural fit for this. Lookups can be done with any string view, without allocating.
+*/
+template <typename T>
+class flat_string_map final
+{
+private:
+	struct slot
+	{
+		std::string_view key;
+		size_t hash = 0;
+		bool occupied = false;
+		T value {};
+	};
+
+public:
+	static constexpr size_t min_capacity = 16;
+
+	size_t size() const
+	{
+		return this->count;
+	}
+
+	bool empty() const
+	{
+		return this->count == 0;
+	}
+
+	//get the memory allocated for the slots
+	size_t get_allocated_size() const
+	{
+		return this->slots.capacity() * sizeof(slot);
+	}
+
+	T *find(const std::string_view &key)
+	{
+		const size_t slot_index = this->find_slot_index(key);
+		if (slot_index == flat_string_map::npos) {
+			return nullptr;
+		}
+
+		return &this->slots[slot_index].value;
+	}
+
+	const T *find(const std::string_view &key) const
+	{
+		const size_t slot_index = this->find_slot_index(key);
+		if (slot_index == flat_string_map::npos) {
+			return nullptr;
+		}
+
+		return &this->slots[slot_index].value;
+	}
+
+	bool contains(const std::string_view &key) const
+	{
+		return this->find_slot_index(key) != flat_string_map::npos;
+	}
+
+	/**
+	**	@brief	Insert a value, replacing the existing one for the key, if any
+	**
+	**	@param	key		The key, which must outlive the map
+	**	@param	value	The value
+	**
+	**	@return	The inserted value
+	*/
+	template <typename value_type>
+	T &insert_or_assign(const std::string_view &key, value_type &&value)
+	{
+		if ((this->count + 1) * 4 > this->slots.size() * 3) {
+			this->rehash(std::max(flat_string_map::min_capacity, this->slots.size() * 2));
+		}
+
+		const size_t hash = std::hash<std::string_view>()(key);
+		const size_t mask = this->slots.size() - 1;
+
+		for (size_t i = hash & mask;; i = (i + 1) & mask) {
+			slot &slot = this->slots[i];
+
+			if (!slot.occupied) {
+				slot.key = key;
+				slot.hash = hash;
+				slot.occupied = true;
+				slot.value = std::forward<value_type>(value);
+				this->count++;
+				return slot.value;
+			}
+
+			if (slot.hash == hash && slot.key == key) {
+				slot.value = std::forward<value_type>(value);
+				return slot.value;
+			}
+		}
+	}
+
+	bool erase(const std::string_view &key)
+	{
+		size_t hole_index = this->find_slot_index(key);
+		if (hole_index == flat_string_map::npos) {
+			return false;
+		}
+
+		//shift back the subsequent entries of the cluster which would otherwise become unreachable, so that no tombstones are needed
+		const size_t mask = this->slots.size() - 1;
+		for (size_t i = (hole_index + 1) & mask; this->slots[i].occupied; i = (i + 1) & mask) {
+			const size_t ideal_index = this->slots[i].hash & mask;
+
+			//the entry can stay where it is if its ideal index is cyclically within (hole_index, i]
+			const bool can_stay = hole_index <= i ? (hole_index < ideal_index && ideal_index <= i) : (hole_index < ideal_index || ideal_index <= i);
+			if (can_stay) {
+				continue;
+			}
+
+			this->slots[hole_index] = std::move(this->slots[i]);
+			hole_index = i;
+		}
+
+		this->slots[hole_index] = slot();
+		this->count--;
+		return true;
+	}
+
+	void clear()
+	{
+		this->slots.clear();
+		this->count = 0;
+	}
+
+	template <typename function_type>
+	void for_each(const function_type &function) const
+	{
+		for (const slot &slot : this->slots) {
+			if (slot.occupied) {
+				function(slot.key, slot.value);
+			}
+		}
+	}
+
+private:
+	static constexpr size_t npos = static_cast<size_t>(-1);
+
+	size_t find_slot_index(const std::string_view &key) const
+	{
+		if (this->slots.empty()) {
+			return flat_string_map::npos;
+		}
+
+		const size_t hash = std::hash<std::string_view>()(key);
+		const size_t mask = this->slots.size() - 1;
+
+		for (size_t i = hash & mask;; i = (i + 1) & mask) {
+			const slot &slot = this->slots[i];
+
+			if (!slot.occupied) {
+				return flat_string_map::npos;
+			}
+
+			if (slot.hash == hash && slot.key == key) {
+				return i;
+			}
+		}
+	}
+
+	void rehash(const size_t capacity)
+	{
+		std::vector<slot> old_slots = std::move(this->slots);
+		this->slots = std::vector<slot>(capacity);
+		const size_t mask = capacity - 1;
+
+		for (slot &old_slot : old_slots) {
+			if (!old_slot.occupied) {
+				continue;
+			}
+
+			size_t i = old_slot.hash & mask;
+			while (this->slots[i].occupied) {
+				i = (i + 1) & mask;
+			}
+
+			this->slots[i] = std::move(old_slot);
+		}
+	}
+
+private:
+	std::vector<slot> slots; //the size is always zero or a power of two
+	size_t count = 0;
+};
+
+}
@@ -0,0 +1,275 @@
+#pragma once
+
+#include "util/memory_usage.h"
+#include "util/number_util.h"
+
+#include <QGeoCoordinate>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace metternich {
+
+/**
+**	@brief	A spatial index of elements by geocoordinate, for nearest-neighbor and radius queries
+**
+**	Coordinates are stored as points on the unit sphere, and partitioned by a k-d tree whose nodes keep their bounding boxes. Queries visit nodes and elements in a best-first order by chord distance, which is monotonic with the great-circle distance, so that elements are reported from nearest to farthest and the search can stop as soon as the caller has found what it needs. The index is built once, and is not updated afterwards.
+*/
+template <typename T>
+class geocoordinate_index final
+{
+public:
+	static constexpr size_t leaf_size = 8;
+	static constexpr double earth_radius = 6371007.2; //in meters, the same as the one used by QGeoCoordinate::distanceTo()
+
+private:
+	using point = std::array<double, 3>;
+
+	struct entry final
+	{
+		T *element = nullptr;
+		point position;
+	};
+
+	struct node final
+	{
+		bool is_leaf() const
+		{
+			return this->left == 0; //the root node is never a child, so a child index of 0 means there are none
+		}
+
+		double get_squared_distance_to(const point &position) const
+		{
+			double squared_distance = 0.;
+			for (size_t i = 0; i < position.size(); ++i) {
+				const double offset = std::max({ this->min[i] - position[i], 0., position[i] - this->max[i] });
+				squared_distance += offset * offset;
+			}
+			return squared_distance;
+		}
+
+		point min;
+		point max;
+		size_t begin = 0;
+		size_t end = 0;
+		size_t left = 0;
+		size_t right = 0;
+	};
+
+	static constexpr size_t entry_flag = size_t(1) << (sizeof(size_t) * 8 - 1); //marks queue items which refer to entries rather than nodes
+
+	static point to_point(const QGeoCoordinate &coordinate)
+	{
+		const double latitude = number::degree_to_radian(coordinate.latitude());
+		const double longitude = number::degree_to_radian(coordinate.longitude());
+		return { std::cos(latitude) * std::cos(longitude), std::cos(latitude) * std::sin(longitude), std::sin(latitude) };
+	}
+
+	static double get_squared_distance(const point &a, const point &b)
+	{
+		double squared_distance = 0.;
+		for (size_t i = 0; i < a.size(); ++i) {
+			squared_distance += (a[i] - b[i]) * (a[i] - b[i]);
+		}
+		return squared_distance;
+	}
+
+	//convert a chord distance on the unit sphere to a great-circle distance in meters
+	static double chord_to_meters(const double chord)
+	{
+		return 2. * std::asin(std::min(chord / 2., 1.)) * geocoordinate_index::earth_radius;
+	}
+
+public:
+	bool empty() const
+	{
+		return this->entries.empty();
+	}
+
+	size_t size() const
+	{
+		return this->entries.size();
+	}
+
+	void clear()
+	{
+		this->entries.clear();
+		this->nodes.clear();
+	}
+
+	void add_memory_usage(memory_usage &usage) const
+	{
+		usage.add_vector(this->entries);
+		usage.add_vector(this->nodes);
+	}
+
+	/**
+	**	@brief	Build the index, replacing its previous contents
+	**
+	**	@param	elements	The elements to be indexed, together with their geocoordinates; elements with an invalid geocoordinate are ignored
+	*/
+	void build(const std::vector<std::pair<T *, QGeoCoordinate>> &elements)
+	{
+		this->clear();
+
+		for (const auto &[element, coordinate] : elements) {
+			if (!coordinate.isValid()) {
+				continue;
+			}
+
+			this->entries.push_back({ element, geocoordinate_index::to_point(coordinate) });
+		}
+
+		if (!this->entries.empty()) {
+			this->nodes.reserve(this->entries.size() / geocoordinate_index::leaf_size * 2 + 1);
+			this->build_node(0, this->entries.size());
+		}
+	}
+
+	/**
+	**	@brief	Call a function for the indexed elements in order of increasing distance from a geocoordinate
+	**
+	**	@param	coordinate	The geocoordinate
+	**	@param	function	The function, which receives an element and its distance in meters, and returns false to stop the search
+	*/
+	void for_each_nearest(const QGeoCoordinate &coordinate, const std::function<bool(T *, double)> &function) const
+	{
+		if (this->empty()) {
+			return;
+		}
+
+		const point position = geocoordinate_index::to_point(coordinate);
+
+		using queue_item = std::pair<double, size_t>; //the squared chord distance, and the node or entry index
+		std::priority_queue<queue_item, std::vector<queue_item>, std::greater<queue_item>> queue;
+		queue.emplace(this->nodes.front().get_squared_distance_to(position), 0);
+
+		while (!queue.empty()) {
+			const auto [squared_distance, index] = queue.top();
+			queue.pop();
+
+			if (index & geocoordinate_index::entry_flag) {
+				const entry &entry = this->entries[index & ~geocoordinate_index::entry_flag];
+				if (!function(entry.element, geocoordinate_index::chord_to_meters(std::sqrt(squared_distance)))) {
+					return;
+				}
+				continue;
+			}
+
+			const node &node = this->nodes[index];
+			if (node.is_leaf()) {
+				for (size_t i = node.begin; i < node.end; ++i) {
+					queue.emplace(geocoordinate_index::get_squared_distance(this->entries[i].position, position), i | geocoordinate_index::entry_flag);
+				}
+			} else {
+				queue.emplace(this->nodes[node.left].get_squared_distance_to(position), node.left);
+				queue.emplace(this->nodes[node.right].get_squared_distance_to(position), node.right);
+			}
+		}
+	}
+
+	/**
+	**	@brief	Get the elements nearest to a geocoordinate
+	**
+	**	@param	coordinate	The geocoordinate
+	**	@param	count		The maximum amount of elements to be returned
+	**
+	**	@return	The elements, ordered from nearest to farthest
+	*/
+	std::vector<T *> get_nearest(const QGeoCoordinate &coordinate, const size_t count) const
+	{
+		std::vector<T *> elements;
+
+		if (count == 0) {
+			return elements;
+		}
+
+		this->for_each_nearest(coordinate, [&elements, count](T *element, const double) {
+			elements.push_back(element);
+			return elements.size() < count;
+		});
+
+		return elements;
+	}
+
+	/**
+	**	@brief	Get the elements within a radius of a geocoordinate
+	**
+	**	@param	coordinate	The geocoordinate
+	**	@param	radius		The radius, in meters
+	**
+	**	@return	The elements, ordered from nearest to farthest
+	*/
+	std::vector<T *> get_within_radius(const QGeoCoordinate &coordinate, const double radius) const
+	{
+		std::vector<T *> elements;
+
+		this->for_each_nearest(coordinate, [&elements, radius](T *element, const double distance) {
+			if (distance > radius) {
+				return false;
+			}
+
+			elements.push_back(element);
+			return true;
+		});
+
+		return elements;
+	}
+
+private:
+	size_t build_node(const size_t begin, const size_t end)
+	{
+		node node;
+		node.begin = begin;
+		node.end = end;
+		node.min = this->entries[begin].position;
+		node.max = this->entries[begin].position;
+
+		for (size_t i = begin + 1; i < end; ++i) {
+			const point &position = this->entries[i].position;
+			for (size_t j = 0; j < position.size(); ++j) {
+				node.min[j] = std::min(node.min[j], position[j]);
+				node.max[j] = std::max(node.max[j], position[j]);
+			}
+		}
+
+		const size_t node_index = this->nodes.size();
+		this->nodes.push_back(node);
+
+		if (end - begin <= geocoordinate_index::leaf_size) {
+			return node_index;
+		}
+
+		//split along the axis with the greatest extent
+		size_t axis = 0;
+		for (size_t i = 1; i < node.min.size(); ++i) {
+			if (node.max[i] - node.min[i] > node.max[axis] - node.min[axis]) {
+				axis = i;
+			}
+		}
+
+		const size_t middle = begin + (end - begin) / 2;
+		std::nth_element(this->entries.begin() + begin, this->entries.begin() + middle, this->entries.begin() + end, [axis](const entry &a, const entry &b) {
+			return a.position[axis] < b.position[axis];
+		});
+
+		//the node vector may be reallocated while building the children, so the node is accessed by its index afterwards
+		const size_t left = this->build_node(begin, middle);
+		const size_t right = this->build_node(middle, end);
+		this->nodes[node_index].left = left;
+		this->nodes[node_index].right = right;
+
+		return node_index;
+	}
+
+private:
+	std::vector<entry> entries;
+	std::vector<node> nodes;
+};
+
+}
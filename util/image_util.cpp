@@ -23,6 +23,11 @@ std::set<QRgb> get_rgbs(const QImage &image)
 	const QRgb *rgb_data = reinterpret_cast<const QRgb *>(image.constBits());
 
 	for (int i = 0; i < pixel_count; ++i) {
+		//adjacent pixels usually have the same color, so only insert when it changes
+		if (i > 0 && rgb_data[i] == rgb_data[i - 1]) {
+			continue;
+		}
+
 		rgb_set.insert(rgb_data[i]);
 	}
 
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "util/mapped_raster.h"
+
+#include <QImage>
+#include <QPoint>
+#include <QSize>
+
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace metternich {
+
+/**
+**	@brief	A raster whose pixels are 16-bit indices to a palette of colors, each corresponding to an element (e.g. a province)
+**
+**	Converting an image to an indexed raster is done once, and the elements are then resolved once per palette entry rather than once per pixel, so that consumers work with integers instead of looking up colors. The empty color always has the index 0. The indices can be held in memory, or in a memory-mapped raster file.
+*/
+template <typename T>
+class indexed_raster final
+{
+public:
+	static constexpr uint16_t empty_index = 0;
+
+	indexed_raster() = default;
+
+	//convert an image, building the palette from its colors
+	explicit indexed_raster(const QImage &image) : size(image.size())
+	{
+		const QImage rgb_image = (image.format() == QImage::Format_RGB32 || image.format() == QImage::Format_ARGB32) ? image : image.convertToFormat(QImage::Format_ARGB32);
+
+		this->palette.push_back(T::empty_rgb);
+		std::unordered_map<QRgb, uint16_t> color_indices;
+		color_indices[T::empty_rgb] = indexed_raster::empty_index;
+
+		this->owned_indices.resize(static_cast<size_t>(this->size.width()) * this->size.height());
+
+		size_t pixel_index = 0;
+		QRgb previous_rgb = T::empty_rgb;
+		uint16_t previous_index = indexed_raster::empty_index;
+
+		for (int y = 0; y < this->size.height(); ++y) {
+			const QRgb *rgb_data = reinterpret_cast<const QRgb *>(rgb_image.constScanLine(y));
+
+			for (int x = 0; x < this->size.width(); ++x) {
+				const QRgb rgb = rgb_data[x];
+
+				//adjacent pixels usually have the same color, so the previous one is checked before the hash lookup
+				if (rgb != previous_rgb) {
+					auto find_iterator = color_indices.find(rgb);
+					if (find_iterator == color_indices.end()) {
+						if (this->palette.size() > std::numeric_limits<uint16_t>::max()) {
+							throw std::runtime_error("An image has more colors than an indexed raster can hold.");
+						}
+
+						find_iterator = color_indices.emplace(rgb, static_cast<uint16_t>(this->palette.size())).first;
+						this->palette.push_back(rgb);
+					}
+
+					previous_rgb = rgb;
+					previous_index = find_iterator->second;
+				}
+
+				this->owned_indices[pixel_index++] = previous_index;
+			}
+		}
+
+		this->indices = this->owned_indices.data();
+	}
+
+	//load a raster file saved with save()
+	explicit indexed_raster(const std::filesystem::path &filepath) : raster(std::make_unique<mapped_raster>(filepath))
+	{
+		const QImage &image = this->raster->get_image();
+
+		if (image.format() != QImage::Format_Grayscale16 || image.bytesPerLine() != image.width() * static_cast<int>(sizeof(uint16_t)) || this->raster->get_palette().empty()) {
+			throw std::runtime_error("Raster file \"" + filepath.string() + "\" is not an indexed raster.");
+		}
+
+		this->size = image.size();
+		this->indices = reinterpret_cast<const uint16_t *>(image.constBits());
+		this->palette = this->raster->get_palette();
+	}
+
+	indexed_raster(indexed_raster &&other) = default;
+	indexed_raster &operator =(indexed_raster &&other) = default;
+
+	void save(const std::filesystem::path &filepath) const
+	{
+		const QImage image(reinterpret_cast<const uchar *>(this->indices), this->size.width(), this->size.height(), this->size.width() * static_cast<int>(sizeof(uint16_t)), QImage::Format_Grayscale16);
+		mapped_raster::save(image, filepath, this->palette);
+	}
+
+	//resolve the element of each palette color
+	void resolve_elements(const bool should_find)
+	{
+		this->elements.clear();
+		this->elements.reserve(this->palette.size());
+
+		for (const QRgb rgb : this->palette) {
+			this->elements.push_back(T::get_by_rgb(rgb, should_find));
+		}
+	}
+
+	bool is_null() const
+	{
+		return this->indices == nullptr;
+	}
+
+	const QSize &get_size() const
+	{
+		return this->size;
+	}
+
+	int get_width() const
+	{
+		return this->size.width();
+	}
+
+	int get_height() const
+	{
+		return this->size.height();
+	}
+
+	int get_pixel_count() const
+	{
+		return this->size.width() * this->size.height();
+	}
+
+	const std::vector<QRgb> &get_palette() const
+	{
+		return this->palette;
+	}
+
+	size_t get_palette_size() const
+	{
+		return this->palette.size();
+	}
+
+	uint16_t get_index(const int pixel_index) const
+	{
+		return this->indices[pixel_index];
+	}
+
+	uint16_t get_index(const QPoint &pos) const
+	{
+		return this->indices[pos.y() * this->size.width() + pos.x()];
+	}
+
+	T *get_element(const uint16_t index) const
+	{
+		return this->elements[index];
+	}
+
+	T *get_pixel_element(const QPoint &pos) const
+	{
+		if (pos.x() < 0 || pos.y() < 0 || pos.x() >= this->size.width() || pos.y() >= this->size.height()) {
+			return nullptr;
+		}
+
+		return this->get_element(this->get_index(pos));
+	}
+
+	size_t get_owned_memory_size() const
+	{
+		return this->owned_indices.capacity() * sizeof(uint16_t) + this->palette.capacity() * sizeof(QRgb) + this->elements.capacity() * sizeof(T *);
+	}
+
+private:
+	QSize size;
+	const uint16_t *indices = nullptr; //points either to the owned indices, or to the mapped raster file
+	std::vector<uint16_t> owned_indices;
+	std::unique_ptr<mapped_raster> raster;
+	std::vector<QRgb> palette;
+	std::vector<T *> elements; //the element for each palette index, once resolved
+};
+
+}
@@ -0,0 +1,134 @@
+#include "util/mapped_raster.h"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace metternich {
+
+struct mapped_raster_header final
+{
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	int32_t width = 0;
+	int32_t height = 0;
+	int32_t bytes_per_line = 0;
+	int32_t format = 0;
+	uint32_t palette_size = 0;
+};
+
+static_assert(sizeof(mapped_raster_header) <= mapped_raster::header_size);
+
+/**
+**	@brief	Save an image as a raster file
+**
+**	@param	image		The image; its pixel format must not use a color table
+**	@param	filepath	The path of the raster file
+**	@param	palette		The palette of colors, if the image's pixels are indices to it
+*/
+void mapped_raster::save(const QImage &image, const std::filesystem::path &filepath, const std::vector<QRgb> &palette)
+{
+	if (image.isNull() || !image.colorTable().empty()) {
+		throw std::runtime_error("Cannot save an image without pixel data or with a color table as raster file \"" + filepath.string() + "\".");
+	}
+
+	std::ofstream ofstream(filepath, std::ios::binary | std::ios::trunc);
+	if (!ofstream) {
+		throw std::runtime_error("Failed to open raster file \"" + filepath.string() + "\" for writing.");
+	}
+
+	mapped_raster_header header;
+	header.magic = mapped_raster::magic;
+	header.version = mapped_raster::version;
+	header.width = image.width();
+	header.height = image.height();
+	header.bytes_per_line = image.bytesPerLine();
+	header.format = static_cast<int32_t>(image.format());
+	header.palette_size = static_cast<uint32_t>(palette.size());
+
+	std::array<char, mapped_raster::header_size> header_data {};
+	std::memcpy(header_data.data(), &header, sizeof(header));
+	ofstream.write(header_data.data(), static_cast<std::streamsize>(header_data.size()));
+
+	for (int y = 0; y < image.height(); ++y) {
+		ofstream.write(reinterpret_cast<const char *>(image.constScanLine(y)), image.bytesPerLine());
+	}
+
+	ofstream.write(reinterpret_cast<const char *>(palette.data()), static_cast<std::streamsize>(palette.size() * sizeof(QRgb)));
+
+	if (!ofstream) {
+		throw std::runtime_error("Failed to write raster file \"" + filepath.string() + "\".");
+	}
+}
+
+/**
+**	@brief	Get whether a file is a raster file of the current version
+**
+**	@param	filepath	The path of the file
+**
+**	@return	True if the file exists and has a header of the current version, or false otherwise
+*/
+bool mapped_raster::is_current(const std::filesystem::path &filepath)
+{
+	std::ifstream ifstream(filepath, std::ios::binary);
+	if (!ifstream) {
+		return false;
+	}
+
+	mapped_raster_header header;
+	if (!ifstream.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+		return false;
+	}
+
+	return header.magic == mapped_raster::magic && header.version == mapped_raster::version;
+}
+
+/**
+**	@brief	Load a raster file, mapping it into memory
+**
+**	@param	filepath	The path of the raster file
+*/
+mapped_raster::mapped_raster(const std::filesystem::path &filepath) : file(QString::fromStdString(filepath.string()))
+{
+	if (!this->file.open(QIODevice::ReadOnly)) {
+		throw std::runtime_error("Failed to open raster file \"" + filepath.string() + "\".");
+	}
+
+	if (this->file.size() < static_cast<qint64>(mapped_raster::header_size)) {
+		throw std::runtime_error("Raster file \"" + filepath.string() + "\" is too small to contain a raster.");
+	}
+
+	const uchar *data = this->file.map(0, this->file.size());
+	if (data == nullptr) {
+		throw std::runtime_error("Failed to map raster file \"" + filepath.string() + "\" into memory.");
+	}
+
+	mapped_raster_header header;
+	std::memcpy(&header, data, sizeof(header));
+
+	if (header.magic != mapped_raster::magic || header.version != mapped_raster::version) {
+		throw std::runtime_error("File \"" + filepath.string() + "\" is not a raster file of the current version.");
+	}
+
+	const qint64 data_size = static_cast<qint64>(header.bytes_per_line) * header.height;
+	const qint64 palette_data_size = static_cast<qint64>(header.palette_size) * static_cast<qint64>(sizeof(QRgb));
+	if (header.width <= 0 || header.height <= 0 || header.bytes_per_line <= 0 || this->file.size() < static_cast<qint64>(mapped_raster::header_size) + data_size + palette_data_size) {
+		throw std::runtime_error("Raster file \"" + filepath.string() + "\" has invalid dimensions or is truncated.");
+	}
+
+	//use the constructor taking a const pointer, so that the image never writes to the mapped memory
+	this->image = QImage(data + mapped_raster::header_size, header.width, header.height, header.bytes_per_line, static_cast<QImage::Format>(header.format));
+
+	if (this->image.isNull()) {
+		throw std::runtime_error("Raster file \"" + filepath.string() + "\" has an invalid pixel format.");
+	}
+
+	if (header.palette_size > 0) {
+		this->palette.resize(header.palette_size);
+		std::memcpy(this->palette.data(), data + mapped_raster::header_size + data_size, static_cast<size_t>(palette_data_size));
+	}
+}
+
+}
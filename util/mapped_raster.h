@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QFile>
+#include <QImage>
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace metternich {
+
+/**
+**	@brief	A raster image stored uncompressed in a file, which is memory-mapped when loaded
+**
+**	The file has a small header with the raster's dimensions and pixel format, followed by the pixel data with the image's own scanline layout, and by an optional palette of colors for rasters whose pixels are indices, so that loading it requires no decoding, and pages are only read from disk as they are accessed. The raster's image refers to the mapped memory directly, and so it is only valid while the raster exists; modifying it detaches a copy.
+*/
+class mapped_raster final
+{
+public:
+	static constexpr uint32_t magic = 0x5254534D; //"MSTR"
+	static constexpr uint32_t version = 2;
+	static constexpr size_t header_size = 32; //the header is padded so that the pixel data is aligned for any pixel format
+
+	static void save(const QImage &image, const std::filesystem::path &filepath, const std::vector<QRgb> &palette = {});
+	static bool is_current(const std::filesystem::path &filepath);
+
+	explicit mapped_raster(const std::filesystem::path &filepath);
+
+	const QImage &get_image() const
+	{
+		return this->image;
+	}
+
+	const std::vector<QRgb> &get_palette() const
+	{
+		return this->palette;
+	}
+
+private:
+	QFile file;
+	QImage image;
+	std::vector<QRgb> palette;
+};
+
+}
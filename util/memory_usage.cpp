@@ -0,0 +1,65 @@
+#include "util/memory_usage.h"
+
+#include <iomanip>
+
+namespace metternich {
+
+memory_usage memory_report::get_total_usage() const
+{
+	memory_usage total_usage;
+
+	for (const auto &kv_pair : this->usage_per_category) {
+		total_usage += kv_pair.second;
+	}
+
+	return total_usage;
+}
+
+void memory_report::print(std::ostream &ostream) const
+{
+	static constexpr int category_width = 56;
+	static constexpr int value_width = 16;
+
+	const auto print_header = [&](const std::string &title) {
+		ostream << std::left << std::setw(category_width) << title << std::right;
+		ostream << std::setw(value_width) << "Instances";
+		ostream << std::setw(value_width) << "Heap KiB";
+		ostream << std::setw(value_width) << "Allocations" << "\n";
+	};
+
+	const auto print_row = [&](const std::string &category, const memory_usage &usage) {
+		ostream << std::left << std::setw(category_width) << category << std::right;
+		ostream << std::setw(value_width) << usage.get_instance_count();
+		ostream << std::setw(value_width) << (usage.get_heap_bytes() / 1024);
+		ostream << std::setw(value_width) << usage.get_allocation_count() << "\n";
+	};
+
+	print_header("Category");
+
+	for (const auto &kv_pair : this->usage_per_category) {
+		if (kv_pair.second.is_empty()) {
+			continue;
+		}
+
+		print_row(kv_pair.first, kv_pair.second);
+	}
+
+	print_row("Total", this->get_total_usage());
+
+	bool has_released_peak_usage = false;
+	for (const auto &kv_pair : this->released_peak_usage_per_category) {
+		if (kv_pair.second.is_empty()) {
+			continue;
+		}
+
+		if (!has_released_peak_usage) {
+			ostream << "\n";
+			print_header("Released (peak)");
+			has_released_peak_usage = true;
+		}
+
+		print_row(kv_pair.first, kv_pair.second);
+	}
+}
+
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <QGeoPath>
+#include <QGeoPolygon>
+#include <QImage>
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace metternich {
+
+/**
+**	@brief	An estimate of the memory used by a category of objects
+**
+**	The estimates are based on libstdc++'s container layouts, e.g. red-black tree nodes having a header of four words, and strings storing up to 15 characters inline. Qt objects' private data is not taken into account.
+*/
+class memory_usage final
+{
+public:
+	static constexpr size_t tree_node_header_size = 32; //the color, parent, left and right fields of a red-black tree node
+	static constexpr size_t qgeocoordinate_private_size = 32; //the reference count, latitude, longitude and altitude of a geocoordinate's shared data
+
+	size_t get_instance_count() const
+	{
+		return this->instance_count;
+	}
+
+	size_t get_heap_bytes() const
+	{
+		return this->heap_bytes;
+	}
+
+	size_t get_allocation_count() const
+	{
+		return this->allocation_count;
+	}
+
+	bool is_empty() const
+	{
+		return this->instance_count == 0 && this->heap_bytes == 0 && this->allocation_count == 0;
+	}
+
+	void add_allocation(const size_t bytes)
+	{
+		if (bytes == 0) {
+			return;
+		}
+
+		this->heap_bytes += bytes;
+		this->allocation_count++;
+	}
+
+	void increment_instance_count()
+	{
+		this->instance_count++;
+	}
+
+	//add an instance which has been allocated on its own
+	template <typename T>
+	void add_instance()
+	{
+		this->increment_instance_count();
+		this->add_allocation(sizeof(T));
+	}
+
+	void add_string(const std::string &str)
+	{
+		if (str.capacity() > std::string().capacity()) {
+			this->add_allocation(str.capacity() + 1);
+		}
+	}
+
+	template <typename T, typename allocator>
+	void add_vector(const std::vector<T, allocator> &vector)
+	{
+		this->add_allocation(vector.capacity() * sizeof(T));
+	}
+
+	//add the nodes of a tree-based container (i.e. a map or set), but not the memory owned by their elements
+	template <typename T>
+	void add_tree(const T &container)
+	{
+		for (size_t i = 0; i < container.size(); ++i) {
+			this->add_allocation(sizeof(typename T::value_type) + memory_usage::tree_node_header_size);
+		}
+	}
+
+	void add_image(const QImage &image)
+	{
+		this->add_allocation(static_cast<size_t>(image.sizeInBytes()));
+	}
+
+	void add_geocoordinates(const QList<QGeoCoordinate> &coordinates)
+	{
+		this->add_allocation(static_cast<size_t>(coordinates.size()) * sizeof(void *)); //QList's array of elements
+
+		for (int i = 0; i < coordinates.size(); ++i) {
+			this->add_allocation(memory_usage::qgeocoordinate_private_size);
+		}
+	}
+
+	void add_geopolygon(const QGeoPolygon &geopolygon)
+	{
+		this->increment_instance_count();
+		this->add_geocoordinates(geopolygon.path());
+
+		for (int i = 0; i < geopolygon.holesCount(); ++i) {
+			this->add_geocoordinates(geopolygon.holePath(i));
+		}
+	}
+
+	void add_geopath(const QGeoPath &geopath)
+	{
+		this->increment_instance_count();
+		this->add_geocoordinates(geopath.path());
+	}
+
+	memory_usage &operator +=(const memory_usage &other)
+	{
+		this->instance_count += other.instance_count;
+		this->heap_bytes += other.heap_bytes;
+		this->allocation_count += other.allocation_count;
+		return *this;
+	}
+
+private:
+	size_t instance_count = 0;
+	size_t heap_bytes = 0;
+	size_t allocation_count = 0;
+};
+
+/**
+**	@brief	A report of the estimated memory usage of each category of objects, e.g. of each data type
+*/
+class memory_report final
+{
+public:
+	//whether to record the memory usage of transient data (e.g. GSML data) before it is released, so that peak usage can be reported
+	static bool is_transient_data_tracked()
+	{
+		return memory_report::transient_data_tracked;
+	}
+
+	static void set_transient_data_tracked(const bool tracked)
+	{
+		memory_report::transient_data_tracked = tracked;
+	}
+
+	memory_usage &get_usage(const std::string &category)
+	{
+		return this->usage_per_category[category];
+	}
+
+	//get the peak usage for a category of transient data which has already been released, and as such doesn't count towards the total
+	memory_usage &get_released_peak_usage(const std::string &category)
+	{
+		return this->released_peak_usage_per_category[category];
+	}
+
+	/**
+	**	@brief	Add an instance to its category, as well as the memory owned by it
+	**
+	**	@param	instance	The instance
+	**	@param	category	The category of the instance
+	*/
+	template <typename T>
+	void add_instance(const T *instance, const std::string &category)
+	{
+		memory_usage &usage = this->get_usage(category);
+		usage.add_instance<T>();
+		instance->add_owned_memory_usage(usage, *this);
+	}
+
+	memory_usage get_total_usage() const;
+	void print(std::ostream &ostream) const;
+
+private:
+	static inline bool transient_data_tracked = false;
+
+	std::map<std::string, memory_usage> usage_per_category;
+	std::map<std::string, memory_usage> released_peak_usage_per_category;
+};
+
+}
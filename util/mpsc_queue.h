@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace metternich {
+
+/**
+**	@brief	A bounded lock-free multi-producer single-consumer ring buffer
+**
+**	Each cell carries a sequence number which tells producers and the consumer whether the cell is free to be written or ready to be read, so that no locks are needed.
+*/
+template <typename T, size_t capacity>
+class mpsc_queue final
+{
+	static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0, "The capacity of an MPSC queue must be a power of two.");
+
+private:
+	static constexpr size_t cache_line_size = 64;
+	static constexpr size_t index_mask = capacity - 1;
+
+	struct cell
+	{
+		std::atomic<size_t> sequence;
+		std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+
+		T *get_value()
+		{
+			return std::launder(reinterpret_cast<T *>(&this->storage));
+		}
+	};
+
+public:
+	mpsc_queue()
+	{
+		for (size_t i = 0; i < capacity; ++i) {
+			this->cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	mpsc_queue(const mpsc_queue &other) = delete;
+
+	~mpsc_queue()
+	{
+		//destroy any elements which were never consumed
+		while (this->try_pop([](T &&) {})) {
+		}
+	}
+
+	mpsc_queue &operator =(const mpsc_queue &other) = delete;
+
+	/**
+	**	@brief	Try to push an element to the queue; may be called concurrently from any number of threads
+	**
+	**	@param	value	The element
+	**
+	**	@return	True if the element was pushed, or false if the queue was full
+	*/
+	bool try_push(T &&value)
+	{
+		size_t pos = this->enqueue_pos.load(std::memory_order_relaxed);
+		cell *target_cell = nullptr;
+
+		while (true) {
+			target_cell = &this->cells[pos & index_mask];
+			const size_t sequence = target_cell->sequence.load(std::memory_order_acquire);
+			const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+			if (difference == 0) {
+				if (this->enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (difference < 0) {
+				return false; //the queue is full
+			} else {
+				pos = this->enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		::new (static_cast<void *>(&target_cell->storage)) T(std::move(value));
+		target_cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	//push an element, yielding while the queue is full
+	void push(T &&value)
+	{
+		while (!this->try_push(std::move(value))) {
+			std::this_thread::yield();
+		}
+	}
+
+	/**
+	**	@brief	Pop an element from the queue; must only be called from the consumer thread
+	**
+	**	@param	function	The function to which the popped element is passed
+	**
+	**	@return	True if an element was popped, or false if the queue was empty
+	*/
+	template <typename function_type>
+	bool try_pop(const function_type &function)
+	{
+		cell &source_cell = this->cells[this->dequeue_pos & index_mask];
+		const size_t sequence = source_cell.sequence.load(std::memory_order_acquire);
+
+		if (sequence != this->dequeue_pos + 1) {
+			return false; //empty, or the producer which claimed the cell hasn't finished writing it yet
+		}
+
+		T *value = source_cell.get_value();
+		T popped_value(std::move(*value));
+		value->~T();
+		source_cell.sequence.store(this->dequeue_pos + capacity, std::memory_order_release);
+		++this->dequeue_pos;
+
+		function(std::move(popped_value));
+		return true;
+	}
+
+	/**
+	**	@brief	Pop all elements which had been pushed when the draining started; must only be called from the consumer thread
+	**
+	**	@param	function	The function to which each popped element is passed
+	**
+	**	@return	The quantity of popped elements
+	*/
+	template <typename function_type>
+	size_t drain(const function_type &function)
+	{
+		//elements pushed while draining (e.g. by the functions processing the drained elements) are left for the next drain
+		const size_t end_pos = this->enqueue_pos.load(std::memory_order_acquire);
+		size_t count = 0;
+
+		while (this->dequeue_pos != end_pos && this->try_pop(function)) {
+			++count;
+		}
+
+		return count;
+	}
+
+	bool empty() const
+	{
+		return this->cells[this->dequeue_pos & index_mask].sequence.load(std::memory_order_acquire) != this->dequeue_pos + 1;
+	}
+
+private:
+	std::array<cell, capacity> cells;
+	alignas(cache_line_size) std::atomic<size_t> enqueue_pos = 0;
+	alignas(cache_line_size) size_t dequeue_pos = 0; //only touched by the consumer
+};
+
+}
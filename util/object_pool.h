@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+
+namespace metternich {
+
+/**
+**	@brief	A pool of memory blocks for the instances of a type
+**
+**	Blocks are carved out of chunks by a pool resource, which keeps the chunks for the lifetime of the program and reuses freed blocks for the next allocations. This way types whose instances are created and destroyed constantly, such as population units being mixed or removed when empty, don't fragment the heap. Blocks can be allocated and freed from different threads, e.g. when an object is created in the game loop thread and deleted later in the main thread.
+*/
+template <typename T>
+class object_pool final
+{
+public:
+	static constexpr size_t max_blocks_per_chunk = 256;
+
+	static object_pool &get()
+	{
+		//the pool is never destroyed, as pooled objects may still be destroyed during static destruction
+		static object_pool *pool = new object_pool;
+		return *pool;
+	}
+
+	void *allocate()
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		void *ptr = this->resource.allocate(sizeof(T), alignof(T));
+		this->allocated_count++;
+		return ptr;
+	}
+
+	void deallocate(void *ptr)
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		this->resource.deallocate(ptr, sizeof(T), alignof(T));
+		this->allocated_count--;
+	}
+
+	size_t get_allocated_count() const
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		return this->allocated_count;
+	}
+
+private:
+	object_pool() : resource(std::pmr::pool_options{ object_pool::max_blocks_per_chunk, sizeof(T) })
+	{
+	}
+
+private:
+	mutable std::mutex mutex;
+	std::pmr::unsynchronized_pool_resource resource; //the resource is only accessed while holding the mutex, so that the allocated count is kept consistent with it
+	size_t allocated_count = 0;
+};
+
+/**
+**	@brief	A base class for types whose instances are allocated from their object pool
+**
+**	Derived types of a pooled type are allocated normally, as their instances don't fit in the pool's blocks.
+*/
+template <typename T>
+class pooled_object
+{
+public:
+	static void *operator new(const size_t size)
+	{
+		if (size != sizeof(T)) {
+			return ::operator new(size);
+		}
+
+		return object_pool<T>::get().allocate();
+	}
+
+	static void operator delete(void *ptr, const size_t size)
+	{
+		if (size != sizeof(T)) {
+			::operator delete(ptr);
+			return;
+		}
+
+		object_pool<T>::get().deallocate(ptr);
+	}
+};
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace metternich::parallel {
+
+/**
+**	@brief	Call a function for each element of a vector, splitting the elements among the available hardware threads
+**
+**	@param	vector		The vector
+**	@param	function	The function, which must be safe to call concurrently for different elements
+**
+**	If the function throws for any element, the remaining elements are skipped, and the first exception is rethrown once all threads have finished.
+*/
+template <typename T, typename function_type>
+inline void for_each(const std::vector<T> &vector, const function_type &function)
+{
+	const size_t thread_count = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), vector.size());
+
+	if (thread_count <= 1) {
+		for (const T &element : vector) {
+			function(element);
+		}
+		return;
+	}
+
+	std::atomic<size_t> next_index = 0;
+	std::atomic<bool> failed = false;
+	std::exception_ptr exception;
+	std::mutex exception_mutex;
+
+	const auto process_elements = [&]() {
+		while (!failed.load(std::memory_order_relaxed)) {
+			const size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+			if (index >= vector.size()) {
+				return;
+			}
+
+			try {
+				function(vector[index]);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(exception_mutex);
+				if (exception == nullptr) {
+					exception = std::current_exception();
+				}
+				failed = true;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(thread_count - 1);
+	for (size_t i = 1; i < thread_count; ++i) {
+		threads.emplace_back(process_elements);
+	}
+
+	process_elements(); //the calling thread does its share of the work too
+
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+
+	if (exception != nullptr) {
+		std::rethrow_exception(exception);
+	}
+}
+
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace metternich {
+
+/**
+**	@brief	A map of sizes per key, e.g. population per culture, which keeps track of the key with the greatest size
+**
+**	Sizes are changed by deltas, and the plurality is kept in a max-heap with lazy deletion: each change pushes the key's new size, and heap entries whose size no longer matches the map are discarded when they reach the top. The heap is rebuilt from the map when stale entries accumulate, so it stays small. Ties are broken in favor of the key with the lowest index, so that the result does not depend on the order of changes.
+*/
+template <typename T>
+class plurality_map final
+{
+private:
+	using heap_entry = std::pair<int, T *>;
+
+public:
+	const std::map<T *, int> &get_values() const
+	{
+		return this->values;
+	}
+
+	int get_value(T *key) const
+	{
+		auto find_iterator = this->values.find(key);
+		if (find_iterator == this->values.end()) {
+			return 0;
+		}
+
+		return find_iterator->second;
+	}
+
+	bool empty() const
+	{
+		return this->values.empty();
+	}
+
+	void change(T *key, const int change)
+	{
+		if (change == 0) {
+			return;
+		}
+
+		int &value = this->values[key];
+		value += change;
+
+		if (value <= 0) {
+			this->values.erase(key);
+		} else {
+			this->heap.emplace_back(value, key);
+			std::push_heap(this->heap.begin(), this->heap.end(), plurality_map::compare_heap_entries);
+		}
+
+		if (this->heap.size() > this->values.size() * 2 + 8) {
+			this->rebuild_heap();
+		}
+	}
+
+	void clear()
+	{
+		this->values.clear();
+		this->heap.clear();
+	}
+
+	//get the key with the greatest size, or null if the map is empty
+	T *get_plurality() const
+	{
+		while (!this->heap.empty()) {
+			const heap_entry &top_entry = this->heap.front();
+			if (this->get_value(top_entry.second) == top_entry.first) {
+				return top_entry.second;
+			}
+
+			std::pop_heap(this->heap.begin(), this->heap.end(), plurality_map::compare_heap_entries);
+			this->heap.pop_back();
+		}
+
+		return nullptr;
+	}
+
+private:
+	static bool compare_heap_entries(const heap_entry &a, const heap_entry &b)
+	{
+		if (a.first != b.first) {
+			return a.first < b.first;
+		}
+
+		return a.second->get_index() > b.second->get_index();
+	}
+
+	void rebuild_heap()
+	{
+		this->heap.clear();
+		for (const auto &kv_pair : this->values) {
+			this->heap.emplace_back(kv_pair.second, kv_pair.first);
+		}
+		std::make_heap(this->heap.begin(), this->heap.end(), plurality_map::compare_heap_entries);
+	}
+
+private:
+	std::map<T *, int> values;
+	mutable std::vector<heap_entry> heap;
+};
+
+}
@@ -18,4 +18,40 @@ QPolygonF from_radius(const double radius, const int angle_per_point, const QPoi
 	return circle_polygon;
 }
 
+/**
+**	@brief	Clip a polygon to a half-plane
+**
+**	@param	polygon	The polygon, which may be closed or not
+**	@param	point	A point on the line bounding the half-plane
+**	@param	normal	The normal of the line, pointing away from the half-plane
+**
+**	@return	The part of the polygon within the half-plane, as an open polygon
+*/
+QPolygonF clip_to_half_plane(const QPolygonF &polygon, const QPointF &point, const QPointF &normal)
+{
+	QPolygonF clipped_polygon;
+
+	const auto get_signed_distance = [&point, &normal](const QPointF &pos) {
+		return QPointF::dotProduct(pos - point, normal);
+	};
+
+	for (int i = 0; i < polygon.size(); ++i) {
+		const QPointF &pos = polygon[i];
+		const QPointF &next_pos = polygon[(i + 1) % polygon.size()];
+		const double distance = get_signed_distance(pos);
+		const double next_distance = get_signed_distance(next_pos);
+
+		if (distance <= 0) {
+			clipped_polygon.append(pos);
+		}
+
+		//add the point where the edge crosses the line
+		if ((distance < 0 && next_distance > 0) || (distance > 0 && next_distance < 0)) {
+			clipped_polygon.append(pos + (next_pos - pos) * (distance / (distance - next_distance)));
+		}
+	}
+
+	return clipped_polygon;
+}
+
 }
@@ -19,5 +19,6 @@ inline double get_area(const QPolygonF &polygon)
 }
 
 extern QPolygonF from_radius(const double radius, const int angle_per_point, const QPointF &offset = QPointF(0, 0));
+extern QPolygonF clip_to_half_plane(const QPolygonF &polygon, const QPointF &point, const QPointF &normal);
 
 }
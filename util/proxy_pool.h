@@ -0,0 +1,59 @@
+#pragma once
+
+#include "util/qunique_ptr.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace metternich {
+
+/**
+**	@brief	A pool of the proxies through which the interface views entities of a type
+**
+**	The interface only shows a handful of entities at a time, so rather than viewing the entities themselves, it is given proxies bound to them on demand. Proxies which are no longer shown are returned to the pool, and bound to other entities when they are needed again, so that proxies aren't created and destroyed whenever the interface changes what it shows. Proxies are only used in the main thread, and so the pool isn't synchronized.
+*/
+template <typename T>
+class proxy_pool final
+{
+public:
+	static proxy_pool &get()
+	{
+		//the pool is never destroyed, as its proxies are deleted later by the event loop
+		static proxy_pool *pool = new proxy_pool;
+		return *pool;
+	}
+
+	T *acquire()
+	{
+		if (this->free_proxies.empty()) {
+			this->proxies.push_back(make_qunique<T>());
+			return this->proxies.back().get();
+		}
+
+		T *proxy = this->free_proxies.back();
+		this->free_proxies.pop_back();
+		return proxy;
+	}
+
+	void release(T *proxy)
+	{
+		proxy->reset();
+		this->free_proxies.push_back(proxy);
+	}
+
+	size_t get_proxy_count() const
+	{
+		return this->proxies.size();
+	}
+
+private:
+	proxy_pool()
+	{
+	}
+
+private:
+	std::vector<qunique_ptr<T>> proxies; //all proxies created by the pool, which are kept for reuse
+	std::vector<T *> free_proxies; //the proxies not bound to any entity
+};
+
+}
@@ -6,17 +6,76 @@
 
 #include <boost/math/constants/constants.hpp>
 
+#include <sstream>
+
 namespace metternich {
 
-double random::generate_radian_angle()
+double random::generate_radian_angle(const random_stream stream)
 {
-	return random::generate_in_range(0., 1.) * 2. * boost::math::constants::pi<double>();
+	return random::generate_in_range(0., 1., stream) * 2. * boost::math::constants::pi<double>();
 }
 
-QPointF random::generate_circle_position()
+QPointF random::generate_circle_position(const random_stream stream)
 {
-	const double angle = random::generate_radian_angle();
+	const double angle = random::generate_radian_angle(stream);
 	return point::get_radian_angle_direction(angle);
 }
 
+/**
+**	@brief	Seed the random streams, so that the same sequences of numbers are generated for the same seed
+**
+**	@param	seed	The seed
+*/
+void random::seed(const uint64_t seed)
+{
+	random::seed_value = seed;
+	random::engines = random::create_engines(seed);
+}
+
+/**
+**	@brief	Get the state of the random engines and the seed of keyed generators, e.g. for saving it
+**
+**	@return	The state, serialized as a string
+*/
+std::string random::get_state()
+{
+	std::ostringstream stream;
+	stream << random::seed_value << '\n';
+	for (const std::mt19937 &engine : random::engines) {
+		stream << engine << '\n';
+	}
+	return stream.str();
+}
+
+/**
+**	@brief	Set the state of the random engines, so that they continue generating the same sequences from when the state was obtained
+**
+**	@param	state	The engines' state, serialized as a string
+*/
+void random::set_state(const std::string &state)
+{
+	std::istringstream stream(state);
+	stream >> random::seed_value;
+	for (std::mt19937 &engine : random::engines) {
+		stream >> engine;
+	}
+
+	if (stream.fail()) {
+		throw std::runtime_error("Invalid random engine state.");
+	}
+}
+
+std::array<std::mt19937, random::stream_count> random::create_engines(const uint64_t seed)
+{
+	std::array<std::mt19937, random::stream_count> engines;
+
+	//derive a different seed sequence for each stream from the same seed
+	for (size_t i = 0; i < engines.size(); ++i) {
+		std::seed_seq seed_sequence { static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32), static_cast<uint32_t>(i) };
+		engines[i].seed(seed_sequence);
+	}
+
+	return engines;
+}
+
 }
@@ -2,42 +2,194 @@
 
 #include <QPointF>
 
+#include <array>
+#include <cstdint>
 #include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace metternich {
 
+//the independent random number streams used by different subsystems, so that a change in how many numbers one subsystem draws doesn't affect the numbers drawn by the others
+enum class random_stream
+{
+	general,
+	identifier, //generated identifiers
+	map, //map elements, e.g. world orbits
+	character, //character generation and names
+	population, //population growth and mixing
+	script, //chance lists, decisions and effects
+	interface, //presentation choices, e.g. of images, which don't affect the simulation
+
+	count
+};
+
+/**
+**	@brief	A counter-based random number generator
+**
+**	Each number generated is a bijective hash of the generator's key and a counter, so that the generator holds no state other than the counter, and generators keyed by the same values produce the same sequences, regardless of what else has been drawn before, or in which thread. Integers are generated without relying on the standard library's distributions, whose algorithms are implementation-defined.
+*/
+class random_generator final
+{
+public:
+	//the SplitMix64 finalizer
+	static constexpr uint64_t mix(uint64_t value)
+	{
+		value ^= value >> 30;
+		value *= 0xBF58476D1CE4E5B9ULL;
+		value ^= value >> 27;
+		value *= 0x94D049BB133111EBULL;
+		value ^= value >> 31;
+		return value;
+	}
+
+	explicit random_generator(const uint64_t key) : key(key)
+	{
+	}
+
+	uint64_t generate_bits()
+	{
+		++this->counter;
+		return random_generator::mix(this->key + this->counter * 0x9E3779B97F4A7C15ULL);
+	}
+
+	template <typename T = int>
+	T generate(const T modulo)
+	{
+		if constexpr (std::is_integral_v<T>) {
+			return this->generate_in_range<T>(static_cast<T>(0), modulo - static_cast<T>(1));
+		} else {
+			return this->generate_in_range<T>(static_cast<T>(0), modulo);
+		}
+	}
+
+	//generate a number in a range, with the maximum value being included for integers, but excluded for floating point numbers
+	template <typename T = int>
+	T generate_in_range(const T min_value, const T max_value)
+	{
+		if constexpr (std::is_integral_v<T>) {
+			const uint64_t range = static_cast<uint64_t>(max_value) - static_cast<uint64_t>(min_value) + 1;
+			return static_cast<T>(static_cast<uint64_t>(min_value) + this->generate_bounded(range));
+		} else {
+			const T fraction = static_cast<T>(this->generate_bits() >> 11) * static_cast<T>(0x1.0p-53);
+			return min_value + fraction * (max_value - min_value);
+		}
+	}
+
+	double generate_degree_angle()
+	{
+		return this->generate(360.);
+	}
+
+private:
+	//generate a number smaller than the bound, rejecting the values which would bias the result
+	uint64_t generate_bounded(const uint64_t bound)
+	{
+		if (bound == 0) {
+			return this->generate_bits(); //the whole range of 64-bit values
+		}
+
+		const uint64_t threshold = (0 - bound) % bound;
+		uint64_t value = this->generate_bits();
+		while (value < threshold) {
+			value = this->generate_bits();
+		}
+		return value % bound;
+	}
+
+private:
+	uint64_t key = 0;
+	uint64_t counter = 0;
+};
+
 class random
 {
 public:
+	static constexpr size_t stream_count = static_cast<size_t>(random_stream::count);
+
 	template <typename T = int>
-	static T generate(const T modulo)
+	static T generate(const T modulo, const random_stream stream = random_stream::general)
 	{
-		return random::generate_in_range<T>(static_cast<T>(0), modulo - static_cast<T>(1));
+		return random::generate_in_range<T>(static_cast<T>(0), modulo - static_cast<T>(1), stream);
 	}
 
 	template <typename T = int>
-	static T generate_in_range(const T min_value, const T max_value)
+	static T generate_in_range(const T min_value, const T max_value, const random_stream stream = random_stream::general)
 	{
 		if constexpr (std::is_integral_v<T>) {
 			std::uniform_int_distribution<T> distribution(min_value, max_value);
-			return distribution(random::engine);
+			return distribution(random::get_engine(stream));
 		} else {
 			std::uniform_real_distribution<T> distribution(min_value, max_value);
-			return distribution(random::engine);
+			return distribution(random::get_engine(stream));
 		}
 	}
 
-	static double generate_degree_angle()
+	static double generate_degree_angle(const random_stream stream = random_stream::general)
+	{
+		return random::generate(360., stream);
+	}
+
+	static double generate_radian_angle(const random_stream stream = random_stream::general);
+	static QPointF generate_circle_position(const random_stream stream = random_stream::general);
+
+	/**
+	**	@brief	Get a counter-based generator keyed by the given values, e.g. a purpose, an entity index and the current tick
+	**
+	**	The generator's numbers depend only on the seed, the stream and the keys, and not on any shared state, so generators can be used in parallel without locks, and still produce reproducible results.
+	**
+	**	@param	stream	The stream the generator belongs to
+	**	@param	keys	The keys, which can be integers, enumerations or strings
+	**
+	**	@return	The generator
+	*/
+	template <typename... key_types>
+	static random_generator get_generator(const random_stream stream, const key_types &... keys)
+	{
+		uint64_t key = random_generator::mix(random::seed_value ^ random_generator::mix(static_cast<uint64_t>(stream)));
+		((key = random_generator::mix(key ^ random_generator::mix(random::get_key_value(keys) + 0x9E3779B97F4A7C15ULL))), ...);
+		return random_generator(key);
+	}
+
+	static void seed(const uint64_t seed);
+	static std::string get_state();
+	static void set_state(const std::string &state);
+
+private:
+	static uint64_t generate_seed()
 	{
-		return random::generate(360.);
+		std::random_device random_device;
+		return (static_cast<uint64_t>(random_device()) << 32) | random_device();
 	}
 
-	static double generate_radian_angle();
-	static QPointF generate_circle_position();
+	static std::array<std::mt19937, stream_count> create_engines(const uint64_t seed);
+
+	template <typename T>
+	static constexpr uint64_t get_key_value(const T &key)
+	{
+		if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+			//the FNV-1a hash
+			uint64_t value = 0xCBF29CE484222325ULL;
+			for (const char c : std::string_view(key)) {
+				value ^= static_cast<unsigned char>(c);
+				value *= 0x100000001B3ULL;
+			}
+			return value;
+		} else {
+			static_assert(std::is_integral_v<T> || std::is_enum_v<T>);
+			return static_cast<uint64_t>(key);
+		}
+	}
+
+	static std::mt19937 &get_engine(const random_stream stream)
+	{
+		return random::engines[static_cast<size_t>(stream)];
+	}
 
 private:
-	static inline std::random_device random_device = std::random_device();
-	static inline std::mt19937 engine = std::mt19937(random::random_device());
+	static inline uint64_t seed_value = random::generate_seed();
+	static inline std::array<std::mt19937, stream_count> engines = random::create_engines(random::seed_value);
 };
 
 }
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace metternich {
+
+template <typename signature, size_t buffer_size = 48>
+class small_function;
+
+/**
+**	@brief	A move-only callable wrapper, which stores small callables inline instead of allocating them on the heap
+*/
+template <typename R, typename... ARGS, size_t buffer_size>
+class small_function<R(ARGS...), buffer_size> final
+{
+private:
+	struct operations
+	{
+		R (*invoke)(void *storage, ARGS&&... args);
+		void (*move)(void *source_storage, void *target_storage); //move-constructs into the target storage and destroys the source
+		void (*destroy)(void *storage);
+	};
+
+	template <typename function_type>
+	static constexpr bool is_stored_inline = sizeof(function_type) <= buffer_size && alignof(function_type) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<function_type>;
+
+	template <typename function_type>
+	static constexpr operations inline_operations = {
+		[](void *storage, ARGS&&... args) -> R {
+			return (*static_cast<function_type *>(storage))(std::forward<ARGS>(args)...);
+		},
+		[](void *source_storage, void *target_storage) {
+			function_type *source = static_cast<function_type *>(source_storage);
+			::new (target_storage) function_type(std::move(*source));
+			source->~function_type();
+		},
+		[](void *storage) {
+			static_cast<function_type *>(storage)->~function_type();
+		}
+	};
+
+	//callables which don't fit in the buffer are allocated on the heap, with only their pointer being stored inline
+	template <typename function_type>
+	static constexpr operations heap_operations = {
+		[](void *storage, ARGS&&... args) -> R {
+			return (**static_cast<function_type **>(storage))(std::forward<ARGS>(args)...);
+		},
+		[](void *source_storage, void *target_storage) {
+			*static_cast<function_type **>(target_storage) = *static_cast<function_type **>(source_storage);
+		},
+		[](void *storage) {
+			delete *static_cast<function_type **>(storage);
+		}
+	};
+
+public:
+	small_function()
+	{
+	}
+
+	small_function(std::nullptr_t)
+	{
+	}
+
+	template <typename function_type, typename = std::enable_if_t<!std::is_same_v<std::decay_t<function_type>, small_function> && std::is_invocable_r_v<R, std::decay_t<function_type> &, ARGS...>>>
+	small_function(function_type &&function)
+	{
+		using stored_type = std::decay_t<function_type>;
+
+		if constexpr (is_stored_inline<stored_type>) {
+			::new (static_cast<void *>(&this->storage)) stored_type(std::forward<function_type>(function));
+			this->ops = &small_function::inline_operations<stored_type>;
+		} else {
+			*reinterpret_cast<stored_type **>(&this->storage) = new stored_type(std::forward<function_type>(function));
+			this->ops = &small_function::heap_operations<stored_type>;
+		}
+	}
+
+	small_function(small_function &&other) noexcept
+	{
+		if (other.ops != nullptr) {
+			other.ops->move(&other.storage, &this->storage);
+			this->ops = other.ops;
+			other.ops = nullptr;
+		}
+	}
+
+	small_function(const small_function &other) = delete;
+
+	~small_function()
+	{
+		this->reset();
+	}
+
+	small_function &operator =(small_function &&other) noexcept
+	{
+		if (&other != this) {
+			this->reset();
+
+			if (other.ops != nullptr) {
+				other.ops->move(&other.storage, &this->storage);
+				this->ops = other.ops;
+				other.ops = nullptr;
+			}
+		}
+
+		return *this;
+	}
+
+	small_function &operator =(const small_function &other) = delete;
+
+	small_function &operator =(std::nullptr_t)
+	{
+		this->reset();
+		return *this;
+	}
+
+	explicit operator bool() const
+	{
+		return this->ops != nullptr;
+	}
+
+	R operator()(ARGS... args)
+	{
+		if (this->ops == nullptr) {
+			throw std::bad_function_call();
+		}
+
+		return this->ops->invoke(&this->storage, std::forward<ARGS>(args)...);
+	}
+
+	void reset()
+	{
+		if (this->ops != nullptr) {
+			this->ops->destroy(&this->storage);
+			this->ops = nullptr;
+		}
+	}
+
+private:
+	std::aligned_storage_t<buffer_size, alignof(std::max_align_t)> storage;
+	const operations *ops = nullptr;
+};
+
+}
@@ -0,0 +1,40 @@
+#include "util/string_interner.h"
+
+#include "util/memory_usage.h"
+
+#include <mutex>
+
+namespace metternich {
+
+std::string_view string_interner::intern(const std::string_view &str)
+{
+	{
+		std::shared_lock<std::shared_mutex> lock(string_interner::mutex);
+
+		const auto find_iterator = string_interner::strings.find(str);
+		if (find_iterator != string_interner::strings.end()) {
+			return *find_iterator;
+		}
+	}
+
+	std::unique_lock<std::shared_mutex> lock(string_interner::mutex);
+	//if another thread interned the same string in the meantime, the existing copy is returned
+	return *string_interner::strings.emplace(str).first;
+}
+
+void string_interner::add_memory_usage(memory_usage &usage)
+{
+	std::shared_lock<std::shared_mutex> lock(string_interner::mutex);
+
+	//each string is stored in its own node, together with its hash
+	static constexpr size_t node_overhead = sizeof(void *) + sizeof(size_t);
+	usage.add_allocation(string_interner::strings.bucket_count() * sizeof(void *));
+
+	for (const std::string &str : string_interner::strings) {
+		usage.increment_instance_count();
+		usage.add_allocation(sizeof(std::string) + node_overhead);
+		usage.add_string(str);
+	}
+}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace metternich {
+
+class memory_usage;
+
+/**
+**	@brief	The global string interner, which stores a single copy of each interned string
+**
+**	Interned strings are never released, so the views returned for them remain valid for the lifetime of the program, and can be used as keys in registries without those having to own their keys.
+*/
+class string_interner final
+{
+private:
+	struct string_hash final
+	{
+		using is_transparent = void;
+
+		size_t operator()(const std::string_view &str) const
+		{
+			return std::hash<std::string_view>()(str);
+		}
+	};
+
+public:
+	static std::string_view intern(const std::string_view &str);
+	static void add_memory_usage(memory_usage &usage);
+
+private:
+	static inline std::shared_mutex mutex; //strings can be interned from multiple threads, e.g. when parsing in parallel
+	static inline std::unordered_set<std::string, string_hash, std::equal_to<>> strings; //the nodes of the set are stable, so views into its strings remain valid on rehashing
+};
+
+}
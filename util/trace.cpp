@@ -0,0 +1,159 @@
+#include "util/trace.h"
+
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace metternich {
+
+struct trace_span_buffer
+{
+	explicit trace_span_buffer(const size_t thread_index) : thread_index(thread_index)
+	{
+	}
+
+	size_t thread_index = 0;
+	std::array<trace::span, trace::span_buffer_capacity> spans;
+	std::atomic<uint64_t> write_count = 0; //only written to by the owning thread
+};
+
+struct trace_counter_sample
+{
+	int64_t time_ns = 0;
+	std::array<uint64_t, static_cast<size_t>(trace_counter::count)> values {};
+};
+
+static std::mutex span_buffers_mutex; //only locked when a thread records its first span, or when exporting or clearing
+static std::vector<std::unique_ptr<trace_span_buffer>> span_buffers; //buffers are never freed, so that they outlive the threads which wrote them
+static thread_local trace_span_buffer *thread_span_buffer = nullptr;
+static std::vector<trace_counter_sample> counter_samples(trace::counter_sample_capacity);
+static uint64_t counter_sample_count = 0; //counter samples are taken by the game loop thread only
+
+void trace::record_span(const char *name, const clock::time_point start, const clock::time_point end)
+{
+	if (thread_span_buffer == nullptr) {
+		std::unique_lock<std::mutex> lock(span_buffers_mutex);
+		span_buffers.push_back(std::make_unique<trace_span_buffer>(span_buffers.size() + 1));
+		thread_span_buffer = span_buffers.back().get();
+	}
+
+	const uint64_t write_count = thread_span_buffer->write_count.load(std::memory_order_relaxed);
+	span &span = thread_span_buffer->spans[write_count % trace::span_buffer_capacity];
+	span.name = name;
+	span.start_ns = trace::to_trace_ns(start);
+	span.duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	thread_span_buffer->write_count.store(write_count + 1, std::memory_order_release);
+}
+
+const char *trace::get_counter_name(const trace_counter counter)
+{
+	switch (counter) {
+		case trace_counter::events_fired:
+			return "events_fired";
+		case trace_counter::conditions_evaluated:
+			return "conditions_evaluated";
+		case trace_counter::pathfinder_searches:
+			return "pathfinder_searches";
+		case trace_counter::population_units_processed:
+			return "population_units_processed";
+		case trace_counter::constructions_completed:
+			return "constructions_completed";
+		case trace_counter::count:
+			break;
+	}
+
+	throw std::runtime_error("Invalid trace counter: \"" + std::to_string(static_cast<int>(counter)) + "\".");
+}
+
+/**
+**	@brief	Take a sample of the current counter values, so that their evolution over time is included in exported traces
+*/
+void trace::sample_counters()
+{
+	if (!trace::is_enabled()) {
+		return;
+	}
+
+	trace_counter_sample &sample = counter_samples[counter_sample_count % trace::counter_sample_capacity];
+	sample.time_ns = trace::to_trace_ns(clock::now());
+	for (size_t i = 0; i < sample.values.size(); ++i) {
+		sample.values[i] = trace::counters[i].load(std::memory_order_relaxed);
+	}
+
+	++counter_sample_count;
+}
+
+/**
+**	@brief	Export the recorded spans and counter samples in the Chrome trace event JSON format, which can also be opened in Perfetto
+**
+**	@param	filepath	The path of the file to be written
+**
+**	This should be done while the traced threads are idle (e.g. at the end of a headless run), as spans being recorded concurrently may be exported partially written.
+*/
+void trace::export_chrome_json(const std::filesystem::path &filepath)
+{
+	std::ofstream ofstream(filepath);
+
+	if (!ofstream) {
+		throw std::runtime_error("Failed to open file for writing the trace: \"" + filepath.string() + "\".");
+	}
+
+	ofstream << std::fixed << std::setprecision(3);
+	ofstream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+	bool first_event = true;
+	const auto begin_event = [&]() -> std::ofstream & {
+		if (!first_event) {
+			ofstream << ",\n";
+		}
+		first_event = false;
+		return ofstream;
+	};
+
+	{
+		std::unique_lock<std::mutex> lock(span_buffers_mutex);
+
+		for (const std::unique_ptr<trace_span_buffer> &buffer : span_buffers) {
+			begin_event() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread_index << ",\"args\":{\"name\":\"Thread " << buffer->thread_index << "\"}}";
+
+			const uint64_t write_count = buffer->write_count.load(std::memory_order_acquire);
+			const uint64_t first_index = write_count > trace::span_buffer_capacity ? write_count - trace::span_buffer_capacity : 0;
+
+			for (uint64_t i = first_index; i < write_count; ++i) {
+				const span &span = buffer->spans[i % trace::span_buffer_capacity];
+				begin_event() << "{\"name\":\"" << span.name << "\",\"cat\":\"metternich\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_index << ",\"ts\":" << (span.start_ns / 1000.) << ",\"dur\":" << (span.duration_ns / 1000.) << "}";
+			}
+		}
+	}
+
+	const uint64_t first_sample_index = counter_sample_count > trace::counter_sample_capacity ? counter_sample_count - trace::counter_sample_capacity : 0;
+	for (uint64_t i = first_sample_index; i < counter_sample_count; ++i) {
+		const trace_counter_sample &sample = counter_samples[i % trace::counter_sample_capacity];
+
+		for (size_t j = 0; j < sample.values.size(); ++j) {
+			begin_event() << "{\"name\":\"" << trace::get_counter_name(static_cast<trace_counter>(j)) << "\",\"ph\":\"C\",\"pid\":1,\"ts\":" << (sample.time_ns / 1000.) << ",\"args\":{\"value\":" << sample.values[j] << "}}";
+		}
+	}
+
+	ofstream << "\n]}\n";
+}
+
+void trace::clear()
+{
+	std::unique_lock<std::mutex> lock(span_buffers_mutex);
+
+	for (const std::unique_ptr<trace_span_buffer> &buffer : span_buffers) {
+		buffer->write_count = 0;
+	}
+
+	for (std::atomic<uint64_t> &counter : trace::counters) {
+		counter = 0;
+	}
+
+	counter_sample_count = 0;
+}
+
+}
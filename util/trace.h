@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+namespace metternich {
+
+enum class trace_counter
+{
+	events_fired,
+	conditions_evaluated,
+	pathfinder_searches,
+	population_units_processed,
+	constructions_completed,
+
+	count
+};
+
+/**
+**	@brief	Low-overhead tracing of spans and counters, to find where time is spent in the simulation
+**
+**	Spans are written to per-thread ring buffers, so that recording them requires no locking. The instrumentation macros at the end of this file are compiled out unless METTERNICH_TRACING is defined.
+*/
+class trace final
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	static constexpr size_t span_buffer_capacity = 1 << 16; //the amount of spans kept per thread; older spans are overwritten
+	static constexpr size_t counter_sample_capacity = 1 << 12;
+
+	struct span
+	{
+		const char *name = nullptr; //must point to a string with static storage duration, e.g. a string literal
+		int64_t start_ns = 0;
+		int64_t duration_ns = 0;
+	};
+
+	static bool is_enabled()
+	{
+		return trace::enabled.load(std::memory_order_relaxed);
+	}
+
+	static void set_enabled(const bool enabled)
+	{
+		trace::enabled = enabled;
+	}
+
+	static void record_span(const char *name, const clock::time_point start, const clock::time_point end);
+
+	static void increment_counter(const trace_counter counter, const uint64_t change = 1)
+	{
+		trace::counters[static_cast<size_t>(counter)].fetch_add(change, std::memory_order_relaxed);
+	}
+
+	static uint64_t get_counter(const trace_counter counter)
+	{
+		return trace::counters[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+	}
+
+	static const char *get_counter_name(const trace_counter counter);
+	static void sample_counters();
+	static void export_chrome_json(const std::filesystem::path &filepath);
+	static void clear();
+
+private:
+	static int64_t to_trace_ns(const clock::time_point time_point)
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(time_point - trace::start_time).count();
+	}
+
+private:
+	static inline std::atomic<bool> enabled = false;
+	static inline const clock::time_point start_time = clock::now();
+	static inline std::array<std::atomic<uint64_t>, static_cast<size_t>(trace_counter::count)> counters {};
+};
+
+/**
+**	@brief	Records a trace span for the lifetime of the object
+*/
+class trace_scope final
+{
+public:
+	explicit trace_scope(const char *name) : name(name)
+	{
+		if (trace::is_enabled()) {
+			this->start = trace::clock::now();
+		}
+	}
+
+	trace_scope(const trace_scope &other) = delete;
+
+	~trace_scope()
+	{
+		if (this->start != trace::clock::time_point()) {
+			trace::record_span(this->name, this->start, trace::clock::now());
+		}
+	}
+
+	trace_scope &operator =(const trace_scope &other) = delete;
+
+private:
+	const char *name = nullptr;
+	trace::clock::time_point start;
+};
+
+}
+
+#ifdef METTERNICH_TRACING
+#define METTERNICH_TRACE_CONCAT_IMPL(a, b) a##b
+#define METTERNICH_TRACE_CONCAT(a, b) METTERNICH_TRACE_CONCAT_IMPL(a, b)
+#define TRACE_SCOPE(name) const metternich::trace_scope METTERNICH_TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#define TRACE_COUNTER(counter, change) metternich::trace::increment_counter(metternich::trace_counter::counter, (change))
+#define TRACE_SAMPLE_COUNTERS() metternich::trace::sample_counters()
+#else
+#define TRACE_SCOPE(name)
+#define TRACE_COUNTER(counter, change)
+#define TRACE_SAMPLE_COUNTERS()
+#endif
@@ -4,21 +4,123 @@
 #include "database/gsml_data.h"
 #include "database/gsml_operator.h"
 #include "database/gsml_parser.h"
-#include "util/string_util.h"
+#include "util/cached_translation.h"
 
 #include <filesystem>
 
 namespace metternich {
 
+translator::suffix_combinations::suffix_combinations(const std::vector<std::vector<std::string>> &suffix_list_with_fallbacks)
+{
+	//expand the combinations as the tags chosen for each of them, in the same order as string::get_suffix_combinations, so that the combinations can be written directly to the buffer
+	std::vector<std::vector<const std::string *>> tag_combinations;
+
+	for (const std::vector<std::string> &suffix_with_fallbacks : suffix_list_with_fallbacks) {
+		std::vector<std::vector<const std::string *>> new_tag_combinations;
+
+		for (const std::vector<const std::string *> &tag_combination : tag_combinations) {
+			//string::get_suffix_combinations appends the further fallbacks to the combination with the first one, rather than to the original combination
+			for (size_t i = 0; i < suffix_with_fallbacks.size(); ++i) {
+				new_tag_combinations.push_back(tag_combination);
+				if (i > 0) {
+					new_tag_combinations.back().push_back(&suffix_with_fallbacks.front());
+				}
+				new_tag_combinations.back().push_back(&suffix_with_fallbacks[i]);
+			}
+
+			new_tag_combinations.push_back(tag_combination);
+		}
+
+		for (const std::string &suffix_tag : suffix_with_fallbacks) {
+			new_tag_combinations.push_back({ &suffix_tag });
+		}
+
+		tag_combinations = std::move(new_tag_combinations);
+	}
+
+	tag_combinations.emplace_back(); //no suffix
+
+	size_t buffer_size = 0;
+	for (const std::vector<const std::string *> &tag_combination : tag_combinations) {
+		for (const std::string *suffix_tag : tag_combination) {
+			buffer_size += 1 + suffix_tag->size();
+		}
+	}
+
+	//reserve the whole buffer beforehand, so that the views into it remain valid
+	this->buffer.reserve(buffer_size);
+	this->combinations.reserve(tag_combinations.size());
+
+	for (const std::vector<const std::string *> &tag_combination : tag_combinations) {
+		const size_t offset = this->buffer.size();
+
+		for (const std::string *suffix_tag : tag_combination) {
+			this->buffer += '_';
+			this->buffer += *suffix_tag;
+		}
+
+		this->combinations.emplace_back(this->buffer.data() + offset, this->buffer.size() - offset);
+	}
+}
+
+void translator::build_suffix_key(const std::vector<std::vector<std::string>> &suffix_list_with_fallbacks, std::string &key)
+{
+	//use control characters as separators, since they don't occur in tags
+	key.clear();
+
+	for (const std::vector<std::string> &suffix_with_fallbacks : suffix_list_with_fallbacks) {
+		for (const std::string &suffix : suffix_with_fallbacks) {
+			key += suffix;
+			key += '\x1f';
+		}
+
+		key += '\x1e';
+	}
+}
+
 std::string translator::translate(const std::vector<std::string> &base_tags, const std::vector<std::vector<std::string>> &suffix_list_with_fallbacks, const std::string &final_suffix) const
 {
-	std::vector<std::string> suffix_combinations = string::get_suffix_combinations(suffix_list_with_fallbacks);
+	//the key is built in a thread-local buffer, so that no allocations are needed to look up an interned suffix tuple
+	thread_local std::string suffix_key;
+
+	translator::build_suffix_key(suffix_list_with_fallbacks, suffix_key);
+
+	const suffix_combinations &combinations = this->get_suffix_combinations(suffix_list_with_fallbacks, suffix_key);
+	return this->resolve_translation(base_tags, combinations, final_suffix);
+}
+
+const translator::suffix_combinations &translator::get_suffix_combinations(const std::vector<std::vector<std::string>> &suffix_list_with_fallbacks, const std::string &suffix_key) const
+{
+	{
+		std::shared_lock<std::shared_mutex> lock(this->cache_mutex);
+
+		const auto find_iterator = this->suffix_combinations_cache.find(suffix_key);
+		if (find_iterator != this->suffix_combinations_cache.end()) {
+			return *find_iterator->second;
+		}
+	}
 
-	for (const std::string &suffix : suffix_combinations) {
+	auto combinations = std::make_unique<suffix_combinations>(suffix_list_with_fallbacks);
+
+	std::unique_lock<std::shared_mutex> lock(this->cache_mutex);
+	//if another thread added the same suffix combinations in the meantime, the existing ones are kept
+	const auto result = this->suffix_combinations_cache.try_emplace(suffix_key, std::move(combinations));
+	return *result.first->second;
+}
+
+std::string translator::resolve_translation(const std::vector<std::string> &base_tags, const suffix_combinations &combinations, const std::string &final_suffix) const
+{
+	thread_local std::string source_text;
+
+	for (const std::string_view &suffix : combinations.get_combinations()) {
 		for (const std::string &base_tag : base_tags) {
-			const auto &suffix_find_iterator = this->translations.find(base_tag + suffix + final_suffix);
-			if (suffix_find_iterator != this->translations.end())  {
-				return suffix_find_iterator->second;
+			source_text.assign(base_tag);
+			source_text.append(suffix);
+			source_text.append(final_suffix);
+
+			const auto find_iterator = this->translations.find(source_text);
+			if (find_iterator != this->translations.end())  {
+				return find_iterator->second;
 			}
 		}
 	}
@@ -38,6 +140,7 @@ QString translator::translate(const char *context, const char *source_text, cons
 void translator::load()
 {
 	this->translations.clear();
+	this->clear_caches();
 
 	for (const std::filesystem::path &path : database::get()->get_localization_paths()) {
 		std::filesystem::path localization_path(path / this->get_locale());
@@ -72,4 +175,14 @@ void translator::load_file(const std::filesystem::path &filepath)
 	});
 }
 
+void translator::clear_caches()
+{
+	{
+		std::unique_lock<std::shared_mutex> lock(this->cache_mutex);
+		this->suffix_combinations_cache.clear();
+	}
+
+	cached_translation::invalidate_all();
+}
+
 }
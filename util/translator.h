@@ -7,15 +7,39 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace metternich {
 
+/**
+**	@brief	The translator, which resolves localized names from tags and suffixes
+**
+**	Suffix tuples are interned together with their combinations, so that the combinations are expanded only once per tuple, and looked up without allocating. The translations themselves are memoized by the entities requesting them (see cached_translation), which invalidate them when their culture, religion, government or owner changes.
+*/
 class translator final : public QTranslator, public singleton<translator>
 {
 	Q_OBJECT
 
+	//the suffix combinations for a suffix tuple, from more specific to less specific, stored as views into a single buffer
+	class suffix_combinations final
+	{
+	public:
+		explicit suffix_combinations(const std::vector<std::vector<std::string>> &suffix_list_with_fallbacks);
+
+		const std::vector<std::string_view> &get_combinations() const
+		{
+			return this->combinations;
+		}
+
+	private:
+		std::string buffer;
+		std::vector<std::string_view> combinations;
+	};
+
 public:
 	const std::string &get_locale() const
 	{
@@ -39,14 +63,22 @@ public:
 	virtual QString translate(const char *context, const char *source_text, const char *disambiguation = nullptr, int n = -1) const override;
 
 private:
+	static void build_suffix_key(const std::vector<std::vector<std::string>> &suffix_list_with_fallbacks, std::string &key);
+
 	void add_translation(const std::string &source_text, const std::string &translation)
 	{
 		this->translations[source_text] = translation;
 	}
 
+	const suffix_combinations &get_suffix_combinations(const std::vector<std::vector<std::string>> &suffix_list_with_fallbacks, const std::string &suffix_key) const;
+	std::string resolve_translation(const std::vector<std::string> &base_tags, const suffix_combinations &combinations, const std::string &final_suffix) const;
+	void clear_caches();
+
 private:
 	std::map<std::string, std::string> translations;
 	std::string locale;
+	mutable std::shared_mutex cache_mutex; //translations can be requested by both the game loop and the interface threads
+	mutable std::unordered_map<std::string, std::unique_ptr<suffix_combinations>> suffix_combinations_cache; //the interned suffix tuples, with their suffix combinations
 };
 
 }
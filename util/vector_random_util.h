@@ -7,9 +7,15 @@
 namespace metternich::vector {
 
 template <typename T>
-inline const typename T::value_type &get_random(const T &vector)
+inline const typename T::value_type &get_random(const T &vector, const random_stream stream = random_stream::general)
 {
-	return vector[random::generate(vector.size())];
+	return vector[random::generate(vector.size(), stream)];
+}
+
+template <typename T>
+inline const typename T::value_type &get_random(const T &vector, random_generator &generator)
+{
+	return vector[generator.generate(vector.size())];
 }
 
 }